@@ -1,21 +1,41 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
-from esphome.const import CONF_ID, CONF_NAME
+from esphome.components import i2c, time
+import esphome.final_validate as fv
+from esphome.const import CONF_ADDRESS, CONF_I2C_ID, CONF_ID, CONF_NAME, CONF_TIME_ID
 
 CODEOWNERS = ["@TheFatBastid"]
-MULTI_CONF = False
+DEPENDENCIES = ["i2c"]
+MULTI_CONF = True
 
 CONF_IRQ_PIN = "irq_pin"
-CONF_SDA_PIN = "sda_pin"
-CONF_SCL_PIN = "scl_pin"
 CONF_CARTS = "carts"
 CONF_CART_ID = "cart_id"
+CONF_DEDICATED_TASK = "dedicated_task"
+CONF_HEARTBEAT = "heartbeat"
+CONF_TASK_CORE = "task_core"
+CONF_ANTENNA_TUNING = "antenna_tuning"
+CONF_TUNING_DRIFT_THRESHOLD = "tuning_drift_threshold"
+CONF_RF_POWER_CONTROL = "rf_power_control"
+CONF_RF_POWER_MAX_RFO = "rf_power_max_rfo"
+CONF_RF_POWER_MIN_AMPLITUDE = "rf_power_min_amplitude"
+CONF_TRACE_BUFFER_SIZE = "trace_buffer_size"
+CONF_NFCV_DATA_RATE = "nfcv_data_rate"
+CONF_POLL_INTERVAL = "poll_interval"
+CONF_PRESENCE_INTERVAL = "presence_interval"
+CONF_USAGE_SAVE_INTERVAL = "usage_save_interval"
 
 st25r3918_ns = cg.esphome_ns.namespace("st25r3918")
 ST25R3918Component = st25r3918_ns.class_(
-    "ST25R3918Component", cg.PollingComponent
+    "ST25R3918Component", cg.PollingComponent, i2c.I2CDevice
 )
+NfcvRate = st25r3918_ns.enum("NfcvRate", is_class=True)
+NFCV_RATES = {
+    "standard": NfcvRate.STANDARD,
+    "fast": NfcvRate.FAST,
+    "auto": NfcvRate.AUTO,
+}
 
 CART_SCHEMA = cv.Schema(
     {
@@ -29,22 +49,155 @@ CONFIG_SCHEMA = (
         {
             cv.GenerateID(): cv.declare_id(ST25R3918Component),
             cv.Required(CONF_IRQ_PIN): pins.gpio_input_pin_schema,
-            cv.Optional(CONF_SDA_PIN, default=27): cv.int_,
-            cv.Optional(CONF_SCL_PIN, default=14): cv.int_,
             cv.Optional(CONF_CARTS, default=[]): cv.ensure_list(CART_SCHEMA),
+            # Usage is journaled per day in RTC memory (kept across resets) and
+            # only written to flash this often; the clock dates the journal
+            cv.Optional(
+                CONF_USAGE_SAVE_INTERVAL, default="6h"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
+            # Sensors publish on change; also republish everything this often
+            cv.Optional(
+                CONF_HEARTBEAT, default="5min"
+            ): cv.positive_time_period_milliseconds,
+            # Run the RFAL worker in its own FreeRTOS task instead of loop(); the
+            # reader then needs an i2c bus no other device uses
+            cv.Optional(CONF_DEDICATED_TASK, default=False): cv.boolean,
+            cv.Optional(CONF_TASK_CORE, default=0): cv.int_range(min=0, max=1),
+            # Tune the antenna caps once, store them and retune only on drift
+            cv.Optional(CONF_ANTENNA_TUNING, default=False): cv.boolean,
+            cv.Optional(CONF_TUNING_DRIFT_THRESHOLD, default=16): cv.int_range(
+                min=1, max=255
+            ),
+            # Lower the RF output power while cart reads stay clean: driver
+            # resistance up to max_rfo (0 full power, 15 weakest) as long as the
+            # field amplitude stays above min_amplitude; setpoint kept in NVS
+            cv.Optional(CONF_RF_POWER_CONTROL, default=False): cv.boolean,
+            cv.Optional(CONF_RF_POWER_MAX_RFO, default=8): cv.int_range(min=1, max=15),
+            cv.Optional(CONF_RF_POWER_MIN_AMPLITUDE, default=64): cv.int_range(
+                min=0, max=255
+            ),
+            # Record every chip transaction and the RFAL state timeline in a RAM
+            # ring (debug builds only); dump it with id(...).dump_trace(), replay
+            # it with tools/replay or open it in Perfetto (st25r3918_trace.py -c).
+            # A build flag: with several readers, set the same size on each
+            cv.Optional(CONF_TRACE_BUFFER_SIZE): cv.int_range(min=1024, max=65536),
+            # Response rate of the cart block reads: ST fast commands (53 kbps)
+            # when the IC supports them, dropping back on CRC/framing errors
+            cv.Optional(CONF_NFCV_DATA_RATE, default="auto"): cv.enum(
+                NFCV_RATES, lower=True
+            ),
+            # Field off wait between discovery cycles: short while no cart is
+            # known (insert-to-read latency), long once one is identified (power)
+            cv.Optional(CONF_POLL_INTERVAL, default="50ms"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(max=cv.TimePeriod(milliseconds=65535)),
+            ),
+            cv.Optional(CONF_PRESENCE_INTERVAL, default="1s"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(max=cv.TimePeriod(milliseconds=65535)),
+            ),
         }
     )
     .extend(cv.polling_component_schema("500ms"))
+    .extend(i2c.i2c_device_schema(0x50))
 )
 
 
+def _i2c_users(node, bus_id):
+    """Yield every component config in node that sits on the given i2c bus."""
+    if isinstance(node, dict):
+        if CONF_I2C_ID in node and str(node[CONF_I2C_ID]) == bus_id:
+            yield node
+        for value in node.values():
+            yield from _i2c_users(value, bus_id)
+    elif isinstance(node, list):
+        for item in node:
+            yield from _i2c_users(item, bus_id)
+
+
+def _final_validate(config):
+    full_config = fv.full_config.get()
+    # The worker task talks to the chip outside loop(), where the other devices
+    # on the bus are read: only allow it when the reader has the bus to itself
+    if config[CONF_DEDICATED_TASK]:
+        bus_id = str(config[CONF_I2C_ID])
+        others = [
+            user
+            for user in _i2c_users(full_config, bus_id)
+            if str(user.get(CONF_ID)) != str(config[CONF_ID])
+        ]
+        if others:
+            raise cv.Invalid(
+                f"{CONF_DEDICATED_TASK} needs the i2c bus to itself, but {len(others)} "
+                f"other device(s) use {bus_id}; give the reader its own i2c bus or "
+                f"set {CONF_DEDICATED_TASK}: false",
+                path=[CONF_DEDICATED_TASK],
+            )
+
+    # The trace ring size is one build flag for all readers
+    readers = full_config.get("st25r3918", [])
+    sizes = {reader.get(CONF_TRACE_BUFFER_SIZE) for reader in readers}
+    if len(sizes) > 1:
+        raise cv.Invalid(
+            f"{CONF_TRACE_BUFFER_SIZE} applies to all readers, set the same value "
+            f"on each of them",
+            path=[CONF_TRACE_BUFFER_SIZE],
+        )
+
+    # The ST25R3918 address is fixed in the chip: a second reader needs its own bus
+    devices = [(str(reader[CONF_I2C_ID]), reader[CONF_ADDRESS]) for reader in readers]
+    if devices.count((str(config[CONF_I2C_ID]), config[CONF_ADDRESS])) > 1:
+        raise cv.Invalid(
+            f"I2C bus {config[CONF_I2C_ID]} has more than one reader at address "
+            f"0x{config[CONF_ADDRESS]:02X}, give each reader its own i2c bus",
+            path=[CONF_I2C_ID],
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+    await i2c.register_i2c_device(var, config)
 
     irq_pin = await cg.gpio_pin_expression(config[CONF_IRQ_PIN])
     cg.add(var.set_irq_pin(irq_pin))
-    cg.add(var.set_i2c_pins(config[CONF_SDA_PIN], config[CONF_SCL_PIN]))
+    # Per reader NVS key of the antenna tuning
+    cg.add(var.set_preference_id(str(config[CONF_ID])))
+    cg.add(var.set_heartbeat_interval(config[CONF_HEARTBEAT]))
+    cg.add(var.set_usage_save_interval(config[CONF_USAGE_SAVE_INTERVAL]))
+    if CONF_TIME_ID in config:
+        clock = await cg.get_variable(config[CONF_TIME_ID])
+        cg.add(var.set_time(clock))
+    cg.add(var.set_dedicated_task(config[CONF_DEDICATED_TASK], config[CONF_TASK_CORE]))
+    cg.add(
+        var.set_antenna_tuning(
+            config[CONF_ANTENNA_TUNING], config[CONF_TUNING_DRIFT_THRESHOLD]
+        )
+    )
+
+    cg.add(
+        var.set_power_control(
+            config[CONF_RF_POWER_CONTROL],
+            config[CONF_RF_POWER_MAX_RFO],
+            config[CONF_RF_POWER_MIN_AMPLITUDE],
+        )
+    )
+
+    cg.add(var.set_nfcv_data_rate(config[CONF_NFCV_DATA_RATE]))
+    cg.add(
+        var.set_discovery_intervals(
+            config[CONF_POLL_INTERVAL], config[CONF_PRESENCE_INTERVAL]
+        )
+    )
+
+    if CONF_TRACE_BUFFER_SIZE in config:
+        cg.add_build_flag("-DST25R3918_TRACE")
+        cg.add_build_flag(f"-DST25R3918_TRACE_SIZE={config[CONF_TRACE_BUFFER_SIZE]}U")
 
     # Add configured cart names
     for cart in config[CONF_CARTS]:
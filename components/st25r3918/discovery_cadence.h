@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace st25r3918 {
+
+// Wait between two discovery (poll) cycles, field off. Short while no tag is
+// known, so an inserted cart is polled within tens of ms; long once a tag is
+// identified, where each cycle only checks it is still there. A cycle that
+// misses the tag goes back to the short wait. RFAL worker context only.
+class DiscoveryCadence {
+ public:
+  void set_periods(uint16_t poll_ms, uint16_t presence_ms) {
+    this->poll_ms_ = poll_ms;
+    this->presence_ms_ = presence_ms;
+  }
+  uint16_t poll_period() const { return this->poll_ms_; }
+  uint16_t presence_period() const { return this->presence_ms_; }
+
+  // A tag answered in the current cycle; identified once its read is complete
+  void activated(bool identified) { this->identified_ |= identified; }
+
+  // The cycle ended (RFAL_NFC_STATE_LISTEN_TECHDETECT): the wait before the next one
+  uint16_t cycle_done() {
+    this->present_ = this->identified_;
+    this->identified_ = false;
+    return this->present_ ? this->presence_ms_ : this->poll_ms_;
+  }
+
+  bool present() const { return this->present_; }
+
+ protected:
+  uint16_t poll_ms_{50};
+  uint16_t presence_ms_{1000};
+  bool identified_{false};  // Current cycle
+  bool present_{false};     // Last finished cycle
+};
+
+}  // namespace st25r3918
+}  // namespace esphome
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace st25r3918 {
+
+// On-time of the heater output, integrated between its switching edges with
+// micros() timestamps: as exact as the edges, whatever the update interval.
+// take_seconds() has to run at least once per micros() wrap (~71 min).
+class HeaterMeter {
+ public:
+  // The heater output switched
+  void set(bool on, uint32_t now_us) {
+    if (on == this->on_) {
+      return;
+    }
+    this->accrue_(now_us);
+    this->on_ = on;
+  }
+  bool is_on() const { return this->on_; }
+
+  // On-time since the last call in whole seconds, the fraction carries over
+  uint32_t take_seconds(uint32_t now_us) {
+    this->accrue_(now_us);
+    uint32_t seconds = static_cast<uint32_t>(this->on_us_ / 1000000U);
+    this->on_us_ -= static_cast<uint64_t>(seconds) * 1000000U;
+    return seconds;
+  }
+
+ protected:
+  void accrue_(uint32_t now_us) {
+    if (this->on_) {
+      this->on_us_ += now_us - this->since_us_;
+    }
+    this->since_us_ = now_us;
+  }
+
+  bool on_{false};
+  uint32_t since_us_{0};  // Last edge or accrual
+  uint64_t on_us_{0};     // Not yet taken
+};
+
+}  // namespace st25r3918
+}  // namespace esphome
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "st_errno.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace esphome {
+namespace st25r3918 {
+
+// Outcome class of one transceive, as far as link quality is concerned.
+enum class LinkResult : uint8_t {
+  OK,
+  CRC,      // Frame received, CRC wrong
+  FRAMING,  // Frame received but not decodable (framing, parity, incomplete byte, collision)
+  TIMEOUT,  // Nothing received within FWT
+  OTHER,
+};
+
+// Snapshot of the cumulative link counters.
+struct LinkCounters {
+  uint32_t total{0};
+  uint32_t crc{0};
+  uint32_t framing{0};
+  uint32_t timeout{0};
+  uint32_t other{0};
+  uint32_t rssi_sum{0};  // Sum of the RSSI (mV) of the successful transceives
+
+  uint32_t errors() const { return this->crc + this->framing + this->timeout + this->other; }
+};
+
+// Per-transceive link statistics and the retry policy derived from them.
+// record() and the policy getters belong to the RFAL worker context; counters()
+// may be called from any other context (the counters are atomics).
+class LinkQuality {
+ public:
+  static LinkResult classify(ReturnCode err) {
+    switch (err) {
+      case ERR_NONE:
+        return LinkResult::OK;
+      case ERR_CRC:
+        return LinkResult::CRC;
+      case ERR_TIMEOUT:
+        return LinkResult::TIMEOUT;
+      case ERR_FRAMING:
+      case ERR_PAR:
+      case ERR_RF_COLLISION:
+      case ERR_INCOMPLETE_BYTE:
+      case ERR_INCOMPLETE_BYTE_01:
+      case ERR_INCOMPLETE_BYTE_02:
+      case ERR_INCOMPLETE_BYTE_03:
+      case ERR_INCOMPLETE_BYTE_04:
+      case ERR_INCOMPLETE_BYTE_05:
+      case ERR_INCOMPLETE_BYTE_06:
+      case ERR_INCOMPLETE_BYTE_07:
+        return LinkResult::FRAMING;
+      default:
+        return LinkResult::OTHER;
+    }
+  }
+
+  void record(ReturnCode err, uint16_t rssi_mv) {
+    LinkResult res = classify(err);
+    this->total_.fetch_add(1, std::memory_order_relaxed);
+    switch (res) {
+      case LinkResult::OK:
+        this->rssi_sum_.fetch_add(rssi_mv, std::memory_order_relaxed);
+        break;
+      case LinkResult::CRC:
+        this->crc_.fetch_add(1, std::memory_order_relaxed);
+        break;
+      case LinkResult::FRAMING:
+        this->framing_.fetch_add(1, std::memory_order_relaxed);
+        break;
+      case LinkResult::TIMEOUT:
+        this->timeout_.fetch_add(1, std::memory_order_relaxed);
+        break;
+      default:
+        this->other_.fetch_add(1, std::memory_order_relaxed);
+        break;
+    }
+
+    // Exponential moving averages in 1/1024 units, weight 1/16 per transceive
+    ewma_(this->error_avg_, res != LinkResult::OK);
+    ewma_(this->timeout_avg_, res == LinkResult::TIMEOUT);
+    ewma_(this->garbled_avg_, res == LinkResult::CRC || res == LinkResult::FRAMING);
+  }
+
+  LinkCounters counters() const {
+    LinkCounters c;
+    c.total = this->total_.load(std::memory_order_relaxed);
+    c.crc = this->crc_.load(std::memory_order_relaxed);
+    c.framing = this->framing_.load(std::memory_order_relaxed);
+    c.timeout = this->timeout_.load(std::memory_order_relaxed);
+    c.other = this->other_.load(std::memory_order_relaxed);
+    c.rssi_sum = this->rssi_sum_.load(std::memory_order_relaxed);
+    return c;
+  }
+
+  // Extra attempts per failed block read: 1 on a clean link, up to 4 on a bad one.
+  uint8_t retries() const {
+    if (this->error_avg_ > ERROR_BAD) {
+      return 4;
+    }
+    if (this->error_avg_ > ERROR_MARGINAL) {
+      return 2;
+    }
+    return 1;
+  }
+
+  // Extra FWT (1/fc) when responses keep arriving late or not at all.
+  uint32_t fwt_margin() const {
+    if (this->timeout_avg_ > ERROR_BAD) {
+      return FWT_STEP_1FC * 2;
+    }
+    if (this->timeout_avg_ > ERROR_MARGINAL) {
+      return FWT_STEP_1FC;
+    }
+    return 0;
+  }
+
+  // Garbled single-slot inventory responses are taken as collisions anyway, so
+  // go straight to the 16 slots loop while they are frequent.
+  bool prefer_16_slots() const { return this->garbled_avg_ > ERROR_BAD; }
+
+  // The fast NFC-V response rate is kept while CRC/framing errors stay marginal;
+  // once dropped it only comes back when they settled to half that.
+  bool fast_rate_ok(bool fast_now) const {
+    return this->garbled_avg_ <= (fast_now ? ERROR_MARGINAL : ERROR_MARGINAL / 2);
+  }
+
+ protected:
+  static constexpr uint16_t ONE = 1024;
+  static constexpr uint16_t ERROR_MARGINAL = ONE / 10;  // 10 %
+  static constexpr uint16_t ERROR_BAD = ONE / 4;        // 25 %
+  static constexpr uint32_t FWT_STEP_1FC = 13560U * 5U;  // 5 ms at 13.56 MHz
+
+  static void ewma_(uint16_t &avg, bool hit) {
+    int32_t target = hit ? ONE : 0;
+    avg = (uint16_t) ((int32_t) avg + (target - (int32_t) avg) / 16);
+  }
+
+  std::atomic<uint32_t> total_{0};
+  std::atomic<uint32_t> crc_{0};
+  std::atomic<uint32_t> framing_{0};
+  std::atomic<uint32_t> timeout_{0};
+  std::atomic<uint32_t> other_{0};
+  std::atomic<uint32_t> rssi_sum_{0};
+
+  // Policy inputs, worker context only
+  uint16_t error_avg_{0};
+  uint16_t timeout_avg_{0};
+  uint16_t garbled_avg_{0};
+};
+
+}  // namespace st25r3918
+}  // namespace esphome
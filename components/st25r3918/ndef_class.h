@@ -186,6 +186,7 @@ class NdefClass {
       memset(&subCtx.t1t, 0, sizeof(ndefT1TContext));
       ndefRecordPoolIndex = 0;
       memset(ndefRecordPool, 0, (sizeof(ndefRecord) * NDEF_MAX_RECORD));
+      memset(&writeChunk, 0, sizeof(ndefWriteChunk));
     }
 
     /*
@@ -359,7 +360,10 @@ class NdefClass {
     *****************************************************************************
     * \brief Write an NDEF message
     *
-    * Write the NDEF message to the tag
+    * Write the NDEF message to the tag. The records are encoded straight into
+    * block aligned chunks that are written as they fill, so the message is
+    * never encoded as a whole and each tag block is written once; the
+    * L-field/NLEN is set when the last chunk is written.
     *
     * \param[in] message: Message to write
     *
@@ -2452,6 +2456,9 @@ class NdefClass {
     ReturnCode ndefT5TWriteCC();
     ReturnCode ndefT5TPollerWriteSingleBlock(uint16_t blockNum, const uint8_t *wrData);
     ReturnCode ndefT5TPollerReadMultipleBlocks(uint16_t firstBlockNum, uint8_t numOfBlocks, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen);
+    void ndefPollerBeginWriteChunk(uint32_t offset);
+    ReturnCode ndefPollerWriteChunk(const uint8_t *buf, uint32_t len);
+    ReturnCode ndefPollerFlushWriteChunk();
     ndefRecord *ndefAllocRecord(void);
     ReturnCode ndefRecordPayloadEncode(const ndefRecord *record, ndefBuffer *bufPayload);
     ReturnCode ndefPayloadToWifi(const ndefConstBuffer *bufPayload, ndefType *wifi);
@@ -2470,6 +2477,8 @@ class NdefClass {
 
     uint8_t ndefRecordPoolIndex;
     ndefRecord ndefRecordPool[NDEF_MAX_RECORD];
+
+    ndefWriteChunk writeChunk;
 };
 
 #endif /* NDEF_CLASS_H */
@@ -340,6 +340,94 @@ ReturnCode NdefClass::ndefPollerEndWriteMessage(uint32_t messageLen)
   }
 }
 
+/*******************************************************************************/
+void NdefClass::ndefPollerBeginWriteChunk(uint32_t offset)
+{
+  uint16_t unit;
+
+  switch (type) {
+    case NDEF_DEV_T2T:
+      unit = 4U;
+      break;
+    case NDEF_DEV_T3T:
+      unit = NDEF_T3T_BLOCK_SIZE;
+      break;
+    case NDEF_DEV_T5T:
+      unit = (subCtx.t5t.blockLen != 0U) ? subCtx.t5t.blockLen : 1U;
+      break;
+    case NDEF_DEV_T4T:
+    default:
+      /* No blocks: one C-APDU per chunk */
+      unit = ((subCtx.t4t.curMLc != 0U) && (subCtx.t4t.curMLc < NDEF_WRITE_CHUNK_MAX_LEN)) ? subCtx.t4t.curMLc : NDEF_WRITE_CHUNK_MAX_LEN;
+      break;
+  }
+
+  writeChunk.offset = offset;
+  writeChunk.len    = (uint16_t)((NDEF_WRITE_CHUNK_MAX_LEN / unit) * unit);
+  writeChunk.fill   = 0U;
+}
+
+/*******************************************************************************/
+ReturnCode NdefClass::ndefPollerWriteChunk(const uint8_t *buf, uint32_t len)
+{
+  ReturnCode      err;
+  const uint8_t *src    = buf;
+  uint32_t        remain = len;
+  uint32_t        room;
+  uint32_t        direct;
+
+  while (remain != 0U) {
+    if ((writeChunk.fill == 0U) && ((writeChunk.offset % writeChunk.len) == 0U) && (remain >= writeChunk.len)) {
+      /* Aligned and at least one chunk long: write the whole chunks from the source */
+      direct = (remain / writeChunk.len) * writeChunk.len;
+      err = ndefPollerWriteBytes(writeChunk.offset, src, direct);
+      if (err != ERR_NONE) {
+        return err;
+      }
+      writeChunk.offset += direct;
+      src                = &src[direct];
+      remain            -= direct;
+      continue;
+    }
+
+    /* Stage up to the next chunk boundary, write the chunk once it is reached */
+    room = writeChunk.len - ((writeChunk.offset + writeChunk.fill) % writeChunk.len);
+    if (room > remain) {
+      room = remain;
+    }
+    (void)ST_MEMCPY(&writeChunk.buf[writeChunk.fill], src, room);
+    writeChunk.fill += (uint16_t)room;
+    src              = &src[room];
+    remain          -= room;
+    if (((writeChunk.offset + writeChunk.fill) % writeChunk.len) == 0U) {
+      err = ndefPollerFlushWriteChunk();
+      if (err != ERR_NONE) {
+        return err;
+      }
+    }
+  }
+
+  return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode NdefClass::ndefPollerFlushWriteChunk()
+{
+  ReturnCode err;
+
+  if (writeChunk.fill == 0U) {
+    return ERR_NONE;
+  }
+  err = ndefPollerWriteBytes(writeChunk.offset, writeChunk.buf, writeChunk.fill);
+  if (err != ERR_NONE) {
+    return err;
+  }
+  writeChunk.offset += writeChunk.fill;
+  writeChunk.fill    = 0U;
+
+  return ERR_NONE;
+}
+
 /*******************************************************************************/
 ReturnCode NdefClass::ndefPollerWriteMessage(const ndefMessage *message)
 {
@@ -349,7 +437,6 @@ ReturnCode NdefClass::ndefPollerWriteMessage(const ndefMessage *message)
   uint8_t         recordHeaderBuf[NDEF_RECORD_HEADER_LEN];
   ndefBuffer      bufHeader;
   ndefConstBuffer bufPayloadItem;
-  uint32_t        offset;
   bool            firstPayloadItem;
 
   if ((message == NULL)) {
@@ -378,54 +465,45 @@ ReturnCode NdefClass::ndefPollerWriteMessage(const ndefMessage *message)
   }
 
   if (info.length != 0U) {
-    offset = messageOffset;
+    /* Encode the records straight into block aligned chunks, written as they fill:
+     * no read-modify-write of a block per record field, no buffer for the whole message */
+    ndefPollerBeginWriteChunk(messageOffset);
     record = ndefMessageGetFirstRecord(message);
 
     while (record != NULL) {
       bufHeader.buffer = recordHeaderBuf;
       bufHeader.length = sizeof(recordHeaderBuf);
       (void)ndefRecordEncodeHeader(record, &bufHeader);
-      err = ndefPollerWriteBytes(offset, bufHeader.buffer, bufHeader.length);
-      if (err != ERR_NONE) {
-        return err;
-      }
-      offset += bufHeader.length;
+      err = ndefPollerWriteChunk(bufHeader.buffer, bufHeader.length);
       // TODO Use API to access record internal
-      if (record->typeLength != 0U) {
-        err = ndefPollerWriteBytes(offset, record->type, record->typeLength);
-        if (err != ERR_NONE) {
-          /* Conclude procedure */
-          state = NDEF_STATE_INVALID;
-          return err;
-        }
-        offset += record->typeLength;
+      if ((err == ERR_NONE) && (record->typeLength != 0U)) {
+        err = ndefPollerWriteChunk(record->type, record->typeLength);
       }
-      if (record->idLength != 0U) {
-        err = ndefPollerWriteBytes(offset, record->id, record->idLength);
-        if (err != ERR_NONE) {
-          /* Conclude procedure */
-          state = NDEF_STATE_INVALID;
-          return err;
-        }
-        offset += record->idLength;
+      if ((err == ERR_NONE) && (record->idLength != 0U)) {
+        err = ndefPollerWriteChunk(record->id, record->idLength);
       }
-      if (ndefRecordGetPayloadLength(record) != 0U) {
+      if ((err == ERR_NONE) && (ndefRecordGetPayloadLength(record) != 0U)) {
         firstPayloadItem = true;
-        while (ndefRecordGetPayloadItem(record, &bufPayloadItem, firstPayloadItem) != NULL) {
+        while ((err == ERR_NONE) && (ndefRecordGetPayloadItem(record, &bufPayloadItem, firstPayloadItem) != NULL)) {
           firstPayloadItem = false;
-          err = ndefPollerWriteBytes(offset, bufPayloadItem.buffer, bufPayloadItem.length);
-          if (err != ERR_NONE) {
-            /* Conclude procedure */
-            state = NDEF_STATE_INVALID;
-            return err;
+          if (bufPayloadItem.length != 0U) {
+            err = ndefPollerWriteChunk(bufPayloadItem.buffer, bufPayloadItem.length);
           }
-          offset += bufPayloadItem.length;
         }
       }
+      if (err != ERR_NONE) {
+        /* Conclude procedure */
+        state = NDEF_STATE_INVALID;
+        return err;
+      }
       record = ndefMessageGetNextRecord(record);
     }
 
-    err = ndefPollerEndWriteMessage(info.length);
+    /* Last partial chunk, then the L-Field/NLEN field */
+    err = ndefPollerFlushWriteChunk();
+    if (err == ERR_NONE) {
+      err = ndefPollerEndWriteMessage(info.length);
+    }
     if (err != ERR_NONE) {
       /* Conclude procedure */
       state = NDEF_STATE_INVALID;
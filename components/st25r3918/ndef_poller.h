@@ -98,6 +98,8 @@
 #define NDEF_T5T_TxRx_BUFF_SIZE               \
           (32U +  NDEF_T5T_TxRx_BUFF_HEADER_SIZE + NDEF_T5T_TxRx_BUFF_FOOTER_SIZE)     /*!< T5T working buffer size                                      */
 
+#define NDEF_WRITE_CHUNK_MAX_LEN             64U                                       /*!< Staging buffer of a streamed message write: 4 T3T blocks     */
+
 /*
  ******************************************************************************
  * GLOBAL MACROS
@@ -273,6 +275,14 @@ typedef struct {
   uint8_t                      txrxBuf[NDEF_T5T_TxRx_BUFF_SIZE];  /*!< Tx Rx Buffer                                  */
 } ndefT5TContext;
 
+/*! Staging chunk of a streamed NDEF message write */
+typedef struct {
+  uint32_t                     offset;                       /*!< Tag offset of buf[0]                               */
+  uint16_t                     len;                          /*!< Chunk length, multiple of the tag block size       */
+  uint16_t                     fill;                         /*!< Bytes staged in buf                                */
+  uint8_t                      buf[NDEF_WRITE_CHUNK_MAX_LEN]; /*!< Chunk data                                        */
+} ndefWriteChunk;
+
 /*
  ******************************************************************************
  * GLOBAL FUNCTION PROTOTYPES
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace st25r3918 {
+
+// Event posted by the NFC worker (producer) to the component loop (consumer).
+enum class NfcEventType : uint8_t {
+  TAG_PRESENT,  // Same tag activated again, presence only
+  TAG_READ,     // New tag activated, memory read (cart fields valid for Pura carts)
+  ANTENNA_TUNED,     // Antenna caps found by tuning, to be saved (values valid)
+  ANTENNA_RESTORED,  // Stored antenna caps still in tune (values valid)
+  POWER_SETPOINT,    // RF power control moved, to be saved (values valid)
+};
+
+struct NfcEvent {
+  NfcEventType type{NfcEventType::TAG_PRESENT};
+  bool is_pura_cart{false};
+  uint8_t uid_len{0};
+  uint8_t uid[10]{0};
+  char cart_id[32]{0};
+  char cart_url[128]{0};
+  uint8_t values[4]{0};  // ANTENNA_*: AAT A, AAT B, amplitude, phase; POWER_SETPOINT: rfo, fail_rfo
+};
+
+// Lock-free single-producer/single-consumer ring buffer.
+// push() may only be called from one thread and pop() from one (other) thread.
+// N must be a power of two; one slot is never used so that full != empty.
+template<typename T, size_t N> class SpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+ public:
+  // Producer side. Returns false (and drops the item) when the ring is full.
+  bool push(const T &item) {
+    size_t head = this->head_.load(std::memory_order_relaxed);
+    size_t next = (head + 1) & (N - 1);
+    if (next == this->tail_.load(std::memory_order_acquire)) {
+      this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    this->items_[head] = item;
+    this->head_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Returns false when the ring is empty.
+  bool pop(T &item) {
+    size_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = this->items_[tail];
+    this->tail_.store((tail + 1) & (N - 1), std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const {
+    return this->tail_.load(std::memory_order_acquire) == this->head_.load(std::memory_order_acquire);
+  }
+
+  uint32_t dropped() const { return this->dropped_.load(std::memory_order_relaxed); }
+
+ protected:
+  T items_[N];
+  std::atomic<size_t> head_{0};  // Written by producer only
+  std::atomic<size_t> tail_{0};  // Written by consumer only
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace st25r3918
+}  // namespace esphome
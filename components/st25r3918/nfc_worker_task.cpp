@@ -0,0 +1,69 @@
+#include "nfc_worker_task.h"
+
+#ifndef USE_ESP32
+#include <chrono>
+#endif
+
+namespace esphome {
+namespace st25r3918 {
+
+static const uint32_t NFC_TASK_STACK_SIZE = 8192;
+static const uint32_t NFC_TASK_PRIORITY = 5;
+
+bool NfcWorkerTask::start(Body body, void *arg, int core, uint32_t period_ms) {
+  if (this->running_.load(std::memory_order_acquire) || body == nullptr) {
+    return false;
+  }
+  this->body_ = body;
+  this->arg_ = arg;
+  this->period_ms_ = period_ms;
+  this->running_.store(true, std::memory_order_release);
+  this->exited_.store(false, std::memory_order_release);
+
+#ifdef USE_ESP32
+  BaseType_t res = xTaskCreatePinnedToCore(NfcWorkerTask::run_, "st25r3918", NFC_TASK_STACK_SIZE, this,
+                                           NFC_TASK_PRIORITY, &this->handle_, core);
+  if (res != pdPASS) {
+    this->running_.store(false, std::memory_order_release);
+    this->exited_.store(true, std::memory_order_release);
+    return false;
+  }
+#else
+  (void) core;
+  this->thread_ = std::thread(NfcWorkerTask::run_, this);
+#endif
+  return true;
+}
+
+void NfcWorkerTask::stop() {
+  this->running_.store(false, std::memory_order_release);
+#ifdef USE_ESP32
+  while (this->handle_ != nullptr && !this->exited_.load(std::memory_order_acquire)) {
+    vTaskDelay(1);
+  }
+  this->handle_ = nullptr;
+#else
+  if (this->thread_.joinable()) {
+    this->thread_.join();
+  }
+#endif
+}
+
+void NfcWorkerTask::run_(void *self) {
+  auto *task = static_cast<NfcWorkerTask *>(self);
+  while (task->running_.load(std::memory_order_acquire)) {
+    task->body_(task->arg_);
+#ifdef USE_ESP32
+    vTaskDelay(pdMS_TO_TICKS(task->period_ms_) > 0 ? pdMS_TO_TICKS(task->period_ms_) : 1);
+#else
+    std::this_thread::sleep_for(std::chrono::milliseconds(task->period_ms_));
+#endif
+  }
+  task->exited_.store(true, std::memory_order_release);
+#ifdef USE_ESP32
+  vTaskDelete(nullptr);
+#endif
+}
+
+}  // namespace st25r3918
+}  // namespace esphome
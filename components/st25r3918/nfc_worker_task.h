@@ -0,0 +1,46 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
+namespace esphome {
+namespace st25r3918 {
+
+// Runs a function repeatedly in its own execution context: a FreeRTOS task
+// pinned to a core on ESP32, a std::thread elsewhere (host stand-in).
+class NfcWorkerTask {
+ public:
+  using Body = void (*)(void *arg);
+
+  // Start calling body(arg) in a loop, sleeping period_ms between calls.
+  bool start(Body body, void *arg, int core, uint32_t period_ms = 1);
+  // Ask the loop to exit and wait for it to finish.
+  void stop();
+  bool is_running() const { return this->running_.load(std::memory_order_acquire); }
+
+ protected:
+  static void run_(void *self);
+
+  Body body_{nullptr};
+  void *arg_{nullptr};
+  uint32_t period_ms_{1};
+  std::atomic<bool> running_{false};
+  std::atomic<bool> exited_{true};
+#ifdef USE_ESP32
+  TaskHandle_t handle_{nullptr};
+#else
+  std::thread thread_;
+#endif
+};
+
+}  // namespace st25r3918
+}  // namespace esphome
@@ -0,0 +1,125 @@
+#include "nfcv_reader.h"
+
+#include <cstring>
+
+namespace esphome {
+namespace st25r3918 {
+
+// Get System Info response: flags, info flags, UID, then the optional fields
+static const uint8_t SYS_INFO_INFO_FLAGS_POS = 1;
+static const uint8_t SYS_INFO_FIELDS_POS = 2 + RFAL_NFCV_UID_LEN;
+
+bool NfcvReader::known_(const uint8_t *tag_uid, const uint8_t *uid) const {
+  return memcmp(tag_uid, uid, RFAL_NFCV_UID_LEN) == 0;
+}
+
+NfcvTagInfo NfcvReader::begin(RfalNfcClass *nfc, const uint8_t *uid) {
+  NfcvTagInfo info;
+  memcpy(this->uid_, uid, RFAL_NFCV_UID_LEN);
+  this->selected_ = false;
+  this->fast_ = false;
+  info.ic_mfg = uid[RFAL_NFCV_UID_LEN - 2];
+
+  // Select once so the block reads go without the 8 byte UID
+  if (!(this->no_select_valid_ && this->known_(this->no_select_uid_, uid))) {
+    ReturnCode err = nfc->rfalNfcvPollerSelect(RFAL_NFCV_REQ_FLAG_DEFAULT, uid);
+    if (err == ERR_NONE) {
+      this->selected_ = true;
+    } else if (LinkQuality::classify(err) == LinkResult::OTHER) {
+      // The tag answered with an error: Select is not supported
+      memcpy(this->no_select_uid_, uid, RFAL_NFCV_UID_LEN);
+      this->no_select_valid_ = true;
+    }
+  }
+
+  bool no_fast = this->no_fast_valid_ && this->known_(this->no_fast_uid_, uid);
+  bool fast = (this->rate_ == NfcvRate::FAST) && !no_fast;
+  if (this->rate_ == NfcvRate::AUTO && !no_fast) {
+    uint8_t rx[32];
+    uint16_t rcv_len = 0;
+    if (nfc->rfalNfcvPollerGetSystemInformation(RFAL_NFCV_REQ_FLAG_DEFAULT, this->request_uid_(), rx, sizeof(rx),
+                                                &rcv_len) == ERR_NONE &&
+        rcv_len >= SYS_INFO_FIELDS_POS) {
+      uint8_t flags = rx[SYS_INFO_INFO_FLAGS_POS];
+      uint16_t pos = SYS_INFO_FIELDS_POS;
+      info.sys_info = true;
+      info.ic_mfg = rx[SYS_INFO_FIELDS_POS - 2];
+      pos += (flags & RFAL_NFCV_SYSINFO_DFSID) ? 1 : 0;
+      pos += (flags & RFAL_NFCV_SYSINFO_AFI) ? 1 : 0;
+      if ((flags & RFAL_NFCV_SYSINFO_MEMSIZE) && pos + 2 <= rcv_len) {
+        info.blocks = (uint16_t) rx[pos] + 1;
+        info.block_size = (uint8_t) ((rx[pos + 1] & 0x1F) + 1);
+        pos += 2;
+      }
+      if ((flags & RFAL_NFCV_SYSINFO_ICREF) && pos < rcv_len) {
+        info.ic_ref = rx[pos];
+      }
+      // The ST ICs answer the Fast Read commands; one that doesn't is caught by read_block()
+      fast = (info.ic_mfg == ST_MFG_CODE);
+    }
+  }
+
+  // Stay on the standard rate while CRC/framing errors are high
+  this->link_fast_ = this->link_->fast_rate_ok(this->link_fast_);
+  this->fast_ = fast && this->link_fast_;
+
+  info.selected = this->selected_;
+  info.fast = this->fast_;
+  return info;
+}
+
+ReturnCode NfcvReader::read_block(RfalNfcClass *nfc, RfalRfClass *rf, uint8_t block, uint8_t *rx_buf,
+                                  uint16_t rx_buf_len, uint16_t *rcv_len) {
+  ReturnCode err = this->read_block_once_(nfc, rf, block, rx_buf, rx_buf_len, rcv_len);
+
+  if (err != ERR_NONE && this->fast_) {
+    // Fast read not supported (error answer) or not getting through: standard rate from here on
+    if (LinkQuality::classify(err) == LinkResult::OTHER) {
+      memcpy(this->no_fast_uid_, this->uid_, RFAL_NFCV_UID_LEN);
+      this->no_fast_valid_ = true;
+    }
+    this->fast_ = false;
+    err = this->read_block_once_(nfc, rf, block, rx_buf, rx_buf_len, rcv_len);
+  }
+  if (err != ERR_NONE && this->selected_) {
+    // A field dip resets the tag to Ready, where it ignores selected requests: continue addressed
+    this->selected_ = false;
+    err = this->read_block_once_(nfc, rf, block, rx_buf, rx_buf_len, rcv_len);
+  }
+
+  if (this->fast_ && !this->link_->fast_rate_ok(true)) {
+    this->fast_ = false;
+    this->link_fast_ = false;
+  }
+  return err;
+}
+
+ReturnCode NfcvReader::read_block_once_(RfalNfcClass *nfc, RfalRfClass *rf, uint8_t block, uint8_t *rx_buf,
+                                        uint16_t rx_buf_len, uint16_t *rcv_len) {
+  ReturnCode err = ERR_NONE;
+  uint8_t attempts = 1 + this->link_->retries();
+
+  for (uint8_t attempt = 0; attempt < attempts; attempt++) {
+    memset(rx_buf, 0, rx_buf_len);
+    if (this->fast_) {
+      err = nfc->rfalST25xVPollerFastReadSingleBlock(RFAL_NFCV_REQ_FLAG_DEFAULT, this->request_uid_(), block, rx_buf,
+                                                    rx_buf_len, rcv_len);
+    } else {
+      err = nfc->rfalNfcvPollerReadSingleBlock(RFAL_NFCV_REQ_FLAG_DEFAULT, this->request_uid_(), block, rx_buf,
+                                               rx_buf_len, rcv_len);
+    }
+    uint16_t rssi = 0;
+    if (err == ERR_NONE) {
+      rf->rfalGetTransceiveRSSI(&rssi);
+    }
+    this->link_->record(err, rssi);
+
+    if (err == ERR_NONE || LinkQuality::classify(err) == LinkResult::OTHER) {
+      break;  // Done, or an error a retry won't fix
+    }
+  }
+  return err;
+}
+
+}  // namespace st25r3918
+}  // namespace esphome
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "rfal_nfc.h"
+#include "link_quality.h"
+
+#include <cstdint>
+
+namespace esphome {
+namespace st25r3918 {
+
+// Response rate of the block reads that follow inventory.
+enum class NfcvRate : uint8_t {
+  STANDARD,  // ISO15693 high data rate, 26.48 kbps
+  FAST,      // ST Fast Read Single Block, response at 52.97 kbps
+  AUTO,      // FAST when Get System Info reports an ST IC, else STANDARD
+};
+
+// What begin() learned about the tag, for logging.
+struct NfcvTagInfo {
+  bool selected{false};   // Reads go in selected mode (no UID in the request)
+  bool fast{false};       // Reads use the fast response rate
+  bool sys_info{false};   // Get System Info answered; the fields below are valid
+  uint8_t ic_mfg{0};      // IC manufacturer code (UID byte 6)
+  uint8_t ic_ref{0};      // IC reference, 0 when not reported
+  uint16_t blocks{0};     // Number of blocks, 0 when not reported
+  uint8_t block_size{0};  // Bytes per block, 0 when not reported
+};
+
+// Reads the memory of an activated NFC-V tag as cheaply as the tag and the link
+// allow: selected mode when the tag supports Select, the fast response rate when
+// the IC supports it and CRC/framing errors stay low, addressed/standard otherwise.
+// Per-transceive results go to the LinkQuality. Worker context only.
+class NfcvReader {
+ public:
+  explicit NfcvReader(LinkQuality *link) : link_(link) {}
+
+  void set_rate(NfcvRate rate) { this->rate_ = rate; }
+  NfcvRate get_rate() const { return this->rate_; }
+
+  // Start reading the tag with the given UID: Select it and pick the response rate.
+  NfcvTagInfo begin(RfalNfcClass *nfc, const uint8_t *uid);
+  // Read one block with the retries the link calls for, falling back to addressed
+  // mode and/or the standard rate when the current ones stop working.
+  ReturnCode read_block(RfalNfcClass *nfc, RfalRfClass *rf, uint8_t block, uint8_t *rx_buf, uint16_t rx_buf_len,
+                        uint16_t *rcv_len);
+
+ protected:
+  static constexpr uint8_t ST_MFG_CODE = 0x02;
+
+  ReturnCode read_block_once_(RfalNfcClass *nfc, RfalRfClass *rf, uint8_t block, uint8_t *rx_buf,
+                              uint16_t rx_buf_len, uint16_t *rcv_len);
+  const uint8_t *request_uid_() const { return this->selected_ ? nullptr : this->uid_; }
+  bool known_(const uint8_t *tag_uid, const uint8_t *uid) const;
+
+  LinkQuality *link_;
+  NfcvRate rate_{NfcvRate::AUTO};
+
+  // Tag being read
+  uint8_t uid_[RFAL_NFCV_UID_LEN];
+  bool selected_{false};
+  bool fast_{false};
+  bool link_fast_{true};  // Link quality allows the fast rate (with hysteresis)
+
+  // Last tags that rejected Select / the fast read, not asked again
+  uint8_t no_select_uid_[RFAL_NFCV_UID_LEN];
+  bool no_select_valid_{false};
+  uint8_t no_fast_uid_[RFAL_NFCV_UID_LEN];
+  bool no_fast_valid_{false};
+};
+
+}  // namespace st25r3918
+}  // namespace esphome
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace st25r3918 {
+
+// Persisted setpoint of the RF output power control
+struct PowerSetpoint {
+  uint8_t rfo;       // Driver resistance (TX_DRIVER d_res): 0 full power, 15 weakest
+  uint8_t fail_rfo;  // Lowest power that gave errors, never probed again (RFO_LEVELS: none yet)
+};
+
+// Closed-loop RF output power. The cart sits centimetres from the antenna, so
+// the driver resistance is raised (power lowered) one step after a run of clean
+// activations, as long as the field amplitude with the tag loading it keeps its
+// margin and the supply isn't sagging. Read errors or a missed presence check
+// (the same cart found again right after) take it back up two steps; the level
+// that failed is remembered so the control settles just above it instead of
+// probing it again, until a long clean run suggests the failure was a one-off.
+// RFAL worker context only.
+class PowerControl {
+ public:
+  static constexpr uint8_t RFO_LEVELS = 16;
+
+  void configure(uint8_t max_rfo, uint8_t min_amplitude) {
+    this->max_rfo_ = max_rfo < RFO_LEVELS ? max_rfo : RFO_LEVELS - 1;
+    this->min_amplitude_ = min_amplitude;
+  }
+
+  // Take over a stored setpoint; false if it doesn't fit the configured limit
+  bool restore(const PowerSetpoint &stored) {
+    if (stored.rfo > this->max_rfo_ || stored.fail_rfo > RFO_LEVELS || stored.fail_rfo <= stored.rfo) {
+      return false;
+    }
+    this->rfo_ = stored.rfo;
+    this->fail_rfo_ = stored.fail_rfo;
+    return true;
+  }
+
+  uint8_t rfo() const { return this->rfo_; }
+  PowerSetpoint setpoint() const { return {this->rfo_, this->fail_rfo_}; }
+
+  // After a clean activation: true when the amplitude and supply should be
+  // measured, as input to step_down()
+  bool clean() {
+    this->clean_++;
+    if (this->fail_rfo_ < RFO_LEVELS && this->clean_ >= RETRY_FAILED_AFTER) {
+      this->fail_rfo_++;  // Give the failed level another chance
+      this->clean_ = 0;
+    }
+    return this->clean_ >= CLEAN_TO_STEP && this->rfo_ < this->max_rfo_ && this->rfo_ + 1 < this->fail_rfo_;
+  }
+
+  // Field amplitude (AD steps, tag in the field) and supply measured after clean():
+  // true when the power changed
+  bool step_down(uint8_t amplitude, uint16_t vdd_mv) {
+    if (amplitude < this->min_amplitude_) {
+      // Margin already gone at this level: back up one step and stay there
+      return this->step_up_(1);
+    }
+    if (vdd_mv < LOW_SUPPLY_MV) {
+      return false;
+    }
+    this->rfo_++;
+    this->clean_ = 0;
+    return true;
+  }
+
+  // Read errors in an activation, or a presence check that missed the tag:
+  // true when the power changed
+  bool errors() { return this->step_up_(ERROR_STEP); }
+
+ protected:
+  static constexpr uint16_t CLEAN_TO_STEP = 8;         // Clean activations before the next step down
+  static constexpr uint16_t RETRY_FAILED_AFTER = 256;  // Clean activations before a failed level is retried
+  static constexpr uint8_t ERROR_STEP = 2;
+  static constexpr uint16_t LOW_SUPPLY_MV = 3000;  // No step down below this VDD: no headroom left
+
+  bool step_up_(uint8_t steps) {
+    this->clean_ = 0;
+    if (this->rfo_ == 0) {
+      return false;  // Already at full power
+    }
+    this->fail_rfo_ = this->rfo_;
+    this->rfo_ = this->rfo_ > steps ? this->rfo_ - steps : 0;
+    return true;
+  }
+
+  uint8_t max_rfo_{8};
+  uint8_t min_amplitude_{64};
+  uint8_t rfo_{0};
+  uint8_t fail_rfo_{RFO_LEVELS};
+  uint16_t clean_{0};
+};
+
+}  // namespace st25r3918
+}  // namespace esphome
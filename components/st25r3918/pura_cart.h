@@ -0,0 +1,156 @@
+#pragma once
+
+#include "ndef_class.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace st25r3918 {
+
+// Where the NDEF message sits in the memory of a Type 5 (NFC-V) tag
+struct CartNdefLayout {
+  uint8_t cc_len{0};        // Capability Container: 4 or 8 bytes
+  uint32_t area_len{0};     // NDEF area after the CC, from the CC memory length
+  uint32_t msg_offset{0};   // First byte of the NDEF message
+  uint32_t msg_len{0};      // NDEF message length from its TLV
+};
+
+enum class CartNdefStatus : uint8_t {
+  NEED_MORE,  // *need bytes from the start of the memory are required
+  FOUND,
+  INVALID,    // No T5T Capability Container or no NDEF message TLV
+};
+
+// Locates the NDEF message TLV from the first len bytes of a Type 5 tag memory:
+// CC (4 byte, or 8 byte with a 16 bit memory length), then NULL, lock/memory
+// control and NDEF TLVs (1 byte length or 0xFF and a 16 bit length). Returns
+// NEED_MORE with the number of bytes to read first when len doesn't cover the
+// CC or a TLV header yet. The message itself may extend past len.
+inline CartNdefStatus locate_cart_ndef(const uint8_t *data, size_t len, CartNdefLayout *layout, size_t *need) {
+  static constexpr uint8_t CC_MAGIC_1_BYTE_ADDR = 0xE1;
+  static constexpr uint8_t CC_MAGIC_2_BYTE_ADDR = 0xE2;
+  static constexpr uint8_t TLV_NULL = 0x00;
+  static constexpr uint8_t TLV_NDEF_MESSAGE = 0x03;
+  static constexpr uint8_t TLV_TERMINATOR = 0xFE;
+
+  auto more = [need](size_t n) {
+    *need = n;
+    return CartNdefStatus::NEED_MORE;
+  };
+
+  if (len < 4) {
+    return more(4);
+  }
+  if (data[0] != CC_MAGIC_1_BYTE_ADDR && data[0] != CC_MAGIC_2_BYTE_ADDR) {
+    return CartNdefStatus::INVALID;
+  }
+  if (data[2] != 0) {
+    layout->cc_len = 4;
+    layout->area_len = data[2] * 8U;
+  } else {
+    if (len < 8) {
+      return more(8);
+    }
+    layout->cc_len = 8;
+    layout->area_len = ((uint32_t) data[6] << 8 | data[7]) * 8U;
+  }
+
+  size_t end = layout->cc_len + layout->area_len;
+  size_t pos = layout->cc_len;
+  while (pos < end) {
+    if (len < pos + 1) {
+      return more(pos + 1);
+    }
+    uint8_t type = data[pos];
+    if (type == TLV_NULL) {
+      pos++;
+      continue;
+    }
+    if (type == TLV_TERMINATOR) {
+      break;
+    }
+    if (len < pos + 2) {
+      return more(pos + 2);
+    }
+    uint32_t tlv_len = data[pos + 1];
+    size_t hdr_len = 2;
+    if (tlv_len == 0xFF) {
+      if (len < pos + 4) {
+        return more(pos + 4);
+      }
+      tlv_len = (uint32_t) data[pos + 2] << 8 | data[pos + 3];
+      hdr_len = 4;
+    }
+    if (type == TLV_NDEF_MESSAGE) {
+      if (pos + hdr_len + tlv_len > end) {
+        return CartNdefStatus::INVALID;
+      }
+      layout->msg_offset = pos + hdr_len;
+      layout->msg_len = tlv_len;
+      return CartNdefStatus::FOUND;
+    }
+    pos += hdr_len + tlv_len;  // Lock control, memory control, proprietary
+  }
+  return CartNdefStatus::INVALID;
+}
+
+// Extracts the cart ID from a Pura cart URL (format: pura.com/ss?d=CARTID.yyy.CHECKSUM).
+inline void parse_cart_id(const char *url, char *cart_id, size_t cart_id_size) {
+  cart_id[0] = '\0';
+  const char *id_start = strstr(url, "?d=");
+  if (id_start == nullptr) {
+    return;
+  }
+  id_start += 3;
+  const char *dot = strchr(id_start, '.');
+  if (dot != nullptr) {
+    size_t id_len = dot - id_start;
+    if (id_len > cart_id_size - 1) {
+      id_len = cart_id_size - 1;
+    }
+    memcpy(cart_id, id_start, id_len);
+    cart_id[id_len] = '\0';
+  }
+}
+
+// Decodes the NDEF message of a Pura cart (located by locate_cart_ndef()) and
+// extracts the first URI record with its protocol prefix and the cart ID it
+// carries. Returns false, with url and cart_id left empty, when the message
+// doesn't decode or holds no URI, or when the URL doesn't fit url.
+inline bool parse_cart_ndef(NdefClass *ndef, const uint8_t *msg, size_t msg_len, char *url, size_t url_size,
+                            char *cart_id, size_t cart_id_size) {
+  url[0] = '\0';
+  cart_id[0] = '\0';
+
+  ndefConstBuffer buf = {msg, (uint32_t) msg_len};
+  ndefMessage message;
+  if (ndef->ndefMessageDecode(&buf, &message) != ERR_NONE) {
+    return false;
+  }
+
+  ndefType uri;
+  ndefRecord *record = ndefMessageGetFirstRecord(&message);
+  while (record != nullptr && ndef->ndefRecordToRtdUri(record, &uri) != ERR_NONE) {
+    record = ndefMessageGetNextRecord(record);
+  }
+  ndefConstBuffer protocol, text;
+  if (record == nullptr || ndef->ndefGetRtdUri(&uri, &protocol, &text) != ERR_NONE) {
+    return false;
+  }
+
+  if (protocol.length + text.length >= url_size) {
+    return false;
+  }
+  memcpy(url, protocol.buffer, protocol.length);
+  memcpy(url + protocol.length, text.buffer, text.length);
+  url[protocol.length + text.length] = '\0';
+
+  parse_cart_id(url, cart_id, cart_id_size);
+  return true;
+}
+
+}  // namespace st25r3918
+}  // namespace esphome
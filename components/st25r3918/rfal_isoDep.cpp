@@ -181,6 +181,7 @@
 #define RFAL_ISODEP_RATS_PARAM_FSDI_MASK       (0xF0U)  /*!< Mask bits for FSDI in RATS                         */
 #define RFAL_ISODEP_RATS_PARAM_FSDI_SHIFT      (4U)     /*!< Shift for FSDI in RATS                             */
 #define RFAL_ISODEP_RATS_PARAM_DID_MASK        (0x0FU)  /*!< Mask bits for DID in RATS                          */
+#define RFAL_ISODEP_RATS_RETRY_DELAY           (1000U)  /*!< Wait before retransmitting RATS in us              */
 
 #define RFAL_ISODEP_ATS_TL_OFFSET              (0x00U)  /*!< Offset of TL on ATS                                */
 #define RFAL_ISODEP_ATS_TA_OFFSET              (0x02U)  /*!< Offset of TA if it is present on ATS               */
@@ -276,6 +277,8 @@
 
 #define isoDepTimerStart( timer, time_ms ) (timer) = timerCalculateTimer((uint16_t)(time_ms))            /*!< Configures and starts the WTX timer  */
 #define isoDepTimerisExpired( timer )      timerIsExpired( timer )                               /*!< Checks WTX timer has expired         */
+#define isoDepTimerStartUs( timer, time_us ) (timer) = timerCalculateTimerUs((uint32_t)(time_us))      /*!< Configures and starts a us timer     */
+#define isoDepTimerisExpiredUs( timer )    timerIsExpiredUs( timer )                             /*!< Checks a us timer has expired        */
 
 /*
  ******************************************************************************
@@ -324,7 +327,7 @@ ReturnCode RfalNfcClass::isoDepTx(uint8_t pcb, const uint8_t *txBuf, uint8_t *in
 
 
   if (infLen > 0U) {
-    if (((uint32_t)infBuf - (uint32_t)txBuf) < gIsoDep.hdrLen) { /* Check that we can fit the header in the given space */
+    if ((uint32_t)(infBuf - txBuf) < gIsoDep.hdrLen) { /* Check that we can fit the header in the given space */
       return ERR_NOMEM;
     }
   }
@@ -357,7 +360,7 @@ ReturnCode RfalNfcClass::isoDepTx(uint8_t pcb, const uint8_t *txBuf, uint8_t *in
 
   *(--txBlock)      = computedPcb;               /* PCB always present */
 
-  txBufLen = (infLen + (uint16_t)((uint32_t)infBuf - (uint32_t)txBlock)); /* Calculate overall buffer size */
+  txBufLen = (infLen + (uint16_t)(infBuf - txBlock)); /* Calculate overall buffer size */
 
   if (txBufLen > (gIsoDep.fsx - ISODEP_CRC_LEN)) {                        /* Check if msg length violates the maximum frame size FSC */
     return ERR_NOTSUPP;
@@ -477,6 +480,8 @@ void RfalNfcClass::rfalIsoDepInitialize(void)
   gIsoDep.maxRetriesI    = RFAL_ISODEP_MAX_I_RETRYS;
   gIsoDep.maxRetriesRATS = RFAL_ISODEP_RATS_RETRIES;
 
+  gIsoDep.actvA.state    = ISODEP_ACTV_ST_IDLE;
+
   isoDepClearCounters();
 }
 
@@ -857,12 +862,12 @@ uint16_t RfalNfcClass::rfalIsoDepGetMaxInfLen(void)
 ReturnCode RfalNfcClass::rfalIsoDepStartTransceive(rfalIsoDepTxRxParam param)
 {
   gIsoDep.txBuf        = param.txBuf->prologue;
-  gIsoDep.txBufInfPos  = (uint8_t)((uint32_t)param.txBuf->inf - (uint32_t)param.txBuf->prologue);
+  gIsoDep.txBufInfPos  = (uint8_t)(param.txBuf->inf - param.txBuf->prologue);
   gIsoDep.txBufLen     = param.txBufLen;
   gIsoDep.isTxChaining = param.isTxChaining;
 
   gIsoDep.rxBuf        = param.rxBuf->prologue;
-  gIsoDep.rxBufInfPos  = (uint8_t)((uint32_t)param.rxBuf->inf - (uint32_t)param.rxBuf->prologue);
+  gIsoDep.rxBufInfPos  = (uint8_t)(param.rxBuf->inf - param.rxBuf->prologue);
   gIsoDep.rxBufLen     = sizeof(rfalIsoDepBufFormat);
 
   gIsoDep.rxLen        = param.rxLen;
@@ -1024,11 +1029,23 @@ ReturnCode RfalNfcClass::rfalIsoDepATTRIB(const uint8_t *nfcid0, uint8_t PARAM1,
 /*******************************************************************************/
 ReturnCode RfalNfcClass::rfalIsoDepPollAHandleActivation(rfalIsoDepFSxI FSDI, uint8_t DID, rfalBitRate maxBR, rfalIsoDepDevice *isoDepDev)
 {
-  uint8_t          RATSretries;
-  uint8_t          msgIt;
-  ReturnCode       ret;
-  rfalIsoDepPpsRes ppsRes;
+  ReturnCode ret;
+
+  EXIT_ON_ERR(ret, rfalIsoDepPollAStartActivation(FSDI, DID, maxBR, isoDepDev));
+
+  /* Blocking by API, not used by rfalNfcWorker() which runs the Start/GetStatus pair itself */
+  do {
+    yield();
+    ret = rfalIsoDepPollAGetActivationStatus();
+  } while (ret == ERR_BUSY);
+
+  return ret;
+}
+
 
+/*******************************************************************************/
+ReturnCode RfalNfcClass::rfalIsoDepPollAStartActivation(rfalIsoDepFSxI FSDI, uint8_t DID, rfalBitRate maxBR, rfalIsoDepDevice *isoDepDev)
+{
   if (isoDepDev == NULL) {
     return ERR_PARAM;
   }
@@ -1036,111 +1053,155 @@ ReturnCode RfalNfcClass::rfalIsoDepPollAHandleActivation(rfalIsoDepFSxI FSDI, ui
   /* Enable EMD handling according   Digital 1.1  4.1.1.1 ; EMVCo 2.6  4.9.2 */
   rfalRfDev->rfalSetErrorHandling(RFAL_ERRORHANDLING_EMVCO);
 
-  RATSretries = gIsoDep.maxRetriesRATS;
+  gIsoDep.actvA.FSDI        = FSDI;
+  gIsoDep.actvA.DID         = DID;
+  gIsoDep.actvA.maxBR       = maxBR;
+  gIsoDep.actvA.isoDepDev   = isoDepDev;
+  gIsoDep.actvA.RATSretries = gIsoDep.maxRetriesRATS;
+  gIsoDep.actvA.tmr         = RFAL_TIMING_NONE;
+  gIsoDep.actvA.state       = ISODEP_ACTV_ST_RATS;
 
-  /***************************************************************************/
-  /* Send RATS                                                               */
-  do {
-    /* Digital 1.1 13.7.1.1 and ISO 14443-4 5.6.1.1 - Upon a failed RATS it may be retransmitted [0,1] */
-    ret = rfalIsoDepRATS(FSDI, DID, &isoDepDev->activation.A.Listener.ATS, &isoDepDev->activation.A.Listener.ATSLen);
+  return ERR_NONE;
+}
 
-    /* EMVCo 2.6  9.6.1.1 & 9.6.1.2  If a timeout error is detected retransmit, on transmission error abort */
-    if ((gIsoDep.compMode == RFAL_COMPLIANCE_MODE_EMV) && (ret != ERR_NONE) && (ret != ERR_TIMEOUT)) {
-      break;
-    }
 
-    delay(1);
-  } while (((RATSretries--) != 0U) && (ret != ERR_NONE));
+/*******************************************************************************/
+ReturnCode RfalNfcClass::rfalIsoDepPollAGetActivationStatus(void)
+{
+  uint8_t          msgIt;
+  ReturnCode       ret;
+  rfalIsoDepPpsRes ppsRes;
+  rfalIsoDepDevice *isoDepDev;
 
+  isoDepDev = gIsoDep.actvA.isoDepDev;
 
+  switch (gIsoDep.actvA.state) {
+    /*******************************************************************************/
+    case ISODEP_ACTV_ST_RATS:
 
-  /* Switch between NFC Forum and ISO14443-4 behaviour #595
-   *   ISO14443-4  5.6.1  If RATS fails, a Deactivation sequence should be performed as defined on clause 8
-   *   Activity 1.1  9.6  Device Deactivation Activity is to be only performed when there's an active device */
-  if (ret != ERR_NONE) {
-    if (gIsoDep.compMode == RFAL_COMPLIANCE_MODE_ISO) {
-      rfalIsoDepDeselect();
-    }
-    return ret;
-  }
+      /* Give the PICC 1ms before retransmitting, checked on the next call */
+      if (gIsoDep.actvA.tmr != RFAL_TIMING_NONE) {
+        if (!isoDepTimerisExpiredUs(gIsoDep.actvA.tmr)) {
+          return ERR_BUSY;
+        }
+        gIsoDep.actvA.tmr = RFAL_TIMING_NONE;
+      }
 
-  /*******************************************************************************/
-  /* Process ATS Response                                                        */
-  isoDepDev->info.FWI  = RFAL_ISODEP_FWI_DEFAULT; /* Default value   EMVCo 2.6  5.7.2.6  */
-  isoDepDev->info.SFGI = 0;
-  isoDepDev->info.MBL  = 0;
-  isoDepDev->info.DSI  = RFAL_BR_106;
-  isoDepDev->info.DRI  = RFAL_BR_106;
-  isoDepDev->info.FSxI = (uint8_t)RFAL_ISODEP_FSXI_32;     /* FSC default value is 32 bytes  ISO14443-A  5.2.3 */
+      /* Digital 1.1 13.7.1.1 and ISO 14443-4 5.6.1.1 - Upon a failed RATS it may be retransmitted [0,1] */
+      ret = rfalIsoDepRATS(gIsoDep.actvA.FSDI, gIsoDep.actvA.DID, &isoDepDev->activation.A.Listener.ATS, &isoDepDev->activation.A.Listener.ATSLen);
 
+      if (ret != ERR_NONE) {
+        /* EMVCo 2.6  9.6.1.1 & 9.6.1.2  If a timeout error is detected retransmit, on transmission error abort */
+        if (!((gIsoDep.compMode == RFAL_COMPLIANCE_MODE_EMV) && (ret != ERR_TIMEOUT)) && (gIsoDep.actvA.RATSretries != 0U)) {
+          gIsoDep.actvA.RATSretries--;
+          isoDepTimerStartUs(gIsoDep.actvA.tmr, RFAL_ISODEP_RATS_RETRY_DELAY);
+          return ERR_BUSY;
+        }
 
-  /*******************************************************************************/
-  /* Check for ATS optional fields                                               */
-  if (isoDepDev->activation.A.Listener.ATS.TL > RFAL_ISODEP_ATS_MIN_LEN) {
-    msgIt = RFAL_ISODEP_ATS_MIN_LEN;
+        gIsoDep.actvA.state = ISODEP_ACTV_ST_IDLE;
+
+        /* Switch between NFC Forum and ISO14443-4 behaviour #595
+         *   ISO14443-4  5.6.1  If RATS fails, a Deactivation sequence should be performed as defined on clause 8
+         *   Activity 1.1  9.6  Device Deactivation Activity is to be only performed when there's an active device */
+        if (gIsoDep.compMode == RFAL_COMPLIANCE_MODE_ISO) {
+          rfalIsoDepDeselect();
+        }
+        return ret;
+      }
 
-    /* Format byte T0 is optional, if present assign FSDI */
-    isoDepDev->info.FSxI = (isoDepDev->activation.A.Listener.ATS.T0 & RFAL_ISODEP_ATS_T0_FSCI_MASK);
+      /*******************************************************************************/
+      /* Process ATS Response                                                        */
+      isoDepDev->info.FWI  = RFAL_ISODEP_FWI_DEFAULT; /* Default value   EMVCo 2.6  5.7.2.6  */
+      isoDepDev->info.SFGI = 0;
+      isoDepDev->info.MBL  = 0;
+      isoDepDev->info.DSI  = RFAL_BR_106;
+      isoDepDev->info.DRI  = RFAL_BR_106;
+      isoDepDev->info.FSxI = (uint8_t)RFAL_ISODEP_FSXI_32;     /* FSC default value is 32 bytes  ISO14443-A  5.2.3 */
 
-    /* T0 has already been processed, always the same position */
-    msgIt++;
 
-    /* Check if TA is present */
-    if ((isoDepDev->activation.A.Listener.ATS.T0 & RFAL_ISODEP_ATS_T0_TA_PRESENCE_MASK) != 0U) {
-      rfalIsoDepCalcBitRate(maxBR, ((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt++], &isoDepDev->info.DSI, &isoDepDev->info.DRI);
-    }
+      /*******************************************************************************/
+      /* Check for ATS optional fields                                               */
+      if (isoDepDev->activation.A.Listener.ATS.TL > RFAL_ISODEP_ATS_MIN_LEN) {
+        msgIt = RFAL_ISODEP_ATS_MIN_LEN;
 
-    /* Check if TB is present */
-    if ((isoDepDev->activation.A.Listener.ATS.T0 & RFAL_ISODEP_ATS_T0_TB_PRESENCE_MASK) != 0U) {
-      isoDepDev->info.SFGI  = ((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt++];
-      isoDepDev->info.FWI   = (uint8_t)((isoDepDev->info.SFGI >> RFAL_ISODEP_ATS_TB_FWI_SHIFT) & RFAL_ISODEP_ATS_FWI_MASK);
-      isoDepDev->info.SFGI &= RFAL_ISODEP_ATS_TB_SFGI_MASK;
-    }
+        /* Format byte T0 is optional, if present assign FSDI */
+        isoDepDev->info.FSxI = (isoDepDev->activation.A.Listener.ATS.T0 & RFAL_ISODEP_ATS_T0_FSCI_MASK);
 
-    /* Check if TC is present */
-    if ((isoDepDev->activation.A.Listener.ATS.T0 & RFAL_ISODEP_ATS_T0_TC_PRESENCE_MASK) != 0U) {
-      /* Check for Protocol features support */
-      /* Advanced protocol features defined on Digital 1.0 Table 69, removed after */
-      isoDepDev->info.supAdFt = (((((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt]   & RFAL_ISODEP_ATS_TC_ADV_FEAT) != 0U)  ? true : false);
-      isoDepDev->info.supDID  = (((((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt]   & RFAL_ISODEP_ATS_TC_DID)      != 0U)  ? true : false);
-      isoDepDev->info.supNAD  = (((((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt++] & RFAL_ISODEP_ATS_TC_NAD)      != 0U)  ? true : false);
-    }
-  }
+        /* T0 has already been processed, always the same position */
+        msgIt++;
+
+        /* Check if TA is present */
+        if ((isoDepDev->activation.A.Listener.ATS.T0 & RFAL_ISODEP_ATS_T0_TA_PRESENCE_MASK) != 0U) {
+          rfalIsoDepCalcBitRate(gIsoDep.actvA.maxBR, ((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt++], &isoDepDev->info.DSI, &isoDepDev->info.DRI);
+        }
 
-  isoDepDev->info.FSx  = rfalIsoDepFSxI2FSx(isoDepDev->info.FSxI);
+        /* Check if TB is present */
+        if ((isoDepDev->activation.A.Listener.ATS.T0 & RFAL_ISODEP_ATS_T0_TB_PRESENCE_MASK) != 0U) {
+          isoDepDev->info.SFGI  = ((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt++];
+          isoDepDev->info.FWI   = (uint8_t)((isoDepDev->info.SFGI >> RFAL_ISODEP_ATS_TB_FWI_SHIFT) & RFAL_ISODEP_ATS_FWI_MASK);
+          isoDepDev->info.SFGI &= RFAL_ISODEP_ATS_TB_SFGI_MASK;
+        }
 
-  isoDepDev->info.SFGT = rfalIsoDepSFGI2SFGT((uint8_t)isoDepDev->info.SFGI);
-  isoDepTimerStart(gIsoDep.SFGTTimer, isoDepDev->info.SFGT);
+        /* Check if TC is present */
+        if ((isoDepDev->activation.A.Listener.ATS.T0 & RFAL_ISODEP_ATS_T0_TC_PRESENCE_MASK) != 0U) {
+          /* Check for Protocol features support */
+          /* Advanced protocol features defined on Digital 1.0 Table 69, removed after */
+          isoDepDev->info.supAdFt = (((((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt]   & RFAL_ISODEP_ATS_TC_ADV_FEAT) != 0U)  ? true : false);
+          isoDepDev->info.supDID  = (((((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt]   & RFAL_ISODEP_ATS_TC_DID)      != 0U)  ? true : false);
+          isoDepDev->info.supNAD  = (((((uint8_t *)&isoDepDev->activation.A.Listener.ATS)[msgIt++] & RFAL_ISODEP_ATS_TC_NAD)      != 0U)  ? true : false);
+        }
+      }
 
-  isoDepDev->info.FWT  = rfalIsoDepFWI2FWT(isoDepDev->info.FWI);
-  isoDepDev->info.dFWT = RFAL_ISODEP_DFWT_20;
+      isoDepDev->info.FSx  = rfalIsoDepFSxI2FSx(isoDepDev->info.FSxI);
 
-  isoDepDev->info.DID = ((isoDepDev->info.supDID) ? DID : RFAL_ISODEP_NO_DID);
-  isoDepDev->info.NAD = RFAL_ISODEP_NO_NAD;
+      isoDepDev->info.SFGT = rfalIsoDepSFGI2SFGT((uint8_t)isoDepDev->info.SFGI);
+      isoDepTimerStart(gIsoDep.SFGTTimer, isoDepDev->info.SFGT);
 
+      isoDepDev->info.FWT  = rfalIsoDepFWI2FWT(isoDepDev->info.FWI);
+      isoDepDev->info.dFWT = RFAL_ISODEP_DFWT_20;
 
-  /*******************************************************************************/
-  /* If higher bit rates are supported by both devices, send PPS                 */
-  if ((isoDepDev->info.DSI != RFAL_BR_106) || (isoDepDev->info.DRI != RFAL_BR_106)) {
-    /* Wait until SFGT has been fulfilled */
-    while (!isoDepTimerisExpired(gIsoDep.SFGTTimer)) { /* MISRA 15.6: mandatory brackets */ };
-
-    ret = rfalIsoDepPPS(isoDepDev->info.DID, isoDepDev->info.DSI, isoDepDev->info.DRI, &ppsRes);
-
-    if (ret == ERR_NONE) {
-      /* DSI code the divisor from PICC to PCD */
-      /* DRI code the divisor from PCD to PICC */
-      rfalRfDev->rfalSetBitRate(isoDepDev->info.DRI, isoDepDev->info.DSI);
-    } else {
-      isoDepDev->info.DSI = RFAL_BR_106;
-      isoDepDev->info.DRI = RFAL_BR_106;
-    }
+      isoDepDev->info.DID = ((isoDepDev->info.supDID) ? gIsoDep.actvA.DID : RFAL_ISODEP_NO_DID);
+      isoDepDev->info.NAD = RFAL_ISODEP_NO_NAD;
+
+
+      /*******************************************************************************/
+      /* If higher bit rates are supported by both devices, send PPS once SFGT has been fulfilled */
+      if ((isoDepDev->info.DSI == RFAL_BR_106) && (isoDepDev->info.DRI == RFAL_BR_106)) {
+        break;
+      }
+      gIsoDep.actvA.state = ISODEP_ACTV_ST_PPS;
+      return ERR_BUSY;
+
+    /*******************************************************************************/
+    case ISODEP_ACTV_ST_PPS:
+
+      if (!isoDepTimerisExpired(gIsoDep.SFGTTimer)) {
+        return ERR_BUSY;
+      }
+
+      ret = rfalIsoDepPPS(isoDepDev->info.DID, isoDepDev->info.DSI, isoDepDev->info.DRI, &ppsRes);
+
+      if (ret == ERR_NONE) {
+        /* DSI code the divisor from PICC to PCD */
+        /* DRI code the divisor from PCD to PICC */
+        rfalRfDev->rfalSetBitRate(isoDepDev->info.DRI, isoDepDev->info.DSI);
+      } else {
+        isoDepDev->info.DSI = RFAL_BR_106;
+        isoDepDev->info.DRI = RFAL_BR_106;
+      }
+      break;
+
+    /*******************************************************************************/
+    default:
+      return ERR_WRONG_STATE;
   }
 
+  gIsoDep.actvA.state = ISODEP_ACTV_ST_IDLE;
+
   /*******************************************************************************/
   /* Store already FS info,  rfalIsoDepGetMaxInfLen() may be called before setting TxRx params */
   gIsoDep.fsx    = isoDepDev->info.FSx;
-  gIsoDep.ourFsx = rfalIsoDepFSxI2FSx((uint8_t)FSDI);
+  gIsoDep.ourFsx = rfalIsoDepFSxI2FSx((uint8_t)gIsoDep.actvA.FSDI);
 
   return ERR_NONE;
 }
@@ -416,6 +416,23 @@ typedef enum {
   ISODEP_ST_PICC_TX,              /*!< PICC Transmission State        */
 } rfalIsoDepState;
 
+/*! NFC-A Poller Activation states */
+typedef enum {
+  ISODEP_ACTV_ST_IDLE,            /*!< No activation ongoing          */
+  ISODEP_ACTV_ST_RATS,            /*!< Send RATS (again)              */
+  ISODEP_ACTV_ST_PPS,             /*!< Wait SFGT, then send PPS       */
+} rfalIsoDepActvState;
+
+/*! NFC-A Poller Activation context, run over several worker passes */
+typedef struct {
+  rfalIsoDepActvState state;        /*!< Activation state               */
+  rfalIsoDepFSxI      FSDI;         /*!< Frame Size Device Integer      */
+  uint8_t             DID;          /*!< Device ID                      */
+  rfalBitRate         maxBR;        /*!< Max bit rate of the Poller     */
+  rfalIsoDepDevice    *isoDepDev;   /*!< Device being activated         */
+  uint8_t             RATSretries;  /*!< RATS retries left              */
+  uint32_t            tmr;          /*!< RATS retransmission timer (us) */
+} rfalIsoDepPollAActv;
 
 
 
@@ -478,6 +495,8 @@ typedef struct {
   uint16_t                APDURxPos;        /*!< APDU Rx position               */
   bool                    isAPDURxChaining; /*!< APDU Transceive chaining flag  */
 
+  rfalIsoDepPollAActv     actvA;            /*!< NFC-A Poller Activation        */
+
 } rfalIsoDep;
 
 #endif /* RFAL_ISODEP_H_ */
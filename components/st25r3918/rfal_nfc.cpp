@@ -58,7 +58,7 @@
 #define rfalNfcIsRemDevPoller( tp )    ( ((tp)>= RFAL_NFC_POLL_TYPE_NFCA) && ((tp)<=RFAL_NFC_POLL_TYPE_AP2P ) )
 #define rfalNfcIsRemDevListener( tp )  ( /*((tp)>= RFAL_NFC_LISTEN_TYPE_NFCA) && */ ((tp)<=RFAL_NFC_LISTEN_TYPE_AP2P) )
 
-#define rfalNfcNfcNotify( st )         if( gNfcDev.disc.notifyCb != NULL )  gNfcDev.disc.notifyCb( st )
+#define rfalNfcNfcNotify( st )         if( gNfcDev.disc.notifyCb != NULL )  gNfcDev.disc.notifyCb( gNfcDev.disc.notifyCtx, st )
 
 
 /** Constructor I2C
@@ -71,7 +71,10 @@ RfalNfcClass::RfalNfcClass(RfalRfClass *rfal_rf) : rfalRfDev(rfal_rf)
   memset(&gIsoDep, 0, sizeof(rfalIsoDep));
   memset(&gRfalNfcb, 0, sizeof(rfalNfcb));
   memset(&gNfcip, 0, sizeof(rfalNfcDep));
-  memset(&gRfalNfcfGreedyF, 0, sizeof(rfalNfcfGreedyF));
+  memset(&gNfcvConf, 0, sizeof(rfalNfcvPollerConf));
+#ifdef ST25R3918_TRACE
+  gTraceState = RFAL_NFC_STATE_NOTINIT;
+#endif
 }
 
 
@@ -150,6 +153,17 @@ ReturnCode RfalNfcClass::rfalNfcDeactivate(bool discovery)
   return ERR_NONE;
 }
 
+/*******************************************************************************/
+void RfalNfcClass::rfalNfcSetDiscoveryPeriod(uint16_t period)
+{
+  gNfcDev.disc.totalDuration = period;
+
+  /* Apply to an ongoing wait right away, e.g. when going back to fast polling */
+  if (gNfcDev.state == RFAL_NFC_STATE_LISTEN_TECHDETECT) {
+    gNfcDev.discTmr = (uint32_t)timerCalculateTimer(gNfcDev.disc.totalDuration);
+  }
+}
+
 /*******************************************************************************/
 ReturnCode RfalNfcClass::rfalNfcSelect(uint8_t devIdx)
 {
@@ -216,6 +230,8 @@ void RfalNfcClass::rfalNfcWorker(void)
 {
   ReturnCode err;
 
+  rfalTraceStateChange(rfalRfDev, RFAL_TRACE_EV_NFC_STATE, gTraceState, gNfcDev.state);        /* Changed by API calls  */
+
   rfalRfDev->rfalWorker();                                                                     /* Execute RFAL process  */
 
   switch (gNfcDev.state) {
@@ -228,11 +244,16 @@ void RfalNfcClass::rfalNfcWorker(void)
     case RFAL_NFC_STATE_START_DISCOVERY:
 
       /* Initialize context for discovery cycle */
-      gNfcDev.devCnt      = 0;
-      gNfcDev.selDevIdx   = 0;
-      gNfcDev.techsFound  = RFAL_NFC_TECH_NONE;
-      gNfcDev.techs2do    = gNfcDev.disc.techs2Find;
-      gNfcDev.state       = RFAL_NFC_STATE_POLL_TECHDETECT;
+      gNfcDev.devCnt        = 0;
+      gNfcDev.selDevIdx     = 0;
+      gNfcDev.techsFound    = RFAL_NFC_TECH_NONE;
+      gNfcDev.techs2do      = gNfcDev.disc.techs2Find;
+      gNfcDev.isTechInit    = false;
+      gNfcDev.isOperOngoing = false;
+      gNfcDev.state         = RFAL_NFC_STATE_POLL_TECHDETECT;
+
+      /* Take the scratch area back from Data Exchange: NFC-V CR idle, no NFC-F responses collected */
+      ST_MEMSET(&gNfcDev.scratch.disc, 0x00, sizeof(gNfcDev.scratch.disc));
 
       /* Check if Low power Wake-Up is to be performed */
       if (gNfcDev.disc.wakeupEnabled) {
@@ -270,6 +291,7 @@ void RfalNfcClass::rfalNfcWorker(void)
         if ((err != ERR_NONE) || (gNfcDev.techsFound == RFAL_NFC_TECH_NONE)) { /* Check if any error occurred or no techs were found   */
           rfalRfDev->rfalFieldOff();
           gNfcDev.state = RFAL_NFC_STATE_LISTEN_TECHDETECT;                 /* Nothing found as poller, go to listener */
+          rfalNfcNfcNotify(gNfcDev.state);                                  /* Notify caller that the cycle ended     */
           break;
         }
 
@@ -294,7 +316,7 @@ void RfalNfcClass::rfalNfcWorker(void)
           /* If more than one device was found inform upper layer to choose which one to activate */
           if (gNfcDev.disc.notifyCb != NULL) {
             gNfcDev.state = RFAL_NFC_STATE_POLL_SELECT;
-            gNfcDev.disc.notifyCb(gNfcDev.state);
+            gNfcDev.disc.notifyCb(gNfcDev.disc.notifyCtx, gNfcDev.state);
             break;
           }
         }
@@ -309,7 +331,11 @@ void RfalNfcClass::rfalNfcWorker(void)
     /*******************************************************************************/
     case RFAL_NFC_STATE_POLL_ACTIVATION:
 
-      if (rfalNfcPollActivation(gNfcDev.selDevIdx) != ERR_NONE) {               /* Activate selected device           */
+      err = rfalNfcPollActivation(gNfcDev.selDevIdx);                           /* Activate selected device           */
+      if (err == ERR_BUSY) {                                                    /* Wait until activation is performed */
+        break;
+      }
+      if (err != ERR_NONE) {
         gNfcDev.state = RFAL_NFC_STATE_DEACTIVATION;                          /* If Activation failed, restart loop */
         break;
       }
@@ -340,7 +366,14 @@ void RfalNfcClass::rfalNfcWorker(void)
 
       rfalNfcDeactivation();                                                    /* Deactivate current device */
 
-      gNfcDev.state = ((gNfcDev.discRestart) ? RFAL_NFC_STATE_START_DISCOVERY : RFAL_NFC_STATE_IDLE);
+      /* With no listen technologies the listen phase is only the wait before the next cycle: *
+       * take it after a device too, so a present device is polled at the discovery period  */
+      if (gNfcDev.discRestart) {
+        gNfcDev.discTmr = (uint32_t)timerCalculateTimer(gNfcDev.disc.totalDuration);
+        gNfcDev.state   = RFAL_NFC_STATE_LISTEN_TECHDETECT;
+      } else {
+        gNfcDev.state   = RFAL_NFC_STATE_IDLE;
+      }
       rfalNfcNfcNotify(gNfcDev.state);                                          /* Notify caller             */
       break;
 
@@ -361,8 +394,10 @@ void RfalNfcClass::rfalNfcWorker(void)
     case RFAL_NFC_STATE_POLL_SELECT:
     case RFAL_NFC_STATE_DATAEXCHANGE_DONE:
     default:
-      return;
+      break;
   }
+
+  rfalTraceStateChange(rfalRfDev, RFAL_TRACE_EV_NFC_STATE, gTraceState, gNfcDev.state);
 }
 
 
@@ -387,8 +422,8 @@ ReturnCode RfalNfcClass::rfalNfcDataExchangeStart(uint8_t *txData, uint16_t txDa
       }
 
       *rvdLen = (uint16_t *)&gNfcDev.rxLen;
-      *rxData = (uint8_t *)((gNfcDev.activeDev->rfInterface == RFAL_NFC_INTERFACE_ISODEP) ? gNfcDev.rxBuf.isoDepBuf.inf :
-                            ((gNfcDev.activeDev->rfInterface == RFAL_NFC_INTERFACE_NFCDEP) ? gNfcDev.rxBuf.nfcDepBuf.inf : gNfcDev.rxBuf.rfBuf));
+      *rxData = (uint8_t *)((gNfcDev.activeDev->rfInterface == RFAL_NFC_INTERFACE_ISODEP) ? gNfcDev.scratch.dataEx.rxBuf.isoDepBuf.inf :
+                            ((gNfcDev.activeDev->rfInterface == RFAL_NFC_INTERFACE_NFCDEP) ? gNfcDev.scratch.dataEx.rxBuf.nfcDepBuf.inf : gNfcDev.scratch.dataEx.rxBuf.rfBuf));
       return ERR_NONE;
     }
 
@@ -398,8 +433,8 @@ ReturnCode RfalNfcClass::rfalNfcDataExchangeStart(uint8_t *txData, uint16_t txDa
       /*******************************************************************************/
       case RFAL_NFC_INTERFACE_RF:
 
-        rfalCreateByteFlagsTxRxContext(ctx, (uint8_t *)txData, txDataLen, gNfcDev.rxBuf.rfBuf, sizeof(gNfcDev.rxBuf.rfBuf), &gNfcDev.rxLen, RFAL_TXRX_FLAGS_DEFAULT, fwt);
-        *rxData = (uint8_t *)gNfcDev.rxBuf.rfBuf;
+        rfalCreateByteFlagsTxRxContext(ctx, (uint8_t *)txData, txDataLen, gNfcDev.scratch.dataEx.rxBuf.rfBuf, sizeof(gNfcDev.scratch.dataEx.rxBuf.rfBuf), &gNfcDev.rxLen, RFAL_TXRX_FLAGS_DEFAULT, fwt);
+        *rxData = (uint8_t *)gNfcDev.scratch.dataEx.rxBuf.rfBuf;
         *rvdLen = (uint16_t *)&gNfcDev.rxLen;
         err = rfalRfDev->rfalStartTransceive(&ctx);
         break;
@@ -409,7 +444,7 @@ ReturnCode RfalNfcClass::rfalNfcDataExchangeStart(uint8_t *txData, uint16_t txDa
           rfalIsoDepTxRxParam isoDepTxRx;
 
           if (txDataLen > 0U) {
-            ST_MEMCPY((uint8_t *)gNfcDev.txBuf.isoDepBuf.inf, txData, txDataLen);
+            ST_MEMCPY((uint8_t *)gNfcDev.scratch.dataEx.txBuf.isoDepBuf.inf, txData, txDataLen);
           }
 
           isoDepTxRx.DID          = RFAL_ISODEP_NO_DID;
@@ -417,13 +452,13 @@ ReturnCode RfalNfcClass::rfalNfcDataExchangeStart(uint8_t *txData, uint16_t txDa
           isoDepTxRx.FSx          = gNfcDev.activeDev->proto.isoDep.info.FSx;
           isoDepTxRx.dFWT         = gNfcDev.activeDev->proto.isoDep.info.dFWT;
           isoDepTxRx.FWT          = gNfcDev.activeDev->proto.isoDep.info.FWT;
-          isoDepTxRx.txBuf        = &gNfcDev.txBuf.isoDepBuf;
+          isoDepTxRx.txBuf        = &gNfcDev.scratch.dataEx.txBuf.isoDepBuf;
           isoDepTxRx.txBufLen     = txDataLen;
           isoDepTxRx.isTxChaining = false;
-          isoDepTxRx.rxBuf        = &gNfcDev.rxBuf.isoDepBuf;
+          isoDepTxRx.rxBuf        = &gNfcDev.scratch.dataEx.rxBuf.isoDepBuf;
           isoDepTxRx.rxLen        = &gNfcDev.rxLen;
           isoDepTxRx.isRxChaining = &gNfcDev.isRxChaining;
-          *rxData                 = (uint8_t *)gNfcDev.rxBuf.isoDepBuf.inf;
+          *rxData                 = (uint8_t *)gNfcDev.scratch.dataEx.rxBuf.isoDepBuf.inf;
           *rvdLen                 = (uint16_t *)&gNfcDev.rxLen;
 
           /*******************************************************************************/
@@ -437,20 +472,20 @@ ReturnCode RfalNfcClass::rfalNfcDataExchangeStart(uint8_t *txData, uint16_t txDa
           rfalNfcDepTxRxParam nfcDepTxRx;
 
           if (txDataLen > 0U) {
-            ST_MEMCPY((uint8_t *)gNfcDev.txBuf.nfcDepBuf.inf, txData, txDataLen);
+            ST_MEMCPY((uint8_t *)gNfcDev.scratch.dataEx.txBuf.nfcDepBuf.inf, txData, txDataLen);
           }
 
           nfcDepTxRx.DID          = RFAL_NFCDEP_DID_KEEP;
           nfcDepTxRx.FSx          = rfalNfcDepLR2FS((uint8_t)rfalNfcDepPP2LR(gNfcDev.activeDev->proto.nfcDep.activation.Target.ATR_RES.PPt));
           nfcDepTxRx.dFWT         = gNfcDev.activeDev->proto.nfcDep.info.dFWT;
           nfcDepTxRx.FWT          = gNfcDev.activeDev->proto.nfcDep.info.FWT;
-          nfcDepTxRx.txBuf        = &gNfcDev.txBuf.nfcDepBuf;
+          nfcDepTxRx.txBuf        = &gNfcDev.scratch.dataEx.txBuf.nfcDepBuf;
           nfcDepTxRx.txBufLen     = txDataLen;
           nfcDepTxRx.isTxChaining = false;
-          nfcDepTxRx.rxBuf        = &gNfcDev.rxBuf.nfcDepBuf;
+          nfcDepTxRx.rxBuf        = &gNfcDev.scratch.dataEx.rxBuf.nfcDepBuf;
           nfcDepTxRx.rxLen        = &gNfcDev.rxLen;
           nfcDepTxRx.isRxChaining = &gNfcDev.isRxChaining;
-          *rxData                 = (uint8_t *)gNfcDev.rxBuf.nfcDepBuf.inf;
+          *rxData                 = (uint8_t *)gNfcDev.scratch.dataEx.rxBuf.nfcDepBuf.inf;
           *rvdLen                 = (uint16_t *)&gNfcDev.rxLen;
 
           /*******************************************************************************/
@@ -595,15 +630,24 @@ ReturnCode RfalNfcClass::rfalNfcPollTechDetetection(void)
   /* Passive NFC-A Technology Detection                                          */
   /*******************************************************************************/
   if (((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_A) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_A) != 0U)) {
-    gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_A;
+    if (!gNfcDev.isTechInit) {
+      EXIT_ON_ERR(err, rfalNfcaPollerInitialize());                              /* Initialize RFAL for NFC-A */
+      EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                 /* Turns the Field On and starts GT timer */
+      gNfcDev.isTechInit = true;
+    }
+    if (!rfalRfDev->rfalIsGTExpired()) {                                        /* GT is checked on the next pass, not waited for */
+      return ERR_BUSY;
+    }
 
     {
       rfalNfcaSensRes sensRes;
 
-      EXIT_ON_ERR(err, rfalNfcaPollerInitialize());                              /* Initialize RFAL for NFC-A */
-      EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                 /* Turns the Field On and starts GT timer */
-
       err = rfalNfcaPollerTechnologyDetection(gNfcDev.disc.compMode, &sensRes);  /* Poll for NFC-A devices */
+      if (err == ERR_BUSY) {                                                    /* FDT Poll still running, retry on the next pass */
+        return ERR_BUSY;
+      }
+      gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_A;
+      gNfcDev.isTechInit = false;
       if (err == ERR_NONE) {
         gNfcDev.techsFound |= RFAL_NFC_POLL_TECH_A;
       }
@@ -618,15 +662,21 @@ ReturnCode RfalNfcClass::rfalNfcPollTechDetetection(void)
   /* Passive NFC-B Technology Detection                                          */
   /*******************************************************************************/
   if (((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_B) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_B) != 0U)) {
-    gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_B;
+    if (!gNfcDev.isTechInit) {
+      EXIT_ON_ERR(err, rfalNfcbPollerInitialize());                             /* Initialize RFAL for NFC-B */
+      EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                /* As field is already On only starts GT timer */
+      gNfcDev.isTechInit = true;
+    }
+    if (!rfalRfDev->rfalIsGTExpired()) {                                        /* GT is checked on the next pass, not waited for */
+      return ERR_BUSY;
+    }
+    gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_B;
+    gNfcDev.isTechInit = false;
 
     {
       rfalNfcbSensbRes sensbRes;
       uint8_t          sensbResLen;
 
-      EXIT_ON_ERR(err, rfalNfcbPollerInitialize());                             /* Initialize RFAL for NFC-B */
-      EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                /* As field is already On only starts GT timer */
-
       err = rfalNfcbPollerTechnologyDetection(gNfcDev.disc.compMode, &sensbRes, &sensbResLen);   /* Poll for NFC-B devices */
       if (err == ERR_NONE) {
         gNfcDev.techsFound |= RFAL_NFC_POLL_TECH_B;
@@ -640,10 +690,16 @@ ReturnCode RfalNfcClass::rfalNfcPollTechDetetection(void)
   /* Passive NFC-F Technology Detection                                          */
   /*******************************************************************************/
   if (((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_F) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_F) != 0U)) {
-    gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_F;
-
-    EXIT_ON_ERR(err, rfalNfcfPollerInitialize(gNfcDev.disc.nfcfBR));              /* Initialize RFAL for NFC-F */
-    EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                    /* As field is already On only starts GT timer */
+    if (!gNfcDev.isTechInit) {
+      EXIT_ON_ERR(err, rfalNfcfPollerInitialize(gNfcDev.disc.nfcfBR));            /* Initialize RFAL for NFC-F */
+      EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                  /* As field is already On only starts GT timer */
+      gNfcDev.isTechInit = true;
+    }
+    if (!rfalRfDev->rfalIsGTExpired()) {                                        /* GT is checked on the next pass, not waited for */
+      return ERR_BUSY;
+    }
+    gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_F;
+    gNfcDev.isTechInit = false;
 
     err = rfalNfcfPollerCheckPresence();                                          /* Poll for NFC-F devices */
     if (err == ERR_NONE) {
@@ -658,14 +714,20 @@ ReturnCode RfalNfcClass::rfalNfcPollTechDetetection(void)
   /* Passive NFC-V Technology Detection                                          */
   /*******************************************************************************/
   if (((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_V) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_V) != 0U)) {
-    gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_V;
+    if (!gNfcDev.isTechInit) {
+      EXIT_ON_ERR(err, rfalNfcvPollerInitialize());                               /* Initialize RFAL for NFC-V */
+      EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                  /* As field is already On only starts GT timer */
+      gNfcDev.isTechInit = true;
+    }
+    if (!rfalRfDev->rfalIsGTExpired()) {                                        /* GT is checked on the next pass, not waited for */
+      return ERR_BUSY;
+    }
+    gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_V;
+    gNfcDev.isTechInit = false;
 
     {
       rfalNfcvInventoryRes invRes;
 
-      EXIT_ON_ERR(err, rfalNfcvPollerInitialize());                                 /* Initialize RFAL for NFC-V */
-      EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                    /* As field is already On only starts GT timer */
-
       err = rfalNfcvPollerCheckPresence(&invRes);                                   /* Poll for NFC-V devices */
       if (err == ERR_NONE) {
         gNfcDev.techsFound |= RFAL_NFC_POLL_TECH_V;
@@ -680,10 +742,16 @@ ReturnCode RfalNfcClass::rfalNfcPollTechDetetection(void)
   /* Passive Proprietary Technology ST25TB                                       */
   /*******************************************************************************/
   if (((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_ST25TB) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_ST25TB) != 0U)) {
-    gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_ST25TB;
-
-    EXIT_ON_ERR(err, rfalSt25tbPollerInitialize());                               /* Initialize RFAL for NFC-V */
-    EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                    /* As field is already On only starts GT timer */
+    if (!gNfcDev.isTechInit) {
+      EXIT_ON_ERR(err, rfalSt25tbPollerInitialize());                             /* Initialize RFAL for NFC-V */
+      EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                  /* As field is already On only starts GT timer */
+      gNfcDev.isTechInit = true;
+    }
+    if (!rfalRfDev->rfalIsGTExpired()) {                                        /* GT is checked on the next pass, not waited for */
+      return ERR_BUSY;
+    }
+    gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_ST25TB;
+    gNfcDev.isTechInit = false;
 
     err = rfalSt25tbPollerCheckPresence(NULL);                                    /* Poll for ST25TB devices */
     if (err == ERR_NONE) {
@@ -733,12 +801,21 @@ ReturnCode RfalNfcClass::rfalNfcPollCollResolution(void)
   if (((gNfcDev.techsFound & RFAL_NFC_POLL_TECH_A) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_A) != 0U)) {  /* If a NFC-A device was found/detected, perform Collision Resolution */
     rfalNfcaListenDevice nfcaDevList[RFAL_NFC_MAX_DEVICES];
 
-    gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_A;
-
-    EXIT_ON_ERR(err, rfalNfcaPollerInitialize());                                 /* Initialize RFAL for NFC-A */
-    EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                    /* Ensure GT again as other technologies have also been polled */
+    if (!gNfcDev.isTechInit) {
+      EXIT_ON_ERR(err, rfalNfcaPollerInitialize());                               /* Initialize RFAL for NFC-A */
+      EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                  /* Ensure GT again as other technologies have also been polled */
+      gNfcDev.isTechInit = true;
+    }
+    if (!rfalRfDev->rfalIsGTExpired()) {                                        /* GT is checked on the next pass, not waited for */
+      return ERR_BUSY;
+    }
 
     err = rfalNfcaPollerFullCollisionResolution(gNfcDev.disc.compMode, (gNfcDev.disc.devLimit - gNfcDev.devCnt), nfcaDevList, &devCnt);
+    if (err == ERR_BUSY) {                                                      /* FDT Poll still running, retry on the next pass */
+      return ERR_BUSY;
+    }
+    gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_A;
+    gNfcDev.isTechInit = false;
     if ((err == ERR_NONE) && (devCnt != 0U)) {
       for (i = 0; i < devCnt; i++) {                                            /* Copy devices found form local Nfca list into global device list */
         gNfcDev.devList[gNfcDev.devCnt].type     = RFAL_NFC_LISTEN_TYPE_NFCA;
@@ -800,18 +877,34 @@ ReturnCode RfalNfcClass::rfalNfcPollCollResolution(void)
   /* NFC-V Collision Resolution                                                  */
   /*******************************************************************************/
   if (((gNfcDev.techsFound & RFAL_NFC_POLL_TECH_V) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_V) != 0U)) { /* If a NFC-V device was found/detected, perform Collision Resolution */
-    rfalNfcvListenDevice nfcvDevList[RFAL_NFC_MAX_DEVICES];
 
-    gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_V;
+    /* Collision Resolution is non-blocking: start it once and check it on every worker pass */
+    if (gNfcDev.scratch.disc.nfcvCR.state == RFAL_NFCV_CR_STATE_IDLE) {
+      err = rfalNfcvPollerInitialize();                                           /* Initialize RFAL for NFC-V */
+      if (err == ERR_NONE) {
+        err = rfalRfDev->rfalFieldOnAndStartGT();                               /* Ensure GT again as other technologies have also been polled */
+      }
+      if (err == ERR_NONE) {
+        err = rfalNfcvPollerStartCollisionResolution(RFAL_COMPLIANCE_MODE_NFC, (gNfcDev.disc.devLimit - gNfcDev.devCnt), gNfcDev.nfcvDevList, &gNfcDev.nfcvDevCnt);
+      }
+      if (err != ERR_NONE) {
+        gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_V;
+        return err;
+      }
+    }
 
-    EXIT_ON_ERR(err, rfalNfcvPollerInitialize());                                 /* Initialize RFAL for NFC-V */
-    EXIT_ON_ERR(err, rfalRfDev->rfalFieldOnAndStartGT());                                    /* Ensure GT again as other technologies have also been polled */
+    err = rfalNfcvPollerGetCollisionResolutionStatus();
+    if (err == ERR_BUSY) {
+      return ERR_BUSY;
+    }
+
+    gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_V;
 
-    err = rfalNfcvPollerCollisionResolution(RFAL_COMPLIANCE_MODE_NFC, (gNfcDev.disc.devLimit - gNfcDev.devCnt), nfcvDevList, &devCnt);
+    devCnt = gNfcDev.nfcvDevCnt;
     if ((err == ERR_NONE) && (devCnt != 0U)) {
-      for (i = 0; i < devCnt; i++) {                                            /* Copy devices found form local Nfcf list into global device list */
+      for (i = 0; i < devCnt; i++) {                                            /* Copy devices found form local Nfcv list into global device list */
         gNfcDev.devList[gNfcDev.devCnt].type     = RFAL_NFC_LISTEN_TYPE_NFCV;
-        gNfcDev.devList[gNfcDev.devCnt].dev.nfcv = nfcvDevList[i];
+        gNfcDev.devList[gNfcDev.devCnt].dev.nfcv = gNfcDev.nfcvDevList[i];
         gNfcDev.devCnt++;
       }
     }
@@ -891,13 +984,15 @@ ReturnCode RfalNfcClass::rfalNfcPollActivation(uint8_t devIt)
     /*******************************************************************************/
     case RFAL_NFC_LISTEN_TYPE_NFCA:
 
-      rfalNfcaPollerInitialize();
-      if (gNfcDev.devList[devIt].dev.nfca.isSleep) {                            /* Check if desired device is in Sleep */
-        rfalNfcaSensRes sensRes;
-        rfalNfcaSelRes  selRes;
+      if (!gNfcDev.isOperOngoing) {                                            /* Wake up and select only once, not on every pass */
+        rfalNfcaPollerInitialize();
+        if (gNfcDev.devList[devIt].dev.nfca.isSleep) {                          /* Check if desired device is in Sleep */
+          rfalNfcaSensRes sensRes;
+          rfalNfcaSelRes  selRes;
 
-        EXIT_ON_ERR(err, rfalNfcaPollerCheckPresence(RFAL_14443A_SHORTFRAME_CMD_WUPA, &sensRes));     /* Wake up all cards  */
-        EXIT_ON_ERR(err, rfalNfcaPollerSelect(gNfcDev.devList[devIt].dev.nfca.nfcId1, gNfcDev.devList[devIt].dev.nfca.nfcId1Len, &selRes));     /* Select specific device  */
+          EXIT_ON_ERR(err, rfalNfcaPollerCheckPresence(RFAL_14443A_SHORTFRAME_CMD_WUPA, &sensRes));   /* Wake up all cards, ERR_BUSY: retried on the next pass */
+          EXIT_ON_ERR(err, rfalNfcaPollerSelect(gNfcDev.devList[devIt].dev.nfca.nfcId1, gNfcDev.devList[devIt].dev.nfca.nfcId1Len, &selRes));     /* Select specific device  */
+        }
       }
 
       /* Set NFCID */
@@ -929,9 +1024,20 @@ ReturnCode RfalNfcClass::rfalNfcPollActivation(uint8_t devIt)
         /*******************************************************************************/
         case RFAL_NFCA_T4T:                                                   /* Device supports ISO-DEP */
 
-          /* Perform ISO-DEP (ISO14443-4) activation: RATS and PPS if supported */
-          rfalIsoDepInitialize();
-          EXIT_ON_ERR(err, rfalIsoDepPollAHandleActivation((rfalIsoDepFSxI)RFAL_ISODEP_FSDI_DEFAULT, RFAL_ISODEP_NO_DID, RFAL_BR_424, &gNfcDev.devList[devIt].proto.isoDep));
+          /* Perform ISO-DEP (ISO14443-4) activation: RATS and PPS if supported, over several passes */
+          if (!gNfcDev.isOperOngoing) {
+            rfalIsoDepInitialize();
+            EXIT_ON_ERR(err, rfalIsoDepPollAStartActivation((rfalIsoDepFSxI)RFAL_ISODEP_FSDI_DEFAULT, RFAL_ISODEP_NO_DID, RFAL_BR_424, &gNfcDev.devList[devIt].proto.isoDep));
+            gNfcDev.isOperOngoing = true;
+          }
+          err = rfalIsoDepPollAGetActivationStatus();
+          if (err == ERR_BUSY) {
+            return ERR_BUSY;
+          }
+          gNfcDev.isOperOngoing = false;
+          if (err != ERR_NONE) {
+            return err;
+          }
 
           gNfcDev.devList[devIt].rfInterface = RFAL_NFC_INTERFACE_ISODEP;   /* NFC-A T4T device activated */
           break;
@@ -1127,6 +1233,11 @@ ReturnCode RfalNfcClass::rfalNfcNfcDepActivate(rfalNfcDevice *device, rfalNfcDep
  */
 ReturnCode RfalNfcClass::rfalNfcDeactivation(void)
 {
+  /* Abort any ongoing (non-blocking) NFC-V Collision Resolution or activation */
+  gNfcDev.scratch.disc.nfcvCR.state = RFAL_NFCV_CR_STATE_IDLE;
+  gNfcDev.isTechInit    = false;
+  gNfcDev.isOperOngoing = false;
+
   /* Check if a device has been activated */
   if (gNfcDev.activeDev != NULL) {
     switch (gNfcDev.activeDev->rfInterface) {
@@ -1216,3 +1327,40 @@ bool RfalNfcClass::timerIsExpired(uint32_t timer)
 
   return false;
 }
+
+
+/*!
+ *****************************************************************************
+ * \brief  Calculate Timer (microseconds)
+ *
+ * Same as timerCalculateTimer() but with microsecond resolution
+ *
+ * \param[in]  time : time/duration in Microseconds for the timer
+ *
+ * \return u32 : The new timer calculated based on the given time
+ *****************************************************************************
+ */
+uint32_t RfalNfcClass::timerCalculateTimerUs(uint32_t time)
+{
+  return (micros() + time);
+}
+
+
+/*!
+ *****************************************************************************
+ * \brief  Checks if a microsecond Timer is Expired
+ *
+ * \param[in]  timer : the timer to check
+ *
+ * \return true  : timer has already expired
+ * \return false : timer is still running
+ *****************************************************************************
+ */
+bool RfalNfcClass::timerIsExpiredUs(uint32_t timer)
+{
+  int32_t sDiff;
+
+  sDiff = (int32_t)(timer - micros());   /* Signed diff handles the micros() roll-over */
+
+  return (sDiff < 0);
+}
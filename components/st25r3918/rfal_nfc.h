@@ -194,7 +194,7 @@ typedef struct {
 typedef struct {
   rfalComplianceMode compMode;                        /*!< Compliance mode to be used                            */
   uint16_t           techs2Find;                      /*!< Technologies to search for                            */
-  uint16_t           totalDuration;                   /*!< Duration of a whole Poll + Listen cycle               */
+  uint16_t           totalDuration;                   /*!< Field off wait between two Poll cycles (no Listen)    */
   uint8_t            devLimit;                        /*!< Max number of devices                                 */
 
   rfalBitRate        nfcfBR;                          /*!< Bit rate to poll for NFC-F                            */
@@ -206,7 +206,8 @@ typedef struct {
   rfalLmConfPA       lmConfigPA;                      /*!< Configuration for Passive Listen mode NFC-A           */
   rfalLmConfPF       lmConfigPF;                      /*!< Configuration for Passive Listen mode NFC-A           */
 
-  void (*notifyCb)(rfalNfcState st);                  /*!< Callback to Notify upper layer                        */
+  void (*notifyCb)(void *ctx, rfalNfcState st);      /*!< Callback to Notify upper layer                        */
+  void               *notifyCtx;                      /*!< Context handed back to notifyCb (e.g. the reader)     */
 
   bool               wakeupEnabled;                   /*!< Enable Wake-Up mode before polling                    */
   bool               wakeupConfigDefault;             /*!< Wake-Up mode default configuration                    */
@@ -221,6 +222,23 @@ typedef union { /*  PRQA S 0750 # MISRA 19.2 - Members of the union will not be
   rfalNfcDepBufFormat     nfcDepBuf;                  /*!< NFC-DEP Rx buffer format (with header/prologue)       */
 } rfalNfcBuffer;
 
+/*! Scratch memory shared by the discovery contexts and the Data Exchange buffers
+ *
+ * The per-technology collision resolution contexts are only used between START_DISCOVERY and
+ * POLL_ACTIVATION, the Data Exchange buffers only once a device is ACTIVATED. The state machine
+ * hands the area over: entering START_DISCOVERY clears the discovery contexts, Data Exchange
+ * is refused before ACTIVATED.                                                                                    */
+typedef union { /*  PRQA S 0750 # MISRA 19.2 - Members of the union will not be used concurrently, only one phase at a time */
+  struct {
+    rfalNfcfGreedyF       nfcfGreedyF;        /*!< NFC-F greedy collection of Poll responses             */
+    rfalNfcvCR            nfcvCR;             /*!< NFC-V non-blocking Collision Resolution context       */
+  } disc;                                     /*!< Discovery phase                                       */
+  struct {
+    rfalNfcBuffer         txBuf;              /*!< Tx buffer for Data Exchange                           */
+    rfalNfcBuffer         rxBuf;              /*!< Rx buffer for Data Exchange                           */
+  } dataEx;                                   /*!< Data Exchange phase                                   */
+} rfalNfcScratch;
+
 typedef struct {
   rfalNfcState            state;              /* Main state                                      */
   uint16_t                techsFound;         /* Technologies found bitmask                      */
@@ -232,13 +250,16 @@ typedef struct {
   rfalNfcDevice           devList[RFAL_NFC_MAX_DEVICES];   /*!< Location of device list          */
   uint8_t                 devCnt;             /* Devices found counter                           */
   uint32_t                discTmr;            /* Discovery Total duration timer                  */
+  rfalNfcvListenDevice    nfcvDevList[RFAL_NFC_MAX_DEVICES]; /* NFC-V devices of ongoing Collision Resolution */
+  uint8_t                 nfcvDevCnt;         /* NFC-V devices found counter                     */
+  bool                    isTechInit;         /* Technology initialized, GT started              */
+  bool                    isOperOngoing;      /* Activation ongoing over several worker passes   */
   ReturnCode              dataExErr;          /* Last Data Exchange error                        */
   bool                    discRestart;        /* Restart discover after deactivation flag        */
   bool                    isRxChaining;       /* Flag indicating Other device is chaining        */
   uint32_t                lmMask;             /* Listen Mode mask                                */
 
-  rfalNfcBuffer           txBuf;              /* Tx buffer for Data Exchange                     */
-  rfalNfcBuffer           rxBuf;              /* Rx buffer for Data Exchange                     */
+  rfalNfcScratch          scratch;            /* Discovery contexts / Data Exchange buffers      */
   uint16_t                rxLen;              /* Length of received data on Data Exchange        */
 } rfalNfc;
 
@@ -437,6 +458,22 @@ class RfalNfcClass {
      */
     ReturnCode rfalNfcDeactivate(bool discovery);
 
+    /*!
+     *****************************************************************************
+     * \brief  RFAL NFC Set Discovery Period
+     *
+     * Sets the time the field stays off between the end of a Poll cycle and
+     * the start of the next one, replacing the discovery's totalDuration.
+     * The wait starts when no device is found and after a device has been
+     * deactivated with discovery; it is notified as
+     * RFAL_NFC_STATE_LISTEN_TECHDETECT. A wait already ongoing restarts with
+     * the new period. With 0 the next cycle starts right away.
+     *
+     * \param[in]  period       : wait between Poll cycles in ms
+     *****************************************************************************
+     */
+    void rfalNfcSetDiscoveryPeriod(uint16_t period);
+
 
     /*
     ******************************************************************************
@@ -816,6 +853,7 @@ class RfalNfcClass {
      *  parameters. It sends RATS and if the higher bit rates are supported by
      *  both devices it additionally sends PPS
      *  Once Activated all details of the device are provided on isoDepDev
+     *  This call is blocking, rfalNfcWorker() uses rfalIsoDepPollAStartActivation()
      *
      *  \param[in]  FSDI      : Frame Size Device Integer to be used
      *  \param[in]  DID       : Device ID to be used or RFAL_ISODEP_NO_DID for not use DID
@@ -835,6 +873,41 @@ class RfalNfcClass {
      */
     ReturnCode rfalIsoDepPollAHandleActivation(rfalIsoDepFSxI FSDI, uint8_t DID, rfalBitRate maxBR, rfalIsoDepDevice *isoDepDev);
 
+    /*!
+     *****************************************************************************
+     *  \brief  ISO-DEP Poller Start NFC-A Activation
+     *
+     *  Starts a non-blocking NFC-A Activation into ISO-DEP layer (ISO14443-4),
+     *  see rfalIsoDepPollAHandleActivation(). The RATS retransmission delay and
+     *  the SFGT before PPS are timers checked by rfalIsoDepPollAGetActivationStatus()
+     *  instead of waits. isoDepDev must remain valid until the activation is done.
+     *
+     *  \param[in]  FSDI      : Frame Size Device Integer to be used
+     *  \param[in]  DID       : Device ID to be used or RFAL_ISODEP_NO_DID for not use DID
+     *  \param[in]  maxBR     : Max bit rate supported by the Poller
+     *  \param[out] isoDepDev : ISO-DEP information of the activated Listen device
+     *
+     *  \return ERR_PARAM        : Invalid parameters
+     *  \return ERR_NONE         : Activation started
+     *****************************************************************************
+     */
+    ReturnCode rfalIsoDepPollAStartActivation(rfalIsoDepFSxI FSDI, uint8_t DID, rfalBitRate maxBR, rfalIsoDepDevice *isoDepDev);
+
+    /*!
+     *****************************************************************************
+     *  \brief  ISO-DEP Poller Get NFC-A Activation Status
+     *
+     *  Runs the activation started by rfalIsoDepPollAStartActivation(): sends
+     *  RATS, or PPS once SFGT has elapsed, when due
+     *
+     *  \return ERR_BUSY         : Operation is ongoing
+     *  \return ERR_WRONG_STATE  : Activation not started
+     *  \return ERR_NONE         : No error, activation successful
+     *  \return ERR_XXXX         : Error of RATS, see rfalIsoDepPollAHandleActivation()
+     *****************************************************************************
+     */
+    ReturnCode rfalIsoDepPollAGetActivationStatus(void);
+
 
     /*!
      *****************************************************************************
@@ -933,6 +1006,7 @@ class RfalNfcClass {
      * \return ERR_FRAMING      : Framing error detected, one or more device in the field
      * \return ERR_PROTO        : Protocol error detected, one or more device in the field
      * \return ERR_TIMEOUT      : Timeout error, no listener device detected
+     * \return ERR_BUSY         : GT or FDT Poll still running, call again
      * \return ERR_NONE         : No error, one or more device in the field
      *****************************************************************************
      */
@@ -996,6 +1070,7 @@ class RfalNfcClass {
      * \return ERR_WRONG_STATE  : RFAL not initialized or incorrect mode
      * \return ERR_PARAM        : Invalid parameters
      * \return ERR_IO           : Generic internal error
+     * \return ERR_BUSY         : GT or FDT Poll still running, call again
      * \return ERR_NONE         : No error, one or more device in the field
      *****************************************************************************
      */
@@ -1062,6 +1137,7 @@ class RfalNfcClass {
      * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
      * \return ERR_PARAM        : Invalid parameters
      * \return ERR_IO           : Generic internal error
+     * \return ERR_BUSY         : GT or FDT Poll still running before ALL_REQ, call again
      * \return ERR_NONE         : No error
      *****************************************************************************
      */
@@ -1826,6 +1902,72 @@ class RfalNfcClass {
      */
     ReturnCode rfalNfcvPollerCollisionResolution(rfalComplianceMode compMode, uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt);
 
+    /*!
+     *****************************************************************************
+     * \brief  NFC-V Poller Start Collision Resolution
+     *
+     * Starts a non-blocking Collision resolution as defined in Activity 2.0 9.3.7
+     * Each call to rfalNfcvPollerGetCollisionResolutionStatus() executes at most
+     * one INVENTORY/EOF slot, the FDTV,INVENT_NORES waits in between are timers
+     * checked on the next call instead of delays.
+     * nfcvDevList and devCnt must remain valid until the resolution is done.
+     *
+     * \param[in]  compMode     : compliance mode to be performed
+     * \param[in]  devLimit     : device limit value, and size nfcaDevList
+     * \param[out] nfcvDevList  : NFC-v listener devices list
+     * \param[out] devCnt       : Devices found counter
+     *
+     * \return ERR_PARAM        : Invalid parameters
+     * \return ERR_NONE         : Collision resolution started
+     *****************************************************************************
+     */
+    ReturnCode rfalNfcvPollerStartCollisionResolution(rfalComplianceMode compMode, uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt);
+
+    /*!
+     *****************************************************************************
+     * \brief  NFC-V Poller Get Collision Resolution Status
+     *
+     * Runs the Collision resolution started by rfalNfcvPollerStartCollisionResolution()
+     *
+     * \return ERR_BUSY         : Operation is ongoing
+     * \return ERR_WRONG_STATE  : Collision resolution not started
+     * \return ERR_RF_COLLISION : Collision detected and devLimit is 0
+     * \return ERR_NONE         : No error, devCnt holds the devices found
+     *****************************************************************************
+     */
+    ReturnCode rfalNfcvPollerGetCollisionResolutionStatus(void);
+
+    /*!
+     *****************************************************************************
+     * \brief  NFC-V Poller Set Inventory Slots
+     *
+     * Selects how the NFC compliant Collision Resolution starts: with a 1 slot
+     * INVENTORY_REQ (Activity 2.0 9.3.7.1) falling back to 16 slots on collision,
+     * or directly with the 16 slots loop. Starting with 16 slots saves a round
+     * trip when responses are being garbled and would be taken as a collision.
+     *
+     * \param[in]  nSlots : RFAL_NFCV_NUM_SLOTS_1 (default) or RFAL_NFCV_NUM_SLOTS_16
+     *
+     * \return ERR_PARAM        : Invalid parameters
+     * \return ERR_NONE         : No error
+     *****************************************************************************
+     */
+    ReturnCode rfalNfcvPollerSetInventorySlots(rfalNfcvNumSlots nSlots);
+
+    /*!
+     *****************************************************************************
+     * \brief  NFC-V Poller Set FWT Margin
+     *
+     * Sets an extra wait time added to the FWT (FDTV,EOF) of every NFC-V request,
+     * giving slow or marginally coupled VICCs more time to respond
+     *
+     * \param[in]  fwtMargin : extra wait time in 1/fc (0 = none, the default)
+     *
+     * \return ERR_NONE         : No error
+     *****************************************************************************
+     */
+    ReturnCode rfalNfcvPollerSetFwtMargin(uint32_t fwtMargin);
+
     /*!
      *****************************************************************************
      * \brief  NFC-V Poller Full Collision Resolution With Sleep
@@ -3558,13 +3700,18 @@ class RfalNfcClass {
     ReturnCode rfalST25xVPollerGenericWriteMessage(uint8_t cmd, uint8_t flags, const uint8_t *uid, uint8_t msgLen, const uint8_t *msgData, uint8_t *txBuf, uint16_t txBufLen);
     uint32_t timerCalculateTimer(uint16_t time);
     bool timerIsExpired(uint32_t timer);
+    uint32_t timerCalculateTimerUs(uint32_t time);
+    bool timerIsExpiredUs(uint32_t timer);
 
     RfalRfClass *rfalRfDev;
     rfalNfc gNfcDev;
     rfalIsoDep gIsoDep;    /*!< ISO-DEP Module instance               */
     rfalNfcb gRfalNfcb; /*!< RFAL NFC-B Instance */
     rfalNfcDep gNfcip;                    /*!< NFCIP module instance                         */
-    rfalNfcfGreedyF gRfalNfcfGreedyF;   /*!< Activity's NFCF Greedy collection */
+    rfalNfcvPollerConf gNfcvConf;       /*!< NFC-V poller settings               */
+#ifdef ST25R3918_TRACE
+    uint8_t gTraceState;                /*!< Worker state last recorded in the trace */
+#endif
 
 };
 
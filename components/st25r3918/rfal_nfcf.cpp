@@ -116,12 +116,12 @@ void RfalNfcClass::rfalNfcfComputeValidSENF(rfalNfcfListenDevice *outDevInfo, ui
   /*******************************************************************************/
   /* Go through all responses check if valid and duplicates                      */
   /*******************************************************************************/
-  while ((gRfalNfcfGreedyF.pollFound > 0U) && ((*curDevIdx) < devLimit)) {
+  while ((gNfcDev.scratch.disc.nfcfGreedyF.pollFound > 0U) && ((*curDevIdx) < devLimit)) {
     duplicate = false;
-    gRfalNfcfGreedyF.pollFound--;
+    gNfcDev.scratch.disc.nfcfGreedyF.pollFound--;
 
     /* MISRA 11.3 - Cannot point directly into different object type, use local copy */
-    ST_MEMCPY((uint8_t *)&sensfCopy, (uint8_t *)&gRfalNfcfGreedyF.POLL_F[gRfalNfcfGreedyF.pollFound], sizeof(rfalNfcfSensfResBuf));
+    ST_MEMCPY((uint8_t *)&sensfCopy, (uint8_t *)&gNfcDev.scratch.disc.nfcfGreedyF.POLL_F[gNfcDev.scratch.disc.nfcfGreedyF.pollFound], sizeof(rfalNfcfSensfResBuf));
 
 
     /* Point to received SENSF_RES */
@@ -206,13 +206,13 @@ ReturnCode RfalNfcClass::rfalNfcfPollerPoll(rfalFeliCaPollSlots slots, uint16_t
 /*******************************************************************************/
 ReturnCode RfalNfcClass::rfalNfcfPollerCheckPresence(void)
 {
-  gRfalNfcfGreedyF.pollFound     = 0;
-  gRfalNfcfGreedyF.pollCollision = 0;
+  gNfcDev.scratch.disc.nfcfGreedyF.pollFound     = 0;
+  gNfcDev.scratch.disc.nfcfGreedyF.pollCollision = 0;
 
   /* ACTIVITY 1.0 & 1.1 - 9.2.3.17 SENSF_REQ  must be with number of slots equal to 4
    *                                SC must be 0xFFFF
    *                                RC must be 0x00 (No system code info required) */
-  return rfalRfDev->rfalFeliCaPoll(RFAL_FELICA_4_SLOTS, RFAL_NFCF_SYSTEMCODE, RFAL_FELICA_POLL_RC_NO_REQUEST, gRfalNfcfGreedyF.POLL_F, rfalNfcfSlots2CardNum(RFAL_FELICA_4_SLOTS), &gRfalNfcfGreedyF.pollFound, &gRfalNfcfGreedyF.pollCollision);
+  return rfalRfDev->rfalFeliCaPoll(RFAL_FELICA_4_SLOTS, RFAL_NFCF_SYSTEMCODE, RFAL_FELICA_POLL_RC_NO_REQUEST, gNfcDev.scratch.disc.nfcfGreedyF.POLL_F, rfalNfcfSlots2CardNum(RFAL_FELICA_4_SLOTS), &gNfcDev.scratch.disc.nfcfGreedyF.pollFound, &gNfcDev.scratch.disc.nfcfGreedyF.pollCollision);
 }
 
 
@@ -253,7 +253,7 @@ ReturnCode RfalNfcClass::rfalNfcfPollerCollisionResolution(rfalComplianceMode co
      * Phones detected: Samsung Galaxy Nexus,Samsung Galaxy S3,Samsung Nexus S */
     *devCnt = 0;
 
-    ret = rfalNfcfPollerPoll(RFAL_FELICA_16_SLOTS, RFAL_NFCF_SYSTEMCODE, RFAL_FELICA_POLL_RC_NO_REQUEST, gRfalNfcfGreedyF.POLL_F, &gRfalNfcfGreedyF.pollFound, &gRfalNfcfGreedyF.pollCollision);
+    ret = rfalNfcfPollerPoll(RFAL_FELICA_16_SLOTS, RFAL_NFCF_SYSTEMCODE, RFAL_FELICA_POLL_RC_NO_REQUEST, gNfcDev.scratch.disc.nfcfGreedyF.POLL_F, &gNfcDev.scratch.disc.nfcfGreedyF.pollFound, &gNfcDev.scratch.disc.nfcfGreedyF.pollCollision);
     if (ret == ERR_NONE) {
       rfalNfcfComputeValidSENF(nfcfDevList, devCnt, devLimit, false, &nfcDepFound);
     }
@@ -262,7 +262,7 @@ ReturnCode RfalNfcClass::rfalNfcfPollerCollisionResolution(rfalComplianceMode co
     /* ACTIVITY 1.1 -  9.3.6.63 Check if any device supports NFC DEP               */
     /*******************************************************************************/
     if (nfcDepFound && (compMode == RFAL_COMPLIANCE_MODE_NFC)) {
-      ret = rfalNfcfPollerPoll(RFAL_FELICA_16_SLOTS, RFAL_NFCF_SYSTEMCODE, RFAL_FELICA_POLL_RC_SYSTEM_CODE, gRfalNfcfGreedyF.POLL_F, &gRfalNfcfGreedyF.pollFound, &gRfalNfcfGreedyF.pollCollision);
+      ret = rfalNfcfPollerPoll(RFAL_FELICA_16_SLOTS, RFAL_NFCF_SYSTEMCODE, RFAL_FELICA_POLL_RC_SYSTEM_CODE, gNfcDev.scratch.disc.nfcfGreedyF.POLL_F, &gNfcDev.scratch.disc.nfcfGreedyF.pollFound, &gNfcDev.scratch.disc.nfcfGreedyF.pollCollision);
       if (ret == ERR_NONE) {
         rfalNfcfComputeValidSENF(nfcfDevList, devCnt, devLimit, true, &nfcDepFound);
       }
@@ -55,7 +55,6 @@
  */
 
 #define RFAL_NFCV_INV_REQ_FLAG            0x06U  /*!< INVENTORY_REQ  INV_FLAG  Digital  2.1  9.6.1                      */
-#define RFAL_NFCV_MASKVAL_MAX_LEN         8U     /*!< Mask value max length: 64 bits  (UID length)                      */
 #define RFAL_NFCV_MASKVAL_MAX_1SLOT_LEN   64U    /*!< Mask value max length in 1 Slot mode in bits  Digital 2.1 9.6.1.6 */
 #define RFAL_NFCV_MASKVAL_MAX_16SLOT_LEN  60U    /*!< Mask value max length in 16 Slot mode in bits Digital 2.1 9.6.1.6 */
 #define RFAL_NFCV_MAX_SLOTS               16U    /*!< NFC-V max number of Slots                                         */
@@ -71,8 +70,6 @@
 #define RFAL_NFCV_DSFI_LEN                1U     /*!< DSFID length                                                      */
 #define RFAL_NFCV_SLPREQ_REQ_FLAG         0x22U  /*!< SLPV_REQ request flags Digital 2.0 (Candidate) 9.7.1.1            */
 
-#define RFAL_NFCV_MAX_COLL_SUPPORTED      16U    /*!< Maximum number of collisions supported by the Anticollision loop  */
-
 #define RFAL_FDT_POLL_MAX                 rfalConvMsTo1fc(20) /*!< Maximum Wait time FDTV,EOF 20 ms    Digital 2.0  B.5 */
 
 
@@ -99,6 +96,8 @@
  ******************************************************************************
  */
 
+#define rfalNfcvTimerStart( timer, time_ms )  (timer) = timerCalculateTimerUs((uint32_t)(time_ms) * RFAL_US_IN_MS)  /*!< Starts a us timer with a ms value */
+
 
 /*
 ******************************************************************************
@@ -123,13 +122,6 @@ typedef struct {
 } rfalNfcvSlpvReq;
 
 
-/*! Container for a collision found during Anticollision loop */
-typedef struct {
-  uint8_t  maskLen;
-  uint8_t  maskVal[RFAL_NFCV_MASKVAL_MAX_LEN];
-} rfalNfcvCollision;
-
-
 /*
 ******************************************************************************
 * LOCAL FUNCTION PROTOTYPES
@@ -243,129 +235,202 @@ ReturnCode RfalNfcClass::rfalNfcvPollerInventory(rfalNfcvNumSlots nSlots, uint8_
 /*******************************************************************************/
 ReturnCode RfalNfcClass::rfalNfcvPollerCollisionResolution(rfalComplianceMode compMode, uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt)
 {
-  ReturnCode        ret;
-  uint8_t           slotNum;
-  uint16_t          rcvdLen;
-  uint8_t           colIt;
-  uint8_t           colCnt;
-  uint8_t           colPos;
-  bool              colPending;
-  rfalNfcvCollision colFound[RFAL_NFCV_MAX_COLL_SUPPORTED];
+  ReturnCode ret;
+
+  EXIT_ON_ERR(ret, rfalNfcvPollerStartCollisionResolution(compMode, devLimit, nfcvDevList, devCnt));
 
+  /* Blocking by API, not used by rfalNfcWorker() which runs the Start/GetStatus pair itself */
+  do {
+    yield();
+    ret = rfalNfcvPollerGetCollisionResolutionStatus();
+  } while (ret == ERR_BUSY);
 
+  return ret;
+}
+
+/*******************************************************************************/
+ReturnCode RfalNfcClass::rfalNfcvPollerStartCollisionResolution(rfalComplianceMode compMode, uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt)
+{
   if ((nfcvDevList == NULL) || (devCnt == NULL)) {
     return ERR_PARAM;
   }
 
   /* Initialize parameters */
   *devCnt = 0;
-  colIt         = 0;
-  colCnt        = 0;
-  colPending    = false;
-  ST_MEMSET(colFound, 0x00, (sizeof(rfalNfcvCollision)*RFAL_NFCV_MAX_COLL_SUPPORTED));
+  ST_MEMSET(&gNfcDev.scratch.disc.nfcvCR, 0x00, sizeof(rfalNfcvCR));
 
   if (devLimit > 0U) {      /* MISRA 21.18 */
     ST_MEMSET(nfcvDevList, 0x00, (sizeof(rfalNfcvListenDevice)*devLimit));
   }
 
-  NO_WARNING(colPending);   /* colPending is not exposed externally, in future it might become exposed/output parameter */
+  gNfcDev.scratch.disc.nfcvCR.compMode    = compMode;
+  gNfcDev.scratch.disc.nfcvCR.devLimit    = devLimit;
+  gNfcDev.scratch.disc.nfcvCR.nfcvDevList = nfcvDevList;
+  gNfcDev.scratch.disc.nfcvCR.devCnt      = devCnt;
+  gNfcDev.scratch.disc.nfcvCR.tmr         = RFAL_TIMING_NONE;
 
-  if (compMode == RFAL_COMPLIANCE_MODE_NFC) {
-    /* Send INVENTORY_REQ with one slot   Activity 2.0  9.3.7.1  (Symbol 0)  */
-    ret = rfalNfcvPollerInventory(RFAL_NFCV_NUM_SLOTS_1, 0, NULL, &nfcvDevList->InvRes, NULL);
+  if ((compMode == RFAL_COMPLIANCE_MODE_NFC) && !gNfcvConf.start16Slots) {
+    gNfcDev.scratch.disc.nfcvCR.state = RFAL_NFCV_CR_STATE_INVENTORY_1SLOT;
+  } else {
+    /* Advance to 16 slots below without mask. Will give a good chance to identify multiple cards */
+    gNfcDev.scratch.disc.nfcvCR.colCnt = 1;
+    gNfcDev.scratch.disc.nfcvCR.state  = RFAL_NFCV_CR_STATE_SLOT;
+  }
 
-    if (ret == ERR_TIMEOUT) { /* Exit if no device found     Activity 2.0  9.3.7.2 (Symbol 1)  */
-      return ERR_NONE;
-    }
-    if (ret == ERR_NONE) {    /* Device found without transmission error/collision    Activity 2.0  9.3.7.3 (Symbol 2)  */
-      (*devCnt)++;
-      return ERR_NONE;
+  return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode RfalNfcClass::rfalNfcvPollerGetCollisionResolutionStatus(void)
+{
+  ReturnCode           ret;
+  uint16_t             rcvdLen;
+  uint8_t              colPos;
+  rfalNfcvCollision    *col;
+
+  /* Ensure FDTV,INVENT_NORES is fulfilled before the next frame, without blocking */
+  if (gNfcDev.scratch.disc.nfcvCR.tmr != RFAL_TIMING_NONE) {
+    if (!timerIsExpiredUs(gNfcDev.scratch.disc.nfcvCR.tmr)) {
+      return ERR_BUSY;
     }
+    gNfcDev.scratch.disc.nfcvCR.tmr = RFAL_TIMING_NONE;
+  }
 
-    /* A Collision has been identified  Activity 2.0  9.3.7.2  (Symbol 3) */
-    colPending = true;
-    colCnt        = 1;
+  switch (gNfcDev.scratch.disc.nfcvCR.state) {
+    /*******************************************************************************/
+    case RFAL_NFCV_CR_STATE_INVENTORY_1SLOT:
 
-    /* Check if the Collision Resolution is set to perform only Collision detection   Activity 2.0  9.3.7.5 (Symbol 4)*/
-    if (devLimit == 0U) {
-      return ERR_RF_COLLISION;
-    }
+      /* Send INVENTORY_REQ with one slot   Activity 2.0  9.3.7.1  (Symbol 0)  */
+      ret = rfalNfcvPollerInventory(RFAL_NFCV_NUM_SLOTS_1, 0, NULL, &gNfcDev.scratch.disc.nfcvCR.nfcvDevList->InvRes, NULL);
 
-    delay(RFAL_NFCV_FDT_V_INVENT_NORES);
+      if (ret == ERR_TIMEOUT) { /* Exit if no device found     Activity 2.0  9.3.7.2 (Symbol 1)  */
+        gNfcDev.scratch.disc.nfcvCR.state = RFAL_NFCV_CR_STATE_IDLE;
+        return ERR_NONE;
+      }
+      if (ret == ERR_NONE) {    /* Device found without transmission error/collision    Activity 2.0  9.3.7.3 (Symbol 2)  */
+        (*gNfcDev.scratch.disc.nfcvCR.devCnt)++;
+        gNfcDev.scratch.disc.nfcvCR.state = RFAL_NFCV_CR_STATE_IDLE;
+        return ERR_NONE;
+      }
 
-    /*******************************************************************************/
-    /* Collisions pending, Anticollision loop must be executed                     */
-    /*******************************************************************************/
-  } else {
-    /* Advance to 16 slots below without mask. Will give a good chance to identify multiple cards */
-    colPending = true;
-    colCnt        = 1;
-  }
+      /* A Collision has been identified  Activity 2.0  9.3.7.2  (Symbol 3) */
+      gNfcDev.scratch.disc.nfcvCR.colCnt = 1;
 
+      /* Check if the Collision Resolution is set to perform only Collision detection   Activity 2.0  9.3.7.5 (Symbol 4)*/
+      if (gNfcDev.scratch.disc.nfcvCR.devLimit == 0U) {
+        gNfcDev.scratch.disc.nfcvCR.state = RFAL_NFCV_CR_STATE_IDLE;
+        return ERR_RF_COLLISION;
+      }
 
-  /* Execute until all collisions are resolved Activity 2.0  9.3.7.16  (Symbol 17) */
-  do {
-    /* Activity 2.0  9.3.7.5  (Symbol 6) */
-    colPending = false;
-    slotNum    = 0;
+      rfalNfcvTimerStart(gNfcDev.scratch.disc.nfcvCR.tmr, RFAL_NFCV_FDT_V_INVENT_NORES);
+
+      /*******************************************************************************/
+      /* Collisions pending, Anticollision loop must be executed                     */
+      /*******************************************************************************/
+      gNfcDev.scratch.disc.nfcvCR.slotNum = 0;
+      gNfcDev.scratch.disc.nfcvCR.state   = RFAL_NFCV_CR_STATE_SLOT;
+      break;
+
+
+    /*******************************************************************************/
+    case RFAL_NFCV_CR_STATE_SLOT:
+
+      /* Execute one slot per call until all collisions are resolved Activity 2.0  9.3.7.16  (Symbol 17) */
+      col = &gNfcDev.scratch.disc.nfcvCR.colFound[gNfcDev.scratch.disc.nfcvCR.colIt];
 
-    do {
-      if (slotNum == 0U) {
+      if (gNfcDev.scratch.disc.nfcvCR.slotNum == 0U) {
         /* Send INVENTORY_REQ with 16 slots   Activity 2.0  9.3.7.7  (Symbol 8) */
-        ret = rfalNfcvPollerInventory(RFAL_NFCV_NUM_SLOTS_16, colFound[colIt].maskLen, colFound[colIt].maskVal, &nfcvDevList[(*devCnt)].InvRes, &rcvdLen);
+        ret = rfalNfcvPollerInventory(RFAL_NFCV_NUM_SLOTS_16, col->maskLen, col->maskVal, &gNfcDev.scratch.disc.nfcvCR.nfcvDevList[(*gNfcDev.scratch.disc.nfcvCR.devCnt)].InvRes, &rcvdLen);
       } else {
-        ret = rfalRfDev->rfalISO15693TransceiveEOFAnticollision((uint8_t *)&nfcvDevList[(*devCnt)].InvRes, sizeof(rfalNfcvInventoryRes), &rcvdLen);
+        ret = rfalRfDev->rfalISO15693TransceiveEOFAnticollision((uint8_t *)&gNfcDev.scratch.disc.nfcvCR.nfcvDevList[(*gNfcDev.scratch.disc.nfcvCR.devCnt)].InvRes, sizeof(rfalNfcvInventoryRes), &rcvdLen);
       }
-      slotNum++;
+      gNfcDev.scratch.disc.nfcvCR.slotNum++;
 
       /*******************************************************************************/
       if (ret != ERR_TIMEOUT) {
         if (rcvdLen < rfalConvBytesToBits(RFAL_NFCV_INV_RES_LEN + RFAL_NFCV_CRC_LEN)) {
           /* If only a partial frame was received make sure the FDT_V_INVENT_NORES is fulfilled */
-          delay(RFAL_NFCV_FDT_V_INVENT_NORES);
+          rfalNfcvTimerStart(gNfcDev.scratch.disc.nfcvCR.tmr, RFAL_NFCV_FDT_V_INVENT_NORES);
         }
 
         if (ret == ERR_NONE) {
           /* Check if the device found is already on the list and its response is a valid INVENTORY_RES */
           if (rcvdLen == rfalConvBytesToBits(RFAL_NFCV_INV_RES_LEN + RFAL_NFCV_CRC_LEN)) {
             /* Activity 2.0  9.3.7.15  (Symbol 11) */
-            (*devCnt)++;
+            (*gNfcDev.scratch.disc.nfcvCR.devCnt)++;
           }
         } else { /* Treat everything else as collision */
           /* Activity 2.0  9.3.7.15  (Symbol 16) */
-          colPending = true;
-
 
           /*******************************************************************************/
           /* Ensure that this collision still fits on the container */
-          if (colCnt < RFAL_NFCV_MAX_COLL_SUPPORTED) {
+          if (gNfcDev.scratch.disc.nfcvCR.colCnt < RFAL_NFCV_MAX_COLL_SUPPORTED) {
             /* Store this collision on the container to be resolved later */
             /* Activity 2.0  9.3.7.15  (Symbol 16): add the collision information
              * (MASK_VAL + SN) to the list containing the collision information */
-            ST_MEMCPY(colFound[colCnt].maskVal, colFound[colIt].maskVal, RFAL_NFCV_UID_LEN);
-            colPos = colFound[colIt].maskLen;
-            colFound[colCnt].maskVal[(colPos / RFAL_BITS_IN_BYTE)]      &= (uint8_t)((1U << (colPos % RFAL_BITS_IN_BYTE)) - 1U);
-            colFound[colCnt].maskVal[(colPos / RFAL_BITS_IN_BYTE)]      |= (uint8_t)((slotNum - 1U) << (colPos % RFAL_BITS_IN_BYTE));
-            colFound[colCnt].maskVal[((colPos / RFAL_BITS_IN_BYTE) + 1U)]  = (uint8_t)((slotNum - 1U) >> (RFAL_BITS_IN_BYTE - (colPos % RFAL_BITS_IN_BYTE)));
+            ST_MEMCPY(gNfcDev.scratch.disc.nfcvCR.colFound[gNfcDev.scratch.disc.nfcvCR.colCnt].maskVal, col->maskVal, RFAL_NFCV_UID_LEN);
+            colPos = col->maskLen;
+            gNfcDev.scratch.disc.nfcvCR.colFound[gNfcDev.scratch.disc.nfcvCR.colCnt].maskVal[(colPos / RFAL_BITS_IN_BYTE)]      &= (uint8_t)((1U << (colPos % RFAL_BITS_IN_BYTE)) - 1U);
+            gNfcDev.scratch.disc.nfcvCR.colFound[gNfcDev.scratch.disc.nfcvCR.colCnt].maskVal[(colPos / RFAL_BITS_IN_BYTE)]      |= (uint8_t)((gNfcDev.scratch.disc.nfcvCR.slotNum - 1U) << (colPos % RFAL_BITS_IN_BYTE));
+            gNfcDev.scratch.disc.nfcvCR.colFound[gNfcDev.scratch.disc.nfcvCR.colCnt].maskVal[((colPos / RFAL_BITS_IN_BYTE) + 1U)]  = (uint8_t)((gNfcDev.scratch.disc.nfcvCR.slotNum - 1U) >> (RFAL_BITS_IN_BYTE - (colPos % RFAL_BITS_IN_BYTE)));
 
-            colFound[colCnt].maskLen = (colFound[colIt].maskLen + 4U);
+            gNfcDev.scratch.disc.nfcvCR.colFound[gNfcDev.scratch.disc.nfcvCR.colCnt].maskLen = (col->maskLen + 4U);
 
-            colCnt++;
+            gNfcDev.scratch.disc.nfcvCR.colCnt++;
           }
         }
       } else {
         /* Timeout */
-        delay(RFAL_NFCV_FDT_V_INVENT_NORES);
+        rfalNfcvTimerStart(gNfcDev.scratch.disc.nfcvCR.tmr, RFAL_NFCV_FDT_V_INVENT_NORES);
       }
 
       /* Check if devices found have reached device limit   Activity 2.0  9.3.7.15  (Symbol 16) */
-      if (*devCnt >= devLimit) {
-        return ERR_NONE;
+      if (*gNfcDev.scratch.disc.nfcvCR.devCnt >= gNfcDev.scratch.disc.nfcvCR.devLimit) {
+        gNfcDev.scratch.disc.nfcvCR.state = RFAL_NFCV_CR_STATE_DONE;
+        break;
       }
-    } while (slotNum < RFAL_NFCV_MAX_SLOTS);   /* Slot loop             */
-    colIt++;
-  } while (colIt < colCnt);                      /* Collisions found loop */
 
+      /* Slot loop finished, move on to the next collision found */
+      if (gNfcDev.scratch.disc.nfcvCR.slotNum >= RFAL_NFCV_MAX_SLOTS) {
+        gNfcDev.scratch.disc.nfcvCR.slotNum = 0;
+        gNfcDev.scratch.disc.nfcvCR.colIt++;
+
+        if (gNfcDev.scratch.disc.nfcvCR.colIt >= gNfcDev.scratch.disc.nfcvCR.colCnt) {
+          gNfcDev.scratch.disc.nfcvCR.state = RFAL_NFCV_CR_STATE_DONE;
+        }
+      }
+      break;
+
+
+    /*******************************************************************************/
+    case RFAL_NFCV_CR_STATE_DONE:
+      gNfcDev.scratch.disc.nfcvCR.state = RFAL_NFCV_CR_STATE_IDLE;
+      return ERR_NONE;
+
+
+    /*******************************************************************************/
+    default:
+      return ERR_WRONG_STATE;
+  }
+
+  return ERR_BUSY;
+}
+
+/*******************************************************************************/
+ReturnCode RfalNfcClass::rfalNfcvPollerSetInventorySlots(rfalNfcvNumSlots nSlots)
+{
+  if ((nSlots != RFAL_NFCV_NUM_SLOTS_1) && (nSlots != RFAL_NFCV_NUM_SLOTS_16)) {
+    return ERR_PARAM;
+  }
+
+  gNfcvConf.start16Slots = (nSlots == RFAL_NFCV_NUM_SLOTS_16);
+  return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode RfalNfcClass::rfalNfcvPollerSetFwtMargin(uint32_t fwtMargin)
+{
+  gNfcvConf.fwtMargin = fwtMargin;
   return ERR_NONE;
 }
 
@@ -759,7 +824,7 @@ ReturnCode RfalNfcClass::rfalNfcvPollerTransceiveReq(uint8_t cmd, uint8_t flags,
   }
 
   /* Transceive Command */
-  ret = rfalRfDev->rfalTransceiveBlockingTxRx((uint8_t *)&req, (RFAL_CMD_LEN + RFAL_NFCV_FLAG_LEN + (uint16_t)msgIt), rxBuf, rxBufLen, rcvLen, RFAL_TXRX_FLAGS_DEFAULT, RFAL_FDT_POLL_MAX);
+  ret = rfalRfDev->rfalTransceiveBlockingTxRx((uint8_t *)&req, (RFAL_CMD_LEN + RFAL_NFCV_FLAG_LEN + (uint16_t)msgIt), rxBuf, rxBufLen, rcvLen, RFAL_TXRX_FLAGS_DEFAULT, (RFAL_FDT_POLL_MAX + gNfcvConf.fwtMargin));
 
   /* If the Option Flag is set in certain commands an EOF needs to be sent after 20ms to retrieve the VICC response      ISO15693-3 2009  10.4.2 & 10.4.3 & 10.4.5 */
   if (((flags & (uint8_t)RFAL_NFCV_REQ_FLAG_OPTION) != 0U) && ((cmd == (uint8_t)RFAL_NFCV_CMD_WRITE_SINGLE_BLOCK) || (cmd == (uint8_t)RFAL_NFCV_CMD_WRITE_MULTIPLE_BLOCKS)        ||
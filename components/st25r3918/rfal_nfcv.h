@@ -67,6 +67,8 @@
 #define RFAL_NFCV_BLOCKNUM_LEN            1U              /*!< Block Number length on normal commands: 8 bits               */
 #define RFAL_NFCV_BLOCKNUM_EXTENDED_LEN   2U              /*!< Block Number length on extended commands: 16 bits            */
 #define RFAL_NFCV_PARAM_SKIP              0U              /*!< Skip proprietary Param Request                               */
+#define RFAL_NFCV_MASKVAL_MAX_LEN         8U              /*!< Mask value max length: 64 bits  (UID length)                 */
+#define RFAL_NFCV_MAX_COLL_SUPPORTED      16U             /*!< Maximum number of collisions supported by the Anticollision loop */
 
 
 
@@ -230,6 +232,44 @@ typedef struct {
 } rfalNfcvListenDevice;
 
 
+/*! Container for a collision found during Anticollision loop */
+typedef struct {
+  uint8_t  maskLen;
+  uint8_t  maskVal[RFAL_NFCV_MASKVAL_MAX_LEN];
+} rfalNfcvCollision;
+
+
+/*! NFC-V Collision Resolution states */
+typedef enum {
+  RFAL_NFCV_CR_STATE_IDLE,            /*!< Collision Resolution not running                     */
+  RFAL_NFCV_CR_STATE_INVENTORY_1SLOT, /*!< Send INVENTORY_REQ with one slot  Activity 2.0 9.3.7.1 */
+  RFAL_NFCV_CR_STATE_SLOT,            /*!< Execute next slot of the 16 slots anticollision loop */
+  RFAL_NFCV_CR_STATE_DONE,            /*!< Finished, waiting for the last FDTV,INVENT_NORES     */
+} rfalNfcvCRState;
+
+
+/*! NFC-V Collision Resolution context, kept across rfalNfcvPollerGetCollisionResolutionStatus() calls */
+typedef struct {
+  rfalNfcvCRState         state;                                  /*!< Current state                          */
+  rfalComplianceMode      compMode;                               /*!< Compliance mode to be performed        */
+  uint8_t                 devLimit;                               /*!< Device limit                           */
+  rfalNfcvListenDevice    *nfcvDevList;                           /*!< Location of the device list            */
+  uint8_t                 *devCnt;                                /*!< Location of the device counter         */
+  uint8_t                 colIt;                                  /*!< Collision being resolved               */
+  uint8_t                 colCnt;                                 /*!< Number of collisions found             */
+  uint8_t                 slotNum;                                /*!< Current slot on the 16 slots loop      */
+  uint32_t                tmr;                                    /*!< FDTV,INVENT_NORES timer (us)           */
+  rfalNfcvCollision       colFound[RFAL_NFCV_MAX_COLL_SUPPORTED]; /*!< Collisions found                       */
+} rfalNfcvCR;
+
+
+/*! NFC-V poller settings, kept across collision resolutions and requests */
+typedef struct {
+  bool                    start16Slots;                           /*!< Skip the 1 slot INVENTORY_REQ, start with 16 slots */
+  uint32_t                fwtMargin;                              /*!< Added to the FWT of every request (1/fc)           */
+} rfalNfcvPollerConf;
+
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTION PROTOTYPES
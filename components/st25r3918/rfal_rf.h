@@ -119,6 +119,14 @@
 #define RFAL_NFCID1_DOUBLE_LEN                     7U                                           /*!< NFCID1 length                                     */
 #define RFAL_NFCID1_SIMPLE_LEN                     4U                                           /*!< NFCID1 length                                     */
 
+#define RFAL_TRACE_BEGIN                           ((uint8_t)'B')                               /*!< Trace event phase: span begins                    */
+#define RFAL_TRACE_END                             ((uint8_t)'E')                               /*!< Trace event phase: span ends                      */
+#define RFAL_TRACE_INSTANT                         ((uint8_t)'I')                               /*!< Trace event phase: point in time                  */
+
+#define RFAL_TRACE_EV_NFC_STATE                    1U                                           /*!< Trace event: rfalNfcWorker state, arg rfalNfcState */
+#define RFAL_TRACE_EV_TXRX_STATE                   2U                                           /*!< Trace event: transceive sub-state, arg rfalTransceiveState */
+#define RFAL_TRACE_EV_COM                          3U                                           /*!< Trace event: chip transaction, end arg ReturnCode */
+
 
 /*
 ******************************************************************************
@@ -163,7 +171,7 @@
 #define rfalConv1fcToMs( t )                 (uint32_t)( (uint32_t)(t) / RFAL_1MS_IN_1FC )                               /*!< Converts the given t from 1/fc to ms       */
 #define rfalConvMsTo1fc( t )                 (uint32_t)( (uint32_t)(t) * RFAL_1MS_IN_1FC )                               /*!< Converts the given t from ms to 1/fc       */
 
-#define rfalConv1fcToUs( t )                 (uint32_t)( ((uint32_t)(t) * RFAL_US_IN_MS) / RFAL_1MS_IN_1FC)              /*!< Converts the given t from 1/fc to us       */
+#define rfalConv1fcToUs( t )                 (uint32_t)( ((uint64_t)(t) * RFAL_US_IN_MS) / RFAL_1MS_IN_1FC)              /*!< Converts the given t from 1/fc to us (64bit intermediate: no overflow above ~316ms) */
 #define rfalConvUsTo1fc( t )                 (uint32_t)( ((uint32_t)(t) * RFAL_1MS_IN_1FC) / RFAL_US_IN_MS)              /*!< Converts the given t from us to 1/fc       */
 
 #define rfalConv64fcToMs( t )                (uint32_t)( (uint32_t)(t) / (RFAL_1MS_IN_1FC / RFAL_1FC_IN_64FC) )          /*!< Converts the given t from 64/fc to ms      */
@@ -219,6 +227,14 @@
 #define rfalLogI(...)                     /*!< Macro for the info log method                   */
 #define rfalLogD(...)                     /*!< Macro for the debug log method                  */
 
+#ifdef ST25R3918_TRACE
+#define rfalTraceMark( dev, ph, id, arg )           (dev)->rfalTraceEvent( (ph), (id), (uint8_t)(arg) )   /*!< Record a timeline trace event               */
+#define rfalTraceStateChange( dev, id, tr, st )     (dev)->rfalTraceState( (id), &(tr), (uint8_t)(st) )   /*!< Record a state change as end/begin of spans */
+#else
+#define rfalTraceMark( dev, ph, id, arg )                                                                 /*!< Timeline trace disabled                     */
+#define rfalTraceStateChange( dev, id, tr, st )                                                           /*!< Timeline trace disabled                     */
+#endif
+
 
 /*
 ******************************************************************************
@@ -515,8 +531,9 @@ typedef struct {
 /*! RFAL Wake-Up Mode States */
 typedef enum {
   RFAL_WUM_STATE_NOT_INIT              = 0x00,     /*!< Not Initialized state                       */
-  RFAL_WUM_STATE_ENABLED               = 0x01,     /*!< Wake-Up mode is enabled                     */
-  RFAL_WUM_STATE_ENABLED_WOKE          = 0x02,     /*!< Wake-Up mode enabled and has received IRQ(s)*/
+  RFAL_WUM_STATE_INITIALIZING          = 0x01,     /*!< Wake-Up mode is waiting for varicaps to settle */
+  RFAL_WUM_STATE_ENABLED               = 0x02,     /*!< Wake-Up mode is enabled                     */
+  RFAL_WUM_STATE_ENABLED_WOKE          = 0x03,     /*!< Wake-Up mode enabled and has received IRQ(s)*/
 } rfalWumState;
 
 /*! RFAL Wake-Up Period/Timer */
@@ -611,7 +628,7 @@ class RfalRfClass {
      * \return ERR_NONE         : No error
      *****************************************************************************
      */
-    virtual ReturnCode rfalInitialize(void);
+    virtual ReturnCode rfalInitialize(void) = 0;
 
 
     /*!
@@ -626,7 +643,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalCalibrate(void);
+    virtual ReturnCode rfalCalibrate(void) = 0;
 
 
     /*!
@@ -643,7 +660,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalAdjustRegulators(uint16_t *result);
+    virtual ReturnCode rfalAdjustRegulators(uint16_t *result) = 0;
 
 
     /*!
@@ -657,7 +674,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual void rfalSetUpperLayerCallback(rfalUpperLayerCallback pFunc);
+    virtual void rfalSetUpperLayerCallback(rfalUpperLayerCallback pFunc) = 0;
 
 
     /*!
@@ -670,7 +687,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual void rfalSetPreTxRxCallback(rfalPreTxRxCallback pFunc);
+    virtual void rfalSetPreTxRxCallback(rfalPreTxRxCallback pFunc) = 0;
 
     /*!
      *****************************************************************************
@@ -682,7 +699,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual void rfalSetPostTxRxCallback(rfalPostTxRxCallback pFunc);
+    virtual void rfalSetPostTxRxCallback(rfalPostTxRxCallback pFunc) = 0;
 
     /*!
      *****************************************************************************
@@ -694,7 +711,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalDeinitialize(void);
+    virtual ReturnCode rfalDeinitialize(void) = 0;
 
 
     /*!
@@ -722,7 +739,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalSetMode(rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR);
+    virtual ReturnCode rfalSetMode(rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR) = 0;
 
 
     /*!
@@ -736,7 +753,7 @@ class RfalRfClass {
      * \return rfalMode : The current RFAL mode
      *****************************************************************************
      */
-    virtual rfalMode rfalGetMode(void);
+    virtual rfalMode rfalGetMode(void) = 0;
 
 
     /*!
@@ -764,7 +781,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalSetBitRate(rfalBitRate txBR, rfalBitRate rxBR);
+    virtual ReturnCode rfalSetBitRate(rfalBitRate txBR, rfalBitRate rxBR) = 0;
 
 
     /*!
@@ -786,7 +803,7 @@ class RfalRfClass {
      * \return ERR_NONE         : No error
      *****************************************************************************
      */
-    virtual ReturnCode rfalGetBitRate(rfalBitRate *txBR, rfalBitRate *rxBR);
+    virtual ReturnCode rfalGetBitRate(rfalBitRate *txBR, rfalBitRate *rxBR) = 0;
 
 
     /*!
@@ -799,7 +816,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual void rfalSetErrorHandling(rfalEHandling eHandling);
+    virtual void rfalSetErrorHandling(rfalEHandling eHandling) = 0;
 
 
     /*!
@@ -811,7 +828,7 @@ class RfalRfClass {
      * \return rfalEHandling : Current error handling mode
      *****************************************************************************
      */
-    virtual rfalEHandling rfalGetErrorHandling(void);
+    virtual rfalEHandling rfalGetErrorHandling(void) = 0;
 
 
     /*!
@@ -828,7 +845,7 @@ class RfalRfClass {
      *          Please refer to the corresponding Datasheet or Application Note(s)
      *****************************************************************************
      */
-    virtual void rfalSetObsvMode(uint8_t txMode, uint8_t rxMode);
+    virtual void rfalSetObsvMode(uint8_t txMode, uint8_t rxMode) = 0;
 
 
     /*!
@@ -842,7 +859,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual void rfalGetObsvMode(uint8_t *txMode, uint8_t *rxMode);
+    virtual void rfalGetObsvMode(uint8_t *txMode, uint8_t *rxMode) = 0;
 
 
     /*!
@@ -852,7 +869,7 @@ class RfalRfClass {
      * Disables the ST25R391x observation mode
      *****************************************************************************
      */
-    virtual void rfalDisableObsvMode(void);
+    virtual void rfalDisableObsvMode(void) = 0;
 
 
     /*!
@@ -871,7 +888,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual void rfalSetFDTPoll(uint32_t FDTPoll);
+    virtual void rfalSetFDTPoll(uint32_t FDTPoll) = 0;
 
 
     /*!
@@ -889,7 +906,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual uint32_t rfalGetFDTPoll(void);
+    virtual uint32_t rfalGetFDTPoll(void) = 0;
 
 
     /*!
@@ -906,7 +923,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual void rfalSetFDTListen(uint32_t FDTListen);
+    virtual void rfalSetFDTListen(uint32_t FDTListen) = 0;
 
 
     /*!
@@ -922,7 +939,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual uint32_t rfalGetFDTListen(void);
+    virtual uint32_t rfalGetFDTListen(void) = 0;
 
 
     /*!
@@ -938,7 +955,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual uint32_t rfalGetGT(void);
+    virtual uint32_t rfalGetGT(void) = 0;
 
 
     /*!
@@ -955,7 +972,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual void rfalSetGT(uint32_t GT);
+    virtual void rfalSetGT(uint32_t GT) = 0;
 
 
     /*!
@@ -969,7 +986,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual bool rfalIsGTExpired(void);
+    virtual bool rfalIsGTExpired(void) = 0;
 
 
     /*!
@@ -986,7 +1003,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalFieldOnAndStartGT(void);
+    virtual ReturnCode rfalFieldOnAndStartGT(void) = 0;
 
 
     /*!
@@ -998,7 +1015,7 @@ class RfalRfClass {
      * \return ERR_NONE : Field turned Off
      *****************************************************************************
      */
-    virtual ReturnCode rfalFieldOff(void);
+    virtual ReturnCode rfalFieldOff(void) = 0;
 
 
 
@@ -1027,7 +1044,7 @@ class RfalRfClass {
      * \return ERR_PARAM       : Invalid parameter or configuration
      *****************************************************************************
      */
-    virtual ReturnCode rfalStartTransceive(const rfalTransceiveContext *ctx);
+    virtual ReturnCode rfalStartTransceive(const rfalTransceiveContext *ctx) = 0;
 
 
     /*!
@@ -1039,7 +1056,7 @@ class RfalRfClass {
      * \return rfalTransceiveState : the current Transceive internal State
      *****************************************************************************
      */
-    virtual rfalTransceiveState rfalGetTransceiveState(void);
+    virtual rfalTransceiveState rfalGetTransceiveState(void) = 0;
 
 
     /*!
@@ -1060,7 +1077,7 @@ class RfalRfClass {
      * \return  ERR_IO           : Internal error
      *****************************************************************************
      */
-    virtual ReturnCode rfalGetTransceiveStatus(void);
+    virtual ReturnCode rfalGetTransceiveStatus(void) = 0;
 
 
     /*!
@@ -1073,7 +1090,7 @@ class RfalRfClass {
      * \return false  Not in transmission state
      *****************************************************************************
      */
-    virtual bool rfalIsTransceiveInTx(void);
+    virtual bool rfalIsTransceiveInTx(void) = 0;
 
 
     /*!
@@ -1086,7 +1103,7 @@ class RfalRfClass {
      * \return false  Not in reception state
      *****************************************************************************
      */
-    virtual bool rfalIsTransceiveInRx(void);
+    virtual bool rfalIsTransceiveInRx(void) = 0;
 
 
     /*!
@@ -1102,7 +1119,7 @@ class RfalRfClass {
      * \return  ERR_NONE    : No error
      *****************************************************************************
      */
-    virtual ReturnCode rfalGetTransceiveRSSI(uint16_t *rssi);
+    virtual ReturnCode rfalGetTransceiveRSSI(uint16_t *rssi) = 0;
 
 
     /*!
@@ -1115,7 +1132,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual void rfalWorker(void);
+    virtual void rfalWorker(void) = 0;
 
 
     /*****************************************************************************
@@ -1142,13 +1159,17 @@ class RfalRfClass {
      *         a response, which on a blocking method may not be the
      *         desired usage
      *
+     * The GT and FDT Poll are not waited for: while either is still running
+     * nothing is sent and ERR_BUSY is returned, the caller retries later
+     *
      * \return ERR_NONE if there is response
      * \return ERR_TIMEOUT if there is no response
      * \return ERR_COLLISION collision has occurred
+     * \return ERR_BUSY GT or FDT Poll still running, nothing sent
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalISO14443ATransceiveShortFrame(rfal14443AShortFrameCmd txCmd, uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *rxRcvdLen, uint32_t fwt);
+    virtual ReturnCode rfalISO14443ATransceiveShortFrame(rfal14443AShortFrameCmd txCmd, uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *rxRcvdLen, uint32_t fwt) = 0;
 
 
     /*!
@@ -1171,7 +1192,7 @@ class RfalRfClass {
      * \return ERR_NONE if there is no error
      *****************************************************************************
      */
-    virtual ReturnCode rfalISO14443ATransceiveAnticollisionFrame(uint8_t *buf, uint8_t *bytesToSend, uint8_t *bitsToSend, uint16_t *rxLength, uint32_t fwt);
+    virtual ReturnCode rfalISO14443ATransceiveAnticollisionFrame(uint8_t *buf, uint8_t *bytesToSend, uint8_t *bitsToSend, uint16_t *rxLength, uint32_t fwt) = 0;
 
 
     /*****************************************************************************
@@ -1198,7 +1219,7 @@ class RfalRfClass {
      * \return ERR_TIMEOUT if there is no response
      *****************************************************************************
      */
-    virtual ReturnCode rfalFeliCaPoll(rfalFeliCaPollSlots slots, uint16_t sysCode, uint8_t reqCode, rfalFeliCaPollRes *pollResList, uint8_t pollResListSize, uint8_t *devicesDetected, uint8_t *collisionsDetected);
+    virtual ReturnCode rfalFeliCaPoll(rfalFeliCaPollSlots slots, uint16_t sysCode, uint8_t reqCode, rfalFeliCaPollRes *pollResList, uint8_t pollResListSize, uint8_t *devicesDetected, uint8_t *collisionsDetected) = 0;
 
 
     /*****************************************************************************
@@ -1224,7 +1245,7 @@ class RfalRfClass {
      * \return  ERR_IO          : Internal error
      *****************************************************************************
      */
-    virtual ReturnCode rfalISO15693TransceiveAnticollisionFrame(uint8_t *txBuf, uint8_t txBufLen, uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen);
+    virtual ReturnCode rfalISO15693TransceiveAnticollisionFrame(uint8_t *txBuf, uint8_t txBufLen, uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen) = 0;
 
 
     /*!
@@ -1244,7 +1265,7 @@ class RfalRfClass {
      * \return  ERR_IO          : Internal error
      *****************************************************************************
      */
-    virtual ReturnCode rfalISO15693TransceiveEOFAnticollision(uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen);
+    virtual ReturnCode rfalISO15693TransceiveEOFAnticollision(uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen) = 0;
 
 
     /*!
@@ -1263,7 +1284,7 @@ class RfalRfClass {
      * \return  ERR_IO          : Internal error
      *****************************************************************************
      */
-    virtual ReturnCode rfalISO15693TransceiveEOF(uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen);
+    virtual ReturnCode rfalISO15693TransceiveEOF(uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen) = 0;
 
 
     /*!
@@ -1289,7 +1310,7 @@ class RfalRfClass {
      * \return  ERR_IO           : Internal error
      *****************************************************************************
      */
-    virtual ReturnCode rfalTransceiveBlockingTx(uint8_t *txBuf, uint16_t txBufLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *actLen, uint32_t flags, uint32_t fwt);
+    virtual ReturnCode rfalTransceiveBlockingTx(uint8_t *txBuf, uint16_t txBufLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *actLen, uint32_t flags, uint32_t fwt) = 0;
 
     /*!
      *****************************************************************************
@@ -1310,7 +1331,7 @@ class RfalRfClass {
      * \return  ERR_IO           : Internal error
      *****************************************************************************
      */
-    virtual ReturnCode rfalTransceiveBlockingRx(void);
+    virtual ReturnCode rfalTransceiveBlockingRx(void) = 0;
 
     /*!
      *****************************************************************************
@@ -1339,7 +1360,7 @@ class RfalRfClass {
      * \return  ERR_IO           : Internal error
      *****************************************************************************
      */
-    virtual ReturnCode rfalTransceiveBlockingTxRx(uint8_t *txBuf, uint16_t txBufLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *actLen, uint32_t flags, uint32_t fwt);
+    virtual ReturnCode rfalTransceiveBlockingTxRx(uint8_t *txBuf, uint16_t txBufLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *actLen, uint32_t flags, uint32_t fwt) = 0;
 
 
 
@@ -1358,7 +1379,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual bool rfalIsExtFieldOn(void);
+    virtual bool rfalIsExtFieldOn(void) = 0;
 
 
     /*!
@@ -1385,7 +1406,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalListenStart(uint32_t lmMask, const rfalLmConfPA *confA, const rfalLmConfPB *confB, const rfalLmConfPF *confF, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen);
+    virtual ReturnCode rfalListenStart(uint32_t lmMask, const rfalLmConfPA *confA, const rfalLmConfPB *confB, const rfalLmConfPF *confF, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen) = 0;
 
 
     /*!
@@ -1395,7 +1416,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalListenSleepStart(rfalLmState sleepSt, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen);
+    virtual ReturnCode rfalListenSleepStart(rfalLmState sleepSt, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen) = 0;
 
 
     /*!
@@ -1411,7 +1432,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalListenStop(void);
+    virtual ReturnCode rfalListenStop(void) = 0;
 
 
     /*!
@@ -1434,7 +1455,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual rfalLmState rfalListenGetState(bool *dataFlag, rfalBitRate *lastBR);
+    virtual rfalLmState rfalListenGetState(bool *dataFlag, rfalBitRate *lastBR) = 0;
 
 
     /*!
@@ -1452,7 +1473,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalListenSetState(rfalLmState newSt);
+    virtual ReturnCode rfalListenSetState(rfalLmState newSt) = 0;
 
 
     /*****************************************************************************
@@ -1476,7 +1497,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalWakeUpModeStart(const rfalWakeUpConfig *config);
+    virtual ReturnCode rfalWakeUpModeStart(const rfalWakeUpConfig *config) = 0;
 
 
     /*!
@@ -1492,7 +1513,7 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual bool rfalWakeUpModeHasWoke(void);
+    virtual bool rfalWakeUpModeHasWoke(void) = 0;
 
 
     /*!
@@ -1507,7 +1528,39 @@ class RfalRfClass {
      *
      *****************************************************************************
      */
-    virtual ReturnCode rfalWakeUpModeStop(void);
+    virtual ReturnCode rfalWakeUpModeStop(void) = 0;
+
+
+#ifdef ST25R3918_TRACE
+    /*!
+     *****************************************************************************
+     * \brief Record a timeline trace event
+     *
+     * Adds a begin, end or instant event to the transaction trace, with the
+     * same timestamps as the chip transactions around it
+     *
+     * \param[in]  phase : RFAL_TRACE_BEGIN, RFAL_TRACE_END or RFAL_TRACE_INSTANT
+     * \param[in]  id    : event, see RFAL_TRACE_EV_*
+     * \param[in]  arg   : event argument (state, return code)
+     *****************************************************************************
+     */
+    virtual void rfalTraceEvent(uint8_t phase, uint8_t id, uint8_t arg) = 0;
+
+
+    /*!
+     *****************************************************************************
+     * \brief Record a state change in the timeline trace
+     *
+     * When state differs from *traced, ends the span of the traced state and
+     * begins the one of the new state. State 0 (idle/not initialized) has no span
+     *
+     * \param[in]     id     : event, see RFAL_TRACE_EV_*
+     * \param[in,out] traced : state last recorded for this event
+     * \param[in]     state  : current state
+     *****************************************************************************
+     */
+    virtual void rfalTraceState(uint8_t id, uint8_t *traced, uint8_t state) = 0;
+#endif /* ST25R3918_TRACE */
 
 };
 
@@ -38,7 +38,7 @@
 #include "rfal_rfst25r3918.h"
 
 /*******************************************************************************/
-RfalRfST25R3918Class::RfalRfST25R3918Class(SPIClass *spi, int cs_pin, int int_pin, uint32_t spi_speed) : dev_spi(spi), cs_pin(cs_pin), int_pin(int_pin), spi_speed(spi_speed)
+RfalRfST25R3918Class::RfalRfST25R3918Class(ST25R3918I2C *i2c, int int_pin) : dev_i2c(i2c), int_pin(int_pin)
 {
   memset(&gRFAL, 0, sizeof(rfal));
   memset(&gRfalAnalogConfigMgmt, 0, sizeof(rfalAnalogConfigMgmt));
@@ -46,26 +46,16 @@ RfalRfST25R3918Class::RfalRfST25R3918Class(SPIClass *spi, int cs_pin, int int_pi
   gST25R3918NRT_64fcs = 0;
   memset((void *)&st25r3918interrupt, 0, sizeof(st25r3918Interrupt));
   timerStopwatchTick = 0;
-  i2c_enabled = false;
-  dev_i2c = NULL;
-  isr_pending = false;
-  bus_busy = false;
-  irq_handler = NULL;
-}
-
-RfalRfST25R3918Class::RfalRfST25R3918Class(TwoWire *i2c, int int_pin) : dev_i2c(i2c), int_pin(int_pin)
-{
-  memset(&gRFAL, 0, sizeof(rfal));
-  memset(&gRfalAnalogConfigMgmt, 0, sizeof(rfalAnalogConfigMgmt));
-  memset(&iso15693PhyConfig, 0, sizeof(iso15693PhyConfig_t));
-  gST25R3918NRT_64fcs = 0;
-  memset((void *)&st25r3918interrupt, 0, sizeof(st25r3918Interrupt));
-  timerStopwatchTick = 0;
-  i2c_enabled = true;
-  dev_spi = NULL;
   isr_pending = false;
   bus_busy = false;
   irq_handler = NULL;
+  memset(&gBusStats, 0, sizeof(st25r3918BusStats));
+  memset(&gAat, 0, sizeof(struct st25r3918AatCtx));
+  gAat.state = ST25R3918_AAT_ST_IDLE;
+#ifdef ST25R3918_TRACE
+  memset(&gTrace, 0, sizeof(st25r3918Trace));
+  gTraceTxRxState = RFAL_TXRX_STATE_IDLE;
+#endif
 }
 
 
@@ -73,12 +63,6 @@ ReturnCode RfalRfST25R3918Class::rfalInitialize(void)
 {
   ReturnCode err;
 
-  // Only configure SPI CS pin if not in I2C mode
-  if (!i2c_enabled) {
-    pinMode(cs_pin, OUTPUT);
-    digitalWrite(cs_pin, HIGH);
-  }
-
   // Configure interrupt pin if valid
   // Note: Using polling mode instead of hardware interrupts for better compatibility
   if (int_pin >= 0) {
@@ -136,7 +120,8 @@ ReturnCode RfalRfST25R3918Class::rfalInitialize(void)
   gRFAL.nfcvData.ignoreBits = 0;
 
   /* Initialize Wake-Up Mode */
-  gRFAL.wum.state = RFAL_WUM_STATE_NOT_INIT;
+  gRFAL.wum.state       = RFAL_WUM_STATE_NOT_INIT;
+  gRFAL.wum.measPending = false;
 
   /*******************************************************************************/
   /* Perform Automatic Calibration (if configured to do so).                     *
@@ -210,7 +195,6 @@ ReturnCode RfalRfST25R3918Class::rfalDeinitialize(void)
 
   gRFAL.state = RFAL_STATE_IDLE;
 
-  detachInterrupt(int_pin);
   irq_handler = NULL;
 
   return ERR_NONE;
@@ -249,6 +233,9 @@ void RfalRfST25R3918Class::rfalDisableObsvMode(void)
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::rfalSetMode(rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR)
 {
+  ReturnCode       ret;
+  st25r3918CmdList list;
+
   /* Check if RFAL is not initialized */
   if (gRFAL.state == RFAL_STATE_IDLE) {
     return ERR_WRONG_STATE;
@@ -259,194 +246,197 @@ ReturnCode RfalRfST25R3918Class::rfalSetMode(rfalMode mode, rfalBitRate txBR, rf
     return ERR_PARAM;
   }
 
+  /* Record the mode configuration, it is applied at once before the bit rate */
+  st25r3918CmdListInit(&list);
+
   switch (mode) {
     /*******************************************************************************/
     case RFAL_MODE_POLL_NFCA:
       /* Disable wake up mode, if set */
-      st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
+      st25r3918CmdListModify(&list, ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu, 0U);
 
       /* Enable ISO14443A mode */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_iso14443a);
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_iso14443a);
 
       /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_POLL_NFCA_T1T:
       /* Disable wake up mode, if set */
-      st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
+      st25r3918CmdListModify(&list, ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu, 0U);
 
       /* Enable Topaz mode */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_topaz);
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_topaz);
 
       /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_POLL_NFCB:
       /* Disable wake up mode, if set */
-      st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
+      st25r3918CmdListModify(&list, ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu, 0U);
 
       /* Enable ISO14443B mode */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_iso14443b);
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_iso14443b);
 
       /* Set the EGT, SOF, EOF and EOF */
-      st25r3918ChangeRegisterBits(ST25R3918_REG_ISO14443B_1,
-                                  (ST25R3918_REG_ISO14443B_1_egt_mask | ST25R3918_REG_ISO14443B_1_sof_mask | ST25R3918_REG_ISO14443B_1_eof),
-                                  ((0U << ST25R3918_REG_ISO14443B_1_egt_shift) | ST25R3918_REG_ISO14443B_1_sof_0_10etu | ST25R3918_REG_ISO14443B_1_sof_1_2etu | ST25R3918_REG_ISO14443B_1_eof_10etu));
+      st25r3918CmdListChangeBits(&list, ST25R3918_REG_ISO14443B_1,
+                                 (ST25R3918_REG_ISO14443B_1_egt_mask | ST25R3918_REG_ISO14443B_1_sof_mask | ST25R3918_REG_ISO14443B_1_eof),
+                                 ((0U << ST25R3918_REG_ISO14443B_1_egt_shift) | ST25R3918_REG_ISO14443B_1_sof_0_10etu | ST25R3918_REG_ISO14443B_1_sof_1_2etu | ST25R3918_REG_ISO14443B_1_eof_10etu));
 
       /* Set the minimum TR1, SOF, EOF and EOF12 */
-      st25r3918ChangeRegisterBits(ST25R3918_REG_ISO14443B_2,
-                                  (ST25R3918_REG_ISO14443B_2_tr1_mask | ST25R3918_REG_ISO14443B_2_no_sof | ST25R3918_REG_ISO14443B_2_no_eof),
-                                  (ST25R3918_REG_ISO14443B_2_tr1_80fs80fs));
+      st25r3918CmdListChangeBits(&list, ST25R3918_REG_ISO14443B_2,
+                                 (ST25R3918_REG_ISO14443B_2_tr1_mask | ST25R3918_REG_ISO14443B_2_no_sof | ST25R3918_REG_ISO14443B_2_no_eof),
+                                 (ST25R3918_REG_ISO14443B_2_tr1_80fs80fs));
 
       /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_POLL_B_PRIME:
       /* Disable wake up mode, if set */
-      st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
+      st25r3918CmdListModify(&list, ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu, 0U);
 
       /* Enable ISO14443B mode */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_iso14443b);
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_iso14443b);
 
       /* Set the EGT, SOF, EOF and EOF */
-      st25r3918ChangeRegisterBits(ST25R3918_REG_ISO14443B_1,
-                                  (ST25R3918_REG_ISO14443B_1_egt_mask | ST25R3918_REG_ISO14443B_1_sof_mask | ST25R3918_REG_ISO14443B_1_eof),
-                                  ((0U << ST25R3918_REG_ISO14443B_1_egt_shift) | ST25R3918_REG_ISO14443B_1_sof_0_10etu | ST25R3918_REG_ISO14443B_1_sof_1_2etu | ST25R3918_REG_ISO14443B_1_eof_10etu));
+      st25r3918CmdListChangeBits(&list, ST25R3918_REG_ISO14443B_1,
+                                 (ST25R3918_REG_ISO14443B_1_egt_mask | ST25R3918_REG_ISO14443B_1_sof_mask | ST25R3918_REG_ISO14443B_1_eof),
+                                 ((0U << ST25R3918_REG_ISO14443B_1_egt_shift) | ST25R3918_REG_ISO14443B_1_sof_0_10etu | ST25R3918_REG_ISO14443B_1_sof_1_2etu | ST25R3918_REG_ISO14443B_1_eof_10etu));
 
       /* Set the minimum TR1, EOF and EOF12 */
-      st25r3918ChangeRegisterBits(ST25R3918_REG_ISO14443B_2,
-                                  (ST25R3918_REG_ISO14443B_2_tr1_mask | ST25R3918_REG_ISO14443B_2_no_sof | ST25R3918_REG_ISO14443B_2_no_eof),
-                                  (ST25R3918_REG_ISO14443B_2_tr1_80fs80fs | ST25R3918_REG_ISO14443B_2_no_sof));
+      st25r3918CmdListChangeBits(&list, ST25R3918_REG_ISO14443B_2,
+                                 (ST25R3918_REG_ISO14443B_2_tr1_mask | ST25R3918_REG_ISO14443B_2_no_sof | ST25R3918_REG_ISO14443B_2_no_eof),
+                                 (ST25R3918_REG_ISO14443B_2_tr1_80fs80fs | ST25R3918_REG_ISO14443B_2_no_sof));
 
       /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_POLL_B_CTS:
       /* Disable wake up mode, if set */
-      st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
+      st25r3918CmdListModify(&list, ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu, 0U);
 
       /* Enable ISO14443B mode */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_iso14443b);
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_iso14443b);
 
       /* Set the EGT, SOF, EOF and EOF */
-      st25r3918ChangeRegisterBits(ST25R3918_REG_ISO14443B_1,
-                                  (ST25R3918_REG_ISO14443B_1_egt_mask | ST25R3918_REG_ISO14443B_1_sof_mask | ST25R3918_REG_ISO14443B_1_eof),
-                                  ((0U << ST25R3918_REG_ISO14443B_1_egt_shift) | ST25R3918_REG_ISO14443B_1_sof_0_10etu | ST25R3918_REG_ISO14443B_1_sof_1_2etu | ST25R3918_REG_ISO14443B_1_eof_10etu));
+      st25r3918CmdListChangeBits(&list, ST25R3918_REG_ISO14443B_1,
+                                 (ST25R3918_REG_ISO14443B_1_egt_mask | ST25R3918_REG_ISO14443B_1_sof_mask | ST25R3918_REG_ISO14443B_1_eof),
+                                 ((0U << ST25R3918_REG_ISO14443B_1_egt_shift) | ST25R3918_REG_ISO14443B_1_sof_0_10etu | ST25R3918_REG_ISO14443B_1_sof_1_2etu | ST25R3918_REG_ISO14443B_1_eof_10etu));
 
       /* Set the minimum TR1, clear SOF, EOF and EOF12 */
-      st25r3918ChangeRegisterBits(ST25R3918_REG_ISO14443B_2,
-                                  (ST25R3918_REG_ISO14443B_2_tr1_mask | ST25R3918_REG_ISO14443B_2_no_sof | ST25R3918_REG_ISO14443B_2_no_eof),
-                                  (ST25R3918_REG_ISO14443B_2_tr1_80fs80fs | ST25R3918_REG_ISO14443B_2_no_sof | ST25R3918_REG_ISO14443B_2_no_eof));
+      st25r3918CmdListChangeBits(&list, ST25R3918_REG_ISO14443B_2,
+                                 (ST25R3918_REG_ISO14443B_2_tr1_mask | ST25R3918_REG_ISO14443B_2_no_sof | ST25R3918_REG_ISO14443B_2_no_eof),
+                                 (ST25R3918_REG_ISO14443B_2_tr1_80fs80fs | ST25R3918_REG_ISO14443B_2_no_sof | ST25R3918_REG_ISO14443B_2_no_eof));
 
       /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_POLL_NFCF:
       /* Disable wake up mode, if set */
-      st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
+      st25r3918CmdListModify(&list, ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu, 0U);
 
       /* Enable FeliCa mode */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_felica);
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, ST25R3918_REG_MODE_om_felica);
 
       /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_POLL_NFCV:
     case RFAL_MODE_POLL_PICOPASS:
       /* Disable wake up mode, if set */
-      st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
+      st25r3918CmdListModify(&list, ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu, 0U);
 
       /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_POLL_ACTIVE_P2P:
       /* Set NFCIP1 active communication Initiator mode and Automatic Response RF Collision Avoidance to always after EOF */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, (ST25R3918_REG_MODE_targ_init | ST25R3918_REG_MODE_om_nfc | ST25R3918_REG_MODE_nfc_ar_eof));
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, (ST25R3918_REG_MODE_targ_init | ST25R3918_REG_MODE_om_nfc | ST25R3918_REG_MODE_nfc_ar_eof));
 
       /* External Field Detector enabled as Automatics on rfalInitialize() */
 
       /* Set NRT to start at end of TX (own) field */
-      st25r3918ChangeRegisterBits(ST25R3918_REG_TIMER_EMV_CONTROL, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_nfc, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_nfc_off);
+      st25r3918CmdListChangeBits(&list, ST25R3918_REG_TIMER_EMV_CONTROL, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_nfc, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_nfc_off);
 
       /* Set GPT to start after end of TX, as GPT is used in active communication mode to timeout the field switching off */
       /* The field is turned off 37.76us after the end of the transmission  Trfw                                          */
-      st25r3918SetStartGPTimer((uint16_t)rfalConv1fcTo8fc(RFAL_AP2P_FIELDOFF_TRFW), ST25R3918_REG_TIMER_EMV_CONTROL_gptc_etx_nfc);
+      st25r3918CmdListSetStartGPTimer(&list, (uint16_t)rfalConv1fcTo8fc(RFAL_AP2P_FIELDOFF_TRFW), ST25R3918_REG_TIMER_EMV_CONTROL_gptc_etx_nfc);
 
       /* Set PPon2 timer with the max time between our field Off and other peer field On : Tadt + (n x Trfw)    */
-      st25r3918WriteRegister(ST25R3918_REG_PPON2, (uint8_t)rfalConv1fcTo64fc(RFAL_AP2P_FIELDON_TADTTRFW));
+      st25r3918CmdListWrite(&list, ST25R3918_REG_PPON2, (uint8_t)rfalConv1fcTo64fc(RFAL_AP2P_FIELDON_TADTTRFW));
 
       /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_LISTEN_ACTIVE_P2P:
       /* Set NFCIP1 active communication Target mode and Automatic Response RF Collision Avoidance to always after EOF */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, (ST25R3918_REG_MODE_targ_targ | ST25R3918_REG_MODE_om_targ_nfcip | ST25R3918_REG_MODE_nfc_ar_eof));
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, (ST25R3918_REG_MODE_targ_targ | ST25R3918_REG_MODE_om_targ_nfcip | ST25R3918_REG_MODE_nfc_ar_eof));
 
       /* External Field Detector enabled as Automatics on rfalInitialize() */
 
       /* Set NRT to start at end of TX (own) field */
-      st25r3918ChangeRegisterBits(ST25R3918_REG_TIMER_EMV_CONTROL, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_nfc, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_nfc_off);
+      st25r3918CmdListChangeBits(&list, ST25R3918_REG_TIMER_EMV_CONTROL, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_nfc, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_nfc_off);
 
       /* Set GPT to start after end of TX, as GPT is used in active communication mode to timeout the field switching off */
       /* The field is turned off 37.76us after the end of the transmission  Trfw                                          */
-      st25r3918SetStartGPTimer((uint16_t)rfalConv1fcTo8fc(RFAL_AP2P_FIELDOFF_TRFW), ST25R3918_REG_TIMER_EMV_CONTROL_gptc_etx_nfc);
+      st25r3918CmdListSetStartGPTimer(&list, (uint16_t)rfalConv1fcTo8fc(RFAL_AP2P_FIELDOFF_TRFW), ST25R3918_REG_TIMER_EMV_CONTROL_gptc_etx_nfc);
 
       /* Set PPon2 timer with the max time between our field Off and other peer field On : Tadt + (n x Trfw)    */
-      st25r3918WriteRegister(ST25R3918_REG_PPON2, (uint8_t)rfalConv1fcTo64fc(RFAL_AP2P_FIELDON_TADTTRFW));
+      st25r3918CmdListWrite(&list, ST25R3918_REG_PPON2, (uint8_t)rfalConv1fcTo64fc(RFAL_AP2P_FIELDON_TADTTRFW));
 
       /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_LISTEN_NFCA:
       /* Disable wake up mode, if set */
-      st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
+      st25r3918CmdListModify(&list, ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu, 0U);
 
       /* Enable Passive Target NFC-A mode, disable any Collision Avoidance */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, (ST25R3918_REG_MODE_targ | ST25R3918_REG_MODE_om_targ_nfca | ST25R3918_REG_MODE_nfc_ar_off));
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, (ST25R3918_REG_MODE_targ | ST25R3918_REG_MODE_om_targ_nfca | ST25R3918_REG_MODE_nfc_ar_off));
 
       /* Set Analog configurations for this mode */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_LISTEN_NFCF:
       /* Disable wake up mode, if set */
-      st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
+      st25r3918CmdListModify(&list, ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu, 0U);
 
       /* Enable Passive Target NFC-F mode, disable any Collision Avoidance */
-      st25r3918WriteRegister(ST25R3918_REG_MODE, (ST25R3918_REG_MODE_targ | ST25R3918_REG_MODE_om_targ_nfcf | ST25R3918_REG_MODE_nfc_ar_off));
+      st25r3918CmdListWrite(&list, ST25R3918_REG_MODE, (ST25R3918_REG_MODE_targ | ST25R3918_REG_MODE_om_targ_nfcf | ST25R3918_REG_MODE_nfc_ar_off));
 
       /* Set Analog configurations for this mode */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCF | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
@@ -458,6 +448,8 @@ ReturnCode RfalRfST25R3918Class::rfalSetMode(rfalMode mode, rfalBitRate txBR, rf
       return ERR_NOT_IMPLEMENTED;
   }
 
+  EXIT_ON_ERR(ret, st25r3918CmdListExecute(&list));
+
   /* Set state as STATE_MODE_SET only if not initialized yet (PSL) */
   gRFAL.state = ((gRFAL.state < RFAL_STATE_MODE_SET) ? RFAL_STATE_MODE_SET : gRFAL.state);
   gRFAL.mode  = mode;
@@ -477,7 +469,8 @@ rfalMode RfalRfST25R3918Class::rfalGetMode(void)
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::rfalSetBitRate(rfalBitRate txBR, rfalBitRate rxBR)
 {
-  ReturnCode ret;
+  ReturnCode       ret;
+  st25r3918CmdList list;
 
   /* Check if RFAL is not initialized */
   if (gRFAL.state == RFAL_STATE_IDLE) {
@@ -495,14 +488,17 @@ ReturnCode RfalRfST25R3918Class::rfalSetBitRate(rfalBitRate txBR, rfalBitRate rx
   }
 
 
+  /* Record the Analog configurations, they are applied at once */
+  st25r3918CmdListInit(&list);
+
   switch (gRFAL.mode) {
     /*******************************************************************************/
     case RFAL_MODE_POLL_NFCA:
     case RFAL_MODE_POLL_NFCA_T1T:
       /* Set Analog configurations for this bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
@@ -510,17 +506,17 @@ ReturnCode RfalRfST25R3918Class::rfalSetBitRate(rfalBitRate txBR, rfalBitRate rx
     case RFAL_MODE_POLL_B_PRIME:
     case RFAL_MODE_POLL_B_CTS:
       /* Set Analog configurations for this bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_POLL_NFCF:
       /* Set Analog configurations for this bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCF | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
@@ -563,41 +559,41 @@ ReturnCode RfalRfST25R3918Class::rfalSetBitRate(rfalBitRate txBR, rfalBitRate rx
       }
 
       /* Set Analog configurations for this bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_POLL_ACTIVE_P2P:
       /* Set Analog configurations for this bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_POLL_COMMON), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_LISTEN_ACTIVE_P2P:
       /* Set Analog configurations for this bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_LISTEN_COMMON));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_LISTEN_COMMON), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_AP2P | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_LISTEN_NFCA:
       /* Set Analog configurations for this bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_LISTEN_COMMON));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_LISTEN_COMMON), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
     case RFAL_MODE_LISTEN_NFCF:
       /* Set Analog configurations for this bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_LISTEN_COMMON));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCF | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCF | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+      rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_LISTEN_COMMON), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCF | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+      rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_LISTEN | RFAL_ANALOG_CONFIG_TECH_NFCF | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
       break;
 
     /*******************************************************************************/
@@ -610,7 +606,7 @@ ReturnCode RfalRfST25R3918Class::rfalSetBitRate(rfalBitRate txBR, rfalBitRate rx
       return ERR_NOT_IMPLEMENTED;
   }
 
-  return ERR_NONE;
+  return st25r3918CmdListExecute(&list);
 }
 
 
@@ -705,7 +701,7 @@ uint32_t RfalRfST25R3918Class::rfalGetGT(void)
 bool RfalRfST25R3918Class::rfalIsGTExpired(void)
 {
   if (gRFAL.tmr.GT != RFAL_TIMING_NONE) {
-    if (!rfalTimerisExpired(gRFAL.tmr.GT)) {
+    if (!rfalTimerisExpiredUs(gRFAL.tmr.GT)) {
       return false;
     }
   }
@@ -715,7 +711,8 @@ bool RfalRfST25R3918Class::rfalIsGTExpired(void)
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::rfalFieldOnAndStartGT(void)
 {
-  ReturnCode ret;
+  ReturnCode       ret;
+  st25r3918CmdList list;
 
   /* Check if RFAL has been initialized (Oscillator should be running) and also
    * if a direct register access has been performed and left the Oscillator Off */
@@ -726,13 +723,15 @@ ReturnCode RfalRfST25R3918Class::rfalFieldOnAndStartGT(void)
   ret = ERR_NONE;
 
   /* Set Analog configurations for Field On event */
-  rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_FIELD_ON));
+  st25r3918CmdListInit(&list);
+  rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_FIELD_ON), &list);
 
   /*******************************************************************************/
   /* Perform collision avoidance and turn field On if not already On */
   if (!st25r3918IsTxEnabled() || !gRFAL.field) {
     /* Set TARFG: 0 (75us+0ms=75us), GT is fulfilled using a SW timer */
-    st25r3918WriteRegister(ST25R3918_REG_FIELD_ON_GT, 0U);
+    st25r3918CmdListWrite(&list, ST25R3918_REG_FIELD_ON_GT, 0U);
+    st25r3918CmdListExecute(&list);
 
     /* Use Thresholds set by AnalogConfig */
     ret = st25r3918PerformCollisionAvoidance(ST25R3918_CMD_INITIAL_RF_COLLISION, ST25R3918_THRESHOLD_DO_NOT_SET, ST25R3918_THRESHOLD_DO_NOT_SET, 0);
@@ -743,13 +742,15 @@ ReturnCode RfalRfST25R3918Class::rfalFieldOnAndStartGT(void)
     if (gRFAL.field) {
       st25r3918TxRxOn(); /* Enable Tx and Rx (Tx is already On)*/
     }
+  } else {
+    st25r3918CmdListExecute(&list);
   }
 
   /*******************************************************************************/
   /* Start GT timer in case the GT value is set */
   if ((gRFAL.timings.GT != RFAL_TIMING_NONE)) {
     /* Ensure that a SW timer doesn't have a lower value then the minimum  */
-    rfalTimerStart(gRFAL.tmr.GT, rfalConv1fcToMs(MAX((gRFAL.timings.GT), RFAL_ST25R3918_GT_MIN_1FC)));
+    rfalTimerStartUs(gRFAL.tmr.GT, rfalConv1fcToUs(MAX((gRFAL.timings.GT), RFAL_ST25R3918_GT_MIN_1FC)));
   }
 
   return ret;
@@ -869,8 +870,8 @@ ReturnCode RfalRfST25R3918Class::rfalStartTransceive(const rfalTransceiveContext
       /* Exchange receive buffer with internal buffer */
       gRFAL.nfcvData.origCtx = gRFAL.TxRx.ctx;
 
-      gRFAL.TxRx.ctx.rxBuf    = ((gRFAL.nfcvData.origCtx.rxBuf != NULL) ? gRFAL.nfcvData.codingBuffer : NULL);
-      gRFAL.TxRx.ctx.rxBufLen = (uint16_t)rfalConvBytesToBits(sizeof(gRFAL.nfcvData.codingBuffer));
+      gRFAL.TxRx.ctx.rxBuf    = ((gRFAL.nfcvData.origCtx.rxBuf != NULL) ? gRFAL.scratch.nfcvCoding : NULL);
+      gRFAL.TxRx.ctx.rxBufLen = (uint16_t)rfalConvBytesToBits(RFAL_NFCV_RX_CODED_MAX_LEN);
       gRFAL.TxRx.ctx.flags = (uint32_t)RFAL_TXRX_FLAGS_CRC_TX_MANUAL
                              | (uint32_t)RFAL_TXRX_FLAGS_CRC_RX_KEEP
                              | (uint32_t)RFAL_TXRX_FLAGS_NFCIP1_OFF
@@ -999,18 +1000,24 @@ ReturnCode RfalRfST25R3918Class::rfalTransceiveBlockingTxRx(uint8_t *txBuf, uint
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::rfalRunTransceiveWorker(void)
 {
+  ReturnCode ret;
+
+  ret = ERR_WRONG_STATE;
   if (gRFAL.state == RFAL_STATE_TXRX) {
+    rfalTraceStateChange(this, RFAL_TRACE_EV_TXRX_STATE, gTraceTxRxState, gRFAL.TxRx.state);
+
     /* Run Tx or Rx state machines */
     if (rfalIsTransceiveInTx()) {
       rfalTransceiveTx();
-      return rfalGetTransceiveStatus();
-    }
-    if (rfalIsTransceiveInRx()) {
+      ret = rfalGetTransceiveStatus();
+    } else if (rfalIsTransceiveInRx()) {
       rfalTransceiveRx();
-      return rfalGetTransceiveStatus();
+      ret = rfalGetTransceiveStatus();
     }
+
+    rfalTraceStateChange(this, RFAL_TRACE_EV_TXRX_STATE, gTraceTxRxState, gRFAL.TxRx.state);
   }
-  return ERR_WRONG_STATE;
+  return ret;
 }
 
 /*******************************************************************************/
@@ -1061,7 +1068,7 @@ ReturnCode RfalRfST25R3918Class::rfalGetTransceiveRSSI(uint16_t *rssi)
 void RfalRfST25R3918Class::rfalWorker(void)
 {
   /* Poll for new interrupts if IRQ pin is valid and high (interrupt pending) */
-  if ((int_pin >= 0) && (digitalRead(int_pin) == HIGH)) {
+  if (st25r3918IsIrqPinHigh()) {
     st25r3918CheckForReceivedInterrupts();
   }
 
@@ -1085,6 +1092,28 @@ void RfalRfST25R3918Class::rfalWorker(void)
 }
 
 
+/*******************************************************************************/
+void RfalRfST25R3918Class::rfalNfcvReadFifo(uint16_t length)
+{
+  uint16_t remaining = length;
+  uint16_t chunk;
+
+  /* No user rxBuf: nothing to decode into */
+  if (gRFAL.nfcvData.origCtx.rxBuf == NULL) {
+    st25r3918ReadFifo(NULL, remaining);
+    return;
+  }
+
+  /* Stage the coded bytes through the coding buffer and decode them right away */
+  while (remaining > 0U) {
+    chunk = (uint16_t)MIN(remaining, sizeof(gRFAL.scratch.nfcvCoding));
+    st25r3918ReadFifo(gRFAL.scratch.nfcvCoding, chunk);
+    iso15693VICCDecodeFeed(&gRFAL.nfcvData.dec, gRFAL.scratch.nfcvCoding, chunk);
+    remaining -= chunk;
+  }
+}
+
+
 /*******************************************************************************/
 void RfalRfST25R3918Class::rfalErrorHandling(void)
 {
@@ -1143,19 +1172,23 @@ void RfalRfST25R3918Class::rfalCleanupTransceive(void)
 /*******************************************************************************/
 void RfalRfST25R3918Class::rfalPrepareTransceive(void)
 {
-  uint32_t maskInterrupts;
-  uint8_t  reg;
+  uint32_t         maskInterrupts;
+  uint8_t          reg;
+  st25r3918CmdList list;
+
+  /* Record the chip preparation, it is applied with as few bus transactions as possible */
+  st25r3918CmdListInit(&list);
 
   /* If we are in RW or AP2P mode */
   if (!rfalIsModePassiveListen(gRFAL.mode)) {
     /* Reset receive logic with STOP command */
-    st25r3918ExecuteCommand(ST25R3918_CMD_STOP);
+    st25r3918CmdListCommand(&list, ST25R3918_CMD_STOP);
 
     /* Reset Rx Gain */
-    st25r3918ExecuteCommand(ST25R3918_CMD_RESET_RXGAIN);
+    st25r3918CmdListCommand(&list, ST25R3918_CMD_RESET_RXGAIN);
   } else {
     /* In Passive Listen Mode do not use STOP as it stops FDT timer */
-    st25r3918ExecuteCommand(ST25R3918_CMD_CLEAR_FIFO);
+    st25r3918CmdListCommand(&list, ST25R3918_CMD_CLEAR_FIFO);
   }
 
   /*******************************************************************************/
@@ -1165,7 +1198,7 @@ void RfalRfST25R3918Class::rfalPrepareTransceive(void)
     /* In Passive communications General Purpose Timer is used to measure FDT Poll */
     if (gRFAL.timings.FDTPoll != RFAL_TIMING_NONE) {
       /* Configure GPT to start at RX end */
-      st25r3918SetStartGPTimer((uint16_t)rfalConv1fcTo8fc(MIN(gRFAL.timings.FDTPoll, (gRFAL.timings.FDTPoll - RFAL_FDT_POLL_ADJUSTMENT))), ST25R3918_REG_TIMER_EMV_CONTROL_gptc_erx);
+      st25r3918CmdListSetStartGPTimer(&list, (uint16_t)rfalConv1fcTo8fc(MIN(gRFAL.timings.FDTPoll, (gRFAL.timings.FDTPoll - RFAL_FDT_POLL_ADJUSTMENT))), ST25R3918_REG_TIMER_EMV_CONTROL_gptc_erx);
     }
   }
 
@@ -1173,6 +1206,8 @@ void RfalRfST25R3918Class::rfalPrepareTransceive(void)
   /* Execute Pre Transceive Callback                                             */
   /*******************************************************************************/
   if (gRFAL.callbacks.preTxRx != NULL) {
+    /* Callback may access the chip: apply what has been recorded so far */
+    st25r3918CmdListExecute(&list);
     gRFAL.callbacks.preTxRx();
   }
   /*******************************************************************************/
@@ -1205,13 +1240,13 @@ void RfalRfST25R3918Class::rfalPrepareTransceive(void)
   }
 
   /* Apply current TxRx flags on ISO14443A and NFC 106kb/s Settings Register */
-  st25r3918ChangeRegisterBits(ST25R3918_REG_ISO14443A_NFC, (ST25R3918_REG_ISO14443A_NFC_no_tx_par | ST25R3918_REG_ISO14443A_NFC_no_rx_par | ST25R3918_REG_ISO14443A_NFC_nfc_f0), reg);
+  st25r3918CmdListChangeBits(&list, ST25R3918_REG_ISO14443A_NFC, (ST25R3918_REG_ISO14443A_NFC_no_tx_par | ST25R3918_REG_ISO14443A_NFC_no_rx_par | ST25R3918_REG_ISO14443A_NFC_nfc_f0), reg);
 
   /* Check if AGC is to be disabled */
   if ((gRFAL.TxRx.ctx.flags & (uint8_t)RFAL_TXRX_FLAGS_AGC_OFF) != 0U) {
-    st25r3918ClrRegisterBits(ST25R3918_REG_RX_CONF2, ST25R3918_REG_RX_CONF2_agc_en);
+    st25r3918CmdListModify(&list, ST25R3918_REG_RX_CONF2, ST25R3918_REG_RX_CONF2_agc_en, 0U);
   } else {
-    st25r3918SetRegisterBits(ST25R3918_REG_RX_CONF2, ST25R3918_REG_RX_CONF2_agc_en);
+    st25r3918CmdListModify(&list, ST25R3918_REG_RX_CONF2, 0U, ST25R3918_REG_RX_CONF2_agc_en);
   }
   /*******************************************************************************/
 
@@ -1219,13 +1254,16 @@ void RfalRfST25R3918Class::rfalPrepareTransceive(void)
   /* EMVCo NRT mode                                                              */
   /*******************************************************************************/
   if (gRFAL.conf.eHandling == RFAL_ERRORHANDLING_EMVCO) {
-    st25r3918SetRegisterBits(ST25R3918_REG_TIMER_EMV_CONTROL, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_emv);
+    st25r3918CmdListModify(&list, ST25R3918_REG_TIMER_EMV_CONTROL, 0U, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_emv);
     maskInterrupts |= ST25R3918_IRQ_MASK_RX_REST;
   } else {
-    st25r3918ClrRegisterBits(ST25R3918_REG_TIMER_EMV_CONTROL, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_emv);
+    st25r3918CmdListModify(&list, ST25R3918_REG_TIMER_EMV_CONTROL, ST25R3918_REG_TIMER_EMV_CONTROL_nrt_emv, 0U);
   }
   /*******************************************************************************/
 
+  /* Apply the recorded preparation */
+  st25r3918CmdListExecute(&list);
+
   /* In Passive Listen mode additionally enable External Field interrupts  */
   if (rfalIsModePassiveListen(gRFAL.mode)) {
     maskInterrupts |= (ST25R3918_IRQ_MASK_EOF | ST25R3918_IRQ_MASK_WU_F);        /* Enable external Field interrupts to detect Link Loss and SENF_REQ auto responses */
@@ -1320,7 +1358,7 @@ void RfalRfST25R3918Class::rfalTransceiveTx(void)
         /* Calculate the bytes needed to be Written into FIFO (a incomplete byte will be added as 1byte) */
         gRFAL.nfcvData.nfcvOffset = 0;
         ret = iso15693VCDCode(gRFAL.TxRx.ctx.txBuf, rfalConvBitsToBytes(gRFAL.TxRx.ctx.txBufLen), (((gRFAL.nfcvData.origCtx.flags & (uint32_t)RFAL_TXRX_FLAGS_CRC_TX_MANUAL) != 0U) ? false : true), (((gRFAL.nfcvData.origCtx.flags & (uint32_t)RFAL_TXRX_FLAGS_NFCV_FLAG_MANUAL) != 0U) ? false : true), (RFAL_MODE_POLL_PICOPASS == gRFAL.mode),
-                              &gRFAL.fifo.bytesTotal, &gRFAL.nfcvData.nfcvOffset, gRFAL.nfcvData.codingBuffer, MIN((uint16_t)ST25R3918_FIFO_DEPTH, (uint16_t)sizeof(gRFAL.nfcvData.codingBuffer)), &gRFAL.fifo.bytesWritten);
+                              &gRFAL.fifo.bytesTotal, &gRFAL.nfcvData.nfcvOffset, gRFAL.scratch.nfcvCoding, MIN((uint16_t)ST25R3918_FIFO_DEPTH, (uint16_t)sizeof(gRFAL.scratch.nfcvCoding)), &gRFAL.fifo.bytesWritten);
 
         if ((ret != ERR_NONE) && (ret != ERR_AGAIN)) {
           gRFAL.TxRx.status = ret;
@@ -1331,7 +1369,7 @@ void RfalRfST25R3918Class::rfalTransceiveTx(void)
         st25r3918SetNumTxBits((uint16_t)rfalConvBytesToBits(gRFAL.fifo.bytesTotal));
 
         /* Load FIFO with coded bytes */
-        st25r3918WriteFifo(gRFAL.nfcvData.codingBuffer, gRFAL.fifo.bytesWritten);
+        st25r3918WriteFifo(gRFAL.scratch.nfcvCoding, gRFAL.fifo.bytesWritten);
 
       }
       /*******************************************************************************/
@@ -1401,12 +1439,12 @@ void RfalRfST25R3918Class::rfalTransceiveTx(void)
 
         /* Load FIFO with the remaining length or maximum available (which fit on the coding buffer) */
         maxLen = (uint16_t)MIN((gRFAL.fifo.bytesTotal - gRFAL.fifo.bytesWritten), gRFAL.fifo.expWL);
-        maxLen = (uint16_t)MIN(maxLen, sizeof(gRFAL.nfcvData.codingBuffer));
+        maxLen = (uint16_t)MIN(maxLen, sizeof(gRFAL.scratch.nfcvCoding));
         tmp    = 0;
 
         /* Calculate the bytes needed to be Written into FIFO (a incomplete byte will be added as 1byte) */
         ret = iso15693VCDCode(gRFAL.TxRx.ctx.txBuf, rfalConvBitsToBytes(gRFAL.TxRx.ctx.txBufLen), (((gRFAL.nfcvData.origCtx.flags & (uint32_t)RFAL_TXRX_FLAGS_CRC_TX_MANUAL) != 0U) ? false : true), (((gRFAL.nfcvData.origCtx.flags & (uint32_t)RFAL_TXRX_FLAGS_NFCV_FLAG_MANUAL) != 0U) ? false : true), (RFAL_MODE_POLL_PICOPASS == gRFAL.mode),
-                              &gRFAL.fifo.bytesTotal, &gRFAL.nfcvData.nfcvOffset, gRFAL.nfcvData.codingBuffer, maxLen, &tmp);
+                              &gRFAL.fifo.bytesTotal, &gRFAL.nfcvData.nfcvOffset, gRFAL.scratch.nfcvCoding, maxLen, &tmp);
 
         if ((ret != ERR_NONE) && (ret != ERR_AGAIN)) {
           gRFAL.TxRx.status = ret;
@@ -1415,7 +1453,7 @@ void RfalRfST25R3918Class::rfalTransceiveTx(void)
         }
 
         /* Load FIFO with coded bytes */
-        st25r3918WriteFifo(gRFAL.nfcvData.codingBuffer, tmp);
+        st25r3918WriteFifo(gRFAL.scratch.nfcvCoding, tmp);
       }
       /*******************************************************************************/
       else {
@@ -1527,6 +1565,10 @@ void RfalRfST25R3918Class::rfalTransceiveRx(void)
         *gRFAL.TxRx.ctx.rxRcvdLen = 0;
       }
 
+      if ((RFAL_MODE_POLL_NFCV == gRFAL.mode) || (RFAL_MODE_POLL_PICOPASS == gRFAL.mode)) {
+        iso15693VICCDecodeStart(&gRFAL.nfcvData.dec, gRFAL.nfcvData.origCtx.rxBuf, rfalConvBitsToBytes(gRFAL.nfcvData.origCtx.rxBufLen), gRFAL.nfcvData.ignoreBits, (RFAL_MODE_POLL_PICOPASS == gRFAL.mode));
+      }
+
       gRFAL.TxRx.state = (rfalIsModeActiveComm(gRFAL.mode) ? RFAL_TXRX_STATE_RX_WAIT_EON : RFAL_TXRX_STATE_RX_WAIT_RXS);
       break;
 
@@ -1749,7 +1791,11 @@ void RfalRfST25R3918Class::rfalTransceiveRx(void)
 
       /*******************************************************************************/
       /* Retrieve remaining bytes from FIFO to rxBuf, and assign total length rcvd   */
-      st25r3918ReadFifo(&gRFAL.TxRx.ctx.rxBuf[gRFAL.fifo.bytesWritten], tmp);
+      if ((RFAL_MODE_POLL_NFCV == gRFAL.mode) || (RFAL_MODE_POLL_PICOPASS == gRFAL.mode)) {
+        rfalNfcvReadFifo(tmp);
+      } else {
+        st25r3918ReadFifo(&gRFAL.TxRx.ctx.rxBuf[gRFAL.fifo.bytesWritten], tmp);
+      }
       if (gRFAL.TxRx.ctx.rxRcvdLen != NULL) {
         (*gRFAL.TxRx.ctx.rxRcvdLen) = (uint16_t)rfalConvBytesToBits(gRFAL.fifo.bytesTotal);
         if (rfalFIFOStatusIsIncompleteByte()) {
@@ -1763,8 +1809,8 @@ void RfalRfST25R3918Class::rfalTransceiveRx(void)
         ReturnCode ret;
         uint16_t offset = 0; /* REMARK offset not currently used */
 
-        ret = iso15693VICCDecode(gRFAL.TxRx.ctx.rxBuf, gRFAL.fifo.bytesTotal,
-                                 gRFAL.nfcvData.origCtx.rxBuf, rfalConvBitsToBytes(gRFAL.nfcvData.origCtx.rxBufLen), &offset, gRFAL.nfcvData.origCtx.rxRcvdLen, gRFAL.nfcvData.ignoreBits, (RFAL_MODE_POLL_PICOPASS == gRFAL.mode));
+        /* The stream was decoded as it was read, only the last bit pairs and the CRC verdict are left */
+        ret = iso15693VICCDecodeFinish(&gRFAL.nfcvData.dec, &offset, gRFAL.nfcvData.origCtx.rxRcvdLen);
 
         if (((ERR_NONE == ret) || (ERR_CRC == ret))
             && (((uint32_t)RFAL_TXRX_FLAGS_CRC_RX_KEEP & gRFAL.nfcvData.origCtx.flags) == 0U)
@@ -1834,7 +1880,11 @@ void RfalRfST25R3918Class::rfalTransceiveRx(void)
 
       /*******************************************************************************/
       /* Retrieve incoming bytes from FIFO to rxBuf, and store already read amount   */
-      st25r3918ReadFifo(&gRFAL.TxRx.ctx.rxBuf[gRFAL.fifo.bytesWritten], aux);
+      if ((RFAL_MODE_POLL_NFCV == gRFAL.mode) || (RFAL_MODE_POLL_PICOPASS == gRFAL.mode)) {
+        rfalNfcvReadFifo(aux);
+      } else {
+        st25r3918ReadFifo(&gRFAL.TxRx.ctx.rxBuf[gRFAL.fifo.bytesWritten], aux);
+      }
       gRFAL.fifo.bytesWritten += aux;
 
       /*******************************************************************************/
@@ -1923,7 +1973,14 @@ void RfalRfST25R3918Class::rfalTransceiveRx(void)
 void RfalRfST25R3918Class::rfalFIFOStatusUpdate(void)
 {
   if (gRFAL.fifo.status[RFAL_FIFO_STATUS_REG2] == RFAL_FIFO_STATUS_INVALID) {
-    st25r3918ReadMultipleRegisters(ST25R3918_REG_FIFO_STATUS1, gRFAL.fifo.status, ST25R3918_FIFO_STATUS_LEN);
+    /* The status read with the latest IRQs is current unless the FIFO was accessed since: *
+     * after RXE it holds the final count, after FWL a count that is safe to read           */
+    if (st25r3918interrupt.fifoStatusValid) {
+      gRFAL.fifo.status[RFAL_FIFO_STATUS_REG1] = st25r3918interrupt.fifoStatus[RFAL_FIFO_STATUS_REG1];
+      gRFAL.fifo.status[RFAL_FIFO_STATUS_REG2] = st25r3918interrupt.fifoStatus[RFAL_FIFO_STATUS_REG2];
+    } else {
+      st25r3918ReadMultipleRegisters(ST25R3918_REG_FIFO_STATUS1, gRFAL.fifo.status, ST25R3918_FIFO_STATUS_LEN);
+    }
   }
 }
 
@@ -1936,7 +1993,7 @@ void RfalRfST25R3918Class::rfalFIFOStatusClear(void)
 
 
 /*******************************************************************************/
-uint8_t RfalRfST25R3918Class::rfalFIFOStatusGetNumBytes(void)
+uint16_t RfalRfST25R3918Class::rfalFIFOStatusGetNumBytes(void)
 {
   uint16_t result;
 
@@ -2003,18 +2060,19 @@ ReturnCode RfalRfST25R3918Class::rfalISO14443ATransceiveShortFrame(rfal14443ASho
   }
 
 
-  /* Disable CRC while receiving since ATQA has no CRC included */
-  st25r3918SetRegisterBits(ST25R3918_REG_AUX, ST25R3918_REG_AUX_no_crc_rx);
-
-
   /*******************************************************************************/
-  /* Wait for GT and FDT */
-  while (!rfalIsGTExpired())      { /* MISRA 15.6: mandatory brackets */ };
-  while (st25r3918IsGPTRunning()) { /* MISRA 15.6: mandatory brackets */ };
+  /* GT and FDT are not waited for: the caller retries on its next worker pass  */
+  if (!rfalIsGTExpired() || st25r3918IsGPTRunning()) {
+    return ERR_BUSY;
+  }
 
   gRFAL.tmr.GT = RFAL_TIMING_NONE;
 
 
+  /* Disable CRC while receiving since ATQA has no CRC included */
+  st25r3918SetRegisterBits(ST25R3918_REG_AUX, ST25R3918_REG_AUX_no_crc_rx);
+
+
   /*******************************************************************************/
   /* Prepare for Transceive, Receive only (bypass Tx states) */
   gRFAL.TxRx.ctx.flags     = ((uint32_t)RFAL_TXRX_FLAGS_CRC_TX_MANUAL | (uint32_t)RFAL_TXRX_FLAGS_CRC_RX_KEEP);
@@ -2091,6 +2149,7 @@ ReturnCode RfalRfST25R3918Class::rfalISO14443ATransceiveAnticollisionFrame(uint8
   rfalTransceiveContext ctx;
   uint8_t               collByte;
   uint8_t               collData;
+  st25r3918CmdList      list;
 
   /* Check if RFAL is properly initialized */
   if ((gRFAL.state < RFAL_STATE_MODE_SET) || (gRFAL.mode != RFAL_MODE_POLL_NFCA)) {
@@ -2104,15 +2163,17 @@ ReturnCode RfalRfST25R3918Class::rfalISO14443ATransceiveAnticollisionFrame(uint8
 
   /*******************************************************************************/
   /* Set specific Analog Config for Anticolission if needed */
-  rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_ANTICOL));
+  st25r3918CmdListInit(&list);
+  rfalSetAnalogConfigCmdList((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_ANTICOL), &list);
 
 
   /*******************************************************************************/
   /* Enable anti collision to recognise collision in first byte of SENS_REQ */
-  st25r3918SetRegisterBits(ST25R3918_REG_ISO14443A_NFC, ST25R3918_REG_ISO14443A_NFC_antcl);
+  st25r3918CmdListModify(&list, ST25R3918_REG_ISO14443A_NFC, 0U, ST25R3918_REG_ISO14443A_NFC_antcl);
 
   /* Disable CRC while receiving */
-  st25r3918SetRegisterBits(ST25R3918_REG_AUX, ST25R3918_REG_AUX_no_crc_rx);
+  st25r3918CmdListModify(&list, ST25R3918_REG_AUX, 0U, ST25R3918_REG_AUX_no_crc_rx);
+  st25r3918CmdListExecute(&list);
 
 
 
@@ -2175,16 +2236,19 @@ ReturnCode RfalRfST25R3918Class::rfalISO14443ATransceiveAnticollisionFrame(uint8
   /* Disable Collision interrupt */
   st25r3918DisableInterrupts((ST25R3918_IRQ_MASK_COL));
 
+  st25r3918CmdListInit(&list);
+
   /* Disable anti collision again */
-  st25r3918ClrRegisterBits(ST25R3918_REG_ISO14443A_NFC, ST25R3918_REG_ISO14443A_NFC_antcl);
+  st25r3918CmdListModify(&list, ST25R3918_REG_ISO14443A_NFC, ST25R3918_REG_ISO14443A_NFC_antcl, 0U);
 
   /* Re-enable CRC on Rx */
-  st25r3918ClrRegisterBits(ST25R3918_REG_AUX, ST25R3918_REG_AUX_no_crc_rx);
+  st25r3918CmdListModify(&list, ST25R3918_REG_AUX, ST25R3918_REG_AUX_no_crc_rx, 0U);
   /*******************************************************************************/
 
   /* Restore common Analog configurations for this mode */
-  rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-  rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+  rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+  rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
+  st25r3918CmdListExecute(&list);
 
   return ret;
 }
@@ -2195,6 +2259,7 @@ ReturnCode RfalRfST25R3918Class::rfalISO15693TransceiveAnticollisionFrame(uint8_
 {
   ReturnCode            ret;
   rfalTransceiveContext ctx;
+  st25r3918CmdList      list;
 
   /* Check if RFAL is properly initialized */
   if ((gRFAL.state < RFAL_STATE_MODE_SET) || (gRFAL.mode != RFAL_MODE_POLL_NFCV)) {
@@ -2231,13 +2296,16 @@ ReturnCode RfalRfST25R3918Class::rfalISO15693TransceiveAnticollisionFrame(uint8_
   /* Check if a Transmission error and received data is less then expected */
   if (((ret == ERR_RF_COLLISION) || (ret == ERR_CRC) || (ret == ERR_FRAMING)) && (rfalConvBitsToBytes(*ctx.rxRcvdLen) < RFAL_ISO15693_INV_RES_LEN)) {
     /* If INVENTORY_RES is shorter than expected, tag is still modulating *
-     * Ensure that response is complete before next frame                 */
-    delay((uint8_t)((RFAL_ISO15693_INV_RES_LEN - rfalConvBitsToBytes(*ctx.rxRcvdLen)) / ((RFAL_ISO15693_INV_RES_LEN / RFAL_ISO15693_INV_RES_DUR) + 1U)));
+     * Ensure that response is complete before next frame: reuse the GT   *
+     * timer so that the next transceive waits on it in TX_WAIT_GT        */
+    rfalTimerStartUs(gRFAL.tmr.GT, (((uint32_t)RFAL_ISO15693_INV_RES_LEN - rfalConvBitsToBytes(*ctx.rxRcvdLen)) * RFAL_US_IN_MS) / ((RFAL_ISO15693_INV_RES_LEN / RFAL_ISO15693_INV_RES_DUR) + 1U));
   }
 
   /* Restore common Analog configurations for this mode */
-  rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX));
-  rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX));
+  st25r3918CmdListInit(&list);
+  rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX), &list);
+  rfalSetAnalogConfigCmdList((rfalAnalogConfigId)(RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX), &list);
+  st25r3918CmdListExecute(&list);
 
   gRFAL.nfcvData.ignoreBits = 0;
   return ret;
@@ -2318,7 +2386,7 @@ ReturnCode RfalRfST25R3918Class::rfalFeliCaPoll(rfalFeliCaPollSlots slots, uint1
    *                       512 PICC process time + (n * 256 Time Slot duration)  */
   ret = rfalTransceiveBlockingTx(frame,
                                  (uint16_t)frameIdx,
-                                 (uint8_t *)gRFAL.nfcfData.pollResponses,
+                                 (uint8_t *)gRFAL.scratch.nfcfPollRes,
                                  RFAL_FELICA_POLL_RES_LEN,
                                  &actLen,
                                  (RFAL_TXRX_FLAGS_DEFAULT),
@@ -2344,7 +2412,7 @@ ReturnCode RfalRfST25R3918Class::rfalFeliCaPoll(rfalFeliCaPollSlots slots, uint1
           devDetected++;
 
           /* Overwrite the Transceive context for the next reception */
-          gRFAL.TxRx.ctx.rxBuf = (uint8_t *)gRFAL.nfcfData.pollResponses[devDetected];
+          gRFAL.TxRx.ctx.rxBuf = (uint8_t *)gRFAL.scratch.nfcfPollRes[devDetected];
         }
         /* If the reception was not OK, mark as collision */
         else {
@@ -2373,7 +2441,7 @@ ReturnCode RfalRfST25R3918Class::rfalFeliCaPoll(rfalFeliCaPollSlots slots, uint1
   /* Assign output parameters if requested                                       */
 
   if ((pollResList != NULL) && (pollResListSize > 0U) && (devDetected > 0U)) {
-    ST_MEMCPY(pollResList, gRFAL.nfcfData.pollResponses, (RFAL_FELICA_POLL_RES_LEN * (uint32_t)MIN(pollResListSize, devDetected)));
+    ST_MEMCPY(pollResList, gRFAL.scratch.nfcfPollRes, (RFAL_FELICA_POLL_RES_LEN * (uint32_t)MIN(pollResListSize, devDetected)));
   }
 
   if (devicesDetected != NULL) {
@@ -2446,10 +2514,6 @@ ReturnCode RfalRfST25R3918Class::rfalListenSetState(rfalLmState newSt)
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::rfalWakeUpModeStart(const rfalWakeUpConfig *config)
 {
-  uint8_t                aux;
-  uint8_t                reg;
-  uint32_t               irqs;
-
   /* The Wake-Up procedure is explained in detail in Application Note: AN4985 */
 
   if (config == NULL) {
@@ -2474,8 +2538,6 @@ ReturnCode RfalRfST25R3918Class::rfalWakeUpModeStart(const rfalWakeUpConfig *con
     return ERR_PARAM;
   }
 
-  irqs = ST25R3918_IRQ_MASK_NONE;
-
   /* Disable Tx, Rx, External Field Detector and set default ISO14443A mode */
   st25r3918TxRxOff();
   st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_en_fd_mask);
@@ -2488,17 +2550,36 @@ ReturnCode RfalRfST25R3918Class::rfalWakeUpModeStart(const rfalWakeUpConfig *con
   /*******************************************************************************/
   /* Check if AAT is enabled. If so disable en bit to give time for the Voltage  *
    * on the to varicaps to settle and have a stable reference measurement        */
+  /* The settle time is not waited here: rfalRunWakeUpModeWorker() completes  *
+   * the configuration once the timer expires                                 */
+  gRFAL.wum.measPending = false;
+  gRFAL.wum.state       = RFAL_WUM_STATE_INITIALIZING;
+  gRFAL.state           = RFAL_STATE_WUM;
+
   if (st25r3918CheckReg(ST25R3918_REG_IO_CONF2, ST25R3918_REG_IO_CONF2_aat_en, ST25R3918_REG_IO_CONF2_aat_en) && !gRFAL.wum.cfg.swTagDetect) {
     st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_en);
-    delay(RFAL_ST25R3918_AAT_SETTLE_OFF);
+    rfalTimerStartUs(gRFAL.wum.tmr, (RFAL_ST25R3918_AAT_SETTLE_OFF * RFAL_US_IN_MS));
   }
   /* In SW Tag detection remain in ready let the varicaps settle  */
   else if (gRFAL.wum.cfg.swTagDetect) {
-    delay(RFAL_ST25R3918_AAT_SETTLE_ON);
+    rfalTimerStartUs(gRFAL.wum.tmr, (RFAL_ST25R3918_AAT_SETTLE_ON * RFAL_US_IN_MS));
   } else {
-    /* MISRA 15.7 - Empty else */
+    /* No settling needed, enable Wake-Up mode right away */
+    rfalWakeUpModeEnable();
   }
 
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R3918Class::rfalWakeUpModeEnable(void)
+{
+  uint8_t                aux;
+  uint8_t                reg;
+  uint32_t               irqs;
+
+  irqs = ST25R3918_IRQ_MASK_NONE;
 
   /*******************************************************************************/
   /* Prepare Wake-Up Timer Control Register */
@@ -2610,9 +2691,6 @@ ReturnCode RfalRfST25R3918Class::rfalWakeUpModeStart(const rfalWakeUpConfig *con
 
 
   gRFAL.wum.state = RFAL_WUM_STATE_ENABLED;
-  gRFAL.state     = RFAL_STATE_WUM;
-
-  return ERR_NONE;
 }
 
 
@@ -2634,9 +2712,54 @@ void RfalRfST25R3918Class::rfalRunWakeUpModeWorker(void)
   }
 
   switch (gRFAL.wum.state) {
+    case RFAL_WUM_STATE_INITIALIZING:
+
+      /* Wait for the varicaps to settle before taking the reference measurements */
+      if (rfalTimerisExpiredUs(gRFAL.wum.tmr)) {
+        rfalWakeUpModeEnable();
+      }
+      break;
+
     case RFAL_WUM_STATE_ENABLED:
     case RFAL_WUM_STATE_ENABLED_WOKE:
 
+      /*******************************************************************************/
+      /* SW Tag Detection: once the varicaps have settled perform the measurement(s) */
+      if (gRFAL.wum.measPending) {
+        if (!rfalTimerisExpiredUs(gRFAL.wum.tmr)) {
+          break;
+        }
+        gRFAL.wum.measPending = false;
+
+        if (gRFAL.wum.cfg.indAmp.enabled) {
+          st25r3918MeasureAmplitude(&reg);
+          if ((reg >= (gRFAL.wum.cfg.indAmp.reference + gRFAL.wum.cfg.indAmp.delta)) || (reg <= (gRFAL.wum.cfg.indAmp.reference - gRFAL.wum.cfg.indAmp.delta))) {
+            gRFAL.wum.state = RFAL_WUM_STATE_ENABLED_WOKE;
+            break;
+          }
+        }
+
+        if (gRFAL.wum.cfg.indPha.enabled) {
+          st25r3918MeasurePhase(&reg);
+          if ((reg >= (gRFAL.wum.cfg.indPha.reference + gRFAL.wum.cfg.indPha.delta)) || (reg <= (gRFAL.wum.cfg.indPha.reference - gRFAL.wum.cfg.indPha.delta))) {
+            gRFAL.wum.state = RFAL_WUM_STATE_ENABLED_WOKE;
+            break;
+          }
+        }
+
+        if (gRFAL.wum.cfg.cap.enabled) {
+          st25r3918MeasureCapacitance(&reg);
+          if ((reg >= (gRFAL.wum.cfg.cap.reference + gRFAL.wum.cfg.cap.delta)) || (reg <= (gRFAL.wum.cfg.cap.reference - gRFAL.wum.cfg.cap.delta))) {
+            gRFAL.wum.state = RFAL_WUM_STATE_ENABLED_WOKE;
+            break;
+          }
+        }
+
+        /* Re-Enable low power Wake-Up mode for wto to trigger another measurement(s) */
+        st25r3918ChangeRegisterBits(ST25R3918_REG_OP_CONTROL, (ST25R3918_REG_OP_CONTROL_en | ST25R3918_REG_OP_CONTROL_wu), (ST25R3918_REG_OP_CONTROL_wu));
+        break;
+      }
+
       irqs = st25r3918GetInterrupt((ST25R3918_IRQ_MASK_WT | ST25R3918_IRQ_MASK_WAM | ST25R3918_IRQ_MASK_WPH | ST25R3918_IRQ_MASK_WCAP));
       if (irqs == ST25R3918_IRQ_MASK_NONE) {
         break;  /* No interrupt to process */
@@ -2662,37 +2785,10 @@ void RfalRfST25R3918Class::rfalRunWakeUpModeWorker(void)
       if ((irqs & ST25R3918_IRQ_MASK_WT) != 0U) {
         /*******************************************************************************/
         if (gRFAL.wum.cfg.swTagDetect) {
-          /* Enable Ready mode */
+          /* Enable Ready mode and measure on a later pass once the varicaps settled */
           st25r3918ChangeRegisterBits(ST25R3918_REG_OP_CONTROL, (ST25R3918_REG_OP_CONTROL_en | ST25R3918_REG_OP_CONTROL_wu), (ST25R3918_REG_OP_CONTROL_en));
-          delay(RFAL_ST25R3918_AAT_SETTLE_ON);
-
-
-          if (gRFAL.wum.cfg.indAmp.enabled) {
-            st25r3918MeasureAmplitude(&reg);
-            if ((reg >= (gRFAL.wum.cfg.indAmp.reference + gRFAL.wum.cfg.indAmp.delta)) || (reg <= (gRFAL.wum.cfg.indAmp.reference - gRFAL.wum.cfg.indAmp.delta))) {
-              gRFAL.wum.state = RFAL_WUM_STATE_ENABLED_WOKE;
-              break;
-            }
-          }
-
-          if (gRFAL.wum.cfg.indPha.enabled) {
-            st25r3918MeasurePhase(&reg);
-            if ((reg >= (gRFAL.wum.cfg.indPha.reference + gRFAL.wum.cfg.indPha.delta)) || (reg <= (gRFAL.wum.cfg.indPha.reference - gRFAL.wum.cfg.indPha.delta))) {
-              gRFAL.wum.state = RFAL_WUM_STATE_ENABLED_WOKE;
-              break;
-            }
-          }
-
-          if (gRFAL.wum.cfg.cap.enabled) {
-            st25r3918MeasureCapacitance(&reg);
-            if ((reg >= (gRFAL.wum.cfg.cap.reference + gRFAL.wum.cfg.cap.delta)) || (reg <= (gRFAL.wum.cfg.cap.reference - gRFAL.wum.cfg.cap.delta))) {
-              gRFAL.wum.state = RFAL_WUM_STATE_ENABLED_WOKE;
-              break;
-            }
-          }
-
-          /* Re-Enable low power Wake-Up mode for wto to trigger another measurement(s) */
-          st25r3918ChangeRegisterBits(ST25R3918_REG_OP_CONTROL, (ST25R3918_REG_OP_CONTROL_en | ST25R3918_REG_OP_CONTROL_wu), (ST25R3918_REG_OP_CONTROL_wu));
+          rfalTimerStartUs(gRFAL.wum.tmr, (RFAL_ST25R3918_AAT_SETTLE_ON * RFAL_US_IN_MS));
+          gRFAL.wum.measPending = true;
         }
       }
       break;
@@ -2711,7 +2807,8 @@ ReturnCode RfalRfST25R3918Class::rfalWakeUpModeStop(void)
     return ERR_WRONG_STATE;
   }
 
-  gRFAL.wum.state = RFAL_WUM_STATE_NOT_INIT;
+  gRFAL.wum.state       = RFAL_WUM_STATE_NOT_INIT;
+  gRFAL.wum.measPending = false;
 
   /* Disable Wake-Up Mode */
   st25r3918ClrRegisterBits(ST25R3918_REG_OP_CONTROL, ST25R3918_REG_OP_CONTROL_wu);
@@ -2820,6 +2917,33 @@ ReturnCode RfalRfST25R3918Class::rfalChipGetRFO(uint8_t *result)
 }
 
 
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::rfalChipSetAntennaTune(uint8_t serCap, uint8_t parCap)
+{
+  st25r3918CmdList list;
+
+  gRFAL.conf.antTuneSet = true;
+  gRFAL.conf.antTuneA   = serCap;
+  gRFAL.conf.antTuneB   = parCap;
+
+  st25r3918CmdListInit(&list);
+  st25r3918CmdListWrite(&list, ST25R3918_REG_ANT_TUNE_A, serCap);
+  st25r3918CmdListWrite(&list, ST25R3918_REG_ANT_TUNE_B, parCap);
+
+  return st25r3918CmdListExecute(&list);
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::rfalChipGetAntennaTune(uint8_t *serCap, uint8_t *parCap)
+{
+  ReturnCode ret;
+
+  EXIT_ON_ERR(ret, st25r3918ReadRegister(ST25R3918_REG_ANT_TUNE_A, serCap));
+  return st25r3918ReadRegister(ST25R3918_REG_ANT_TUNE_B, parCap);
+}
+
+
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::rfalChipMeasureAmplitude(uint8_t *result)
 {
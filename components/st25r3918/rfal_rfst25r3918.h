@@ -37,8 +37,7 @@
 ******************************************************************************
 */
 
-#include "SPI.h"
-#include "Wire.h"
+#include "st25r3918_i2c.h"
 #include "rfal_rf.h"
 #include "st_errno.h"
 #include "nfc_utils.h"
@@ -48,7 +47,6 @@
 #include "rfal_rfst25r3918_analogConfig.h"
 #include "rfal_rfst25r3918_iso15693_2.h"
 #include "st25r3918_aat.h"
-#include <functional>
 
 /*
  ******************************************************************************
@@ -56,6 +54,16 @@
  ******************************************************************************
  */
 
+#ifndef RFAL_FEATURE_NFCV_MAX_FRAME_LEN
+#define RFAL_FEATURE_NFCV_MAX_FRAME_LEN  255U      /*!< Largest NFC-V frame (payload) accepted on reception, may be reduced by a build flag */
+#endif
+
+/*! Largest coded NFC-V response: SOF/flags + payload + CRC/EOF, 2 coded bytes per byte */
+#define RFAL_NFCV_RX_CODED_MAX_LEN       ((2U + RFAL_FEATURE_NFCV_MAX_FRAME_LEN + 3U) * 2U)
+
+/*! NFC-V coding buffer length: the 257 the coding function needs, responses are decoded in chunks of this size */
+#define RFAL_NFCV_CODING_BUF_LEN         258U
+
 /*
 ******************************************************************************
 * GLOBAL TYPES
@@ -93,6 +101,8 @@ typedef struct {
 typedef struct {
   rfalWumState            state;       /*!< Current Wake-Up Mode state                           */
   rfalWakeUpConfig        cfg;         /*!< Current Wake-Up Mode context                         */
+  uint32_t                tmr;         /*!< Settle timer (us) for AAT/SW Tag Detection            */
+  bool                    measPending; /*!< SW Tag Detection measurement waiting on tmr            */
 } rfalWum;
 
 
@@ -106,7 +116,7 @@ typedef struct {
 
 /*! Struct that holds the software timers                               */
 typedef struct {
-  uint32_t                GT;          /*!< RFAL's GT timer           */
+  uint32_t                GT;          /*!< RFAL's GT timer (us)      */
   uint32_t                RXE;         /*!< Timer between RXS and RXE */
 } rfalTimers;
 
@@ -132,30 +142,37 @@ typedef struct {
   uint8_t                 obsvModeTx;  /*!< RFAL's config of the ST25R3918's observation mode while Tx */
   uint8_t                 obsvModeRx;  /*!< RFAL's config of the ST25R3918's observation mode while Rx */
   rfalEHandling           eHandling;   /*!< RFAL's error handling config/mode                          */
+  bool                    antTuneSet;  /*!< Antenna tuning set by the user, overrides the Analog Configs */
+  uint8_t                 antTuneA;    /*!< Antenna tuning serial capacitor (AAT_A) value              */
+  uint8_t                 antTuneB;    /*!< Antenna tuning parallel capacitor (AAT_B) value            */
 } rfalConfigs;
 
 
-/*! Struct that holds NFC-F data - Used only inside rfalFelicaPoll() (static to avoid adding it into stack) */
-typedef struct {
-  rfalFeliCaPollRes pollResponses[RFAL_FELICA_POLL_MAX_SLOTS];   /* FeliCa Poll response container for 16 slots */
-} rfalNfcfWorkingData;
-
-
-/*! Struct that holds NFC-V current context
+/*! Per-technology scratch memory
  *
- * This buffer has to be big enough for coping with maximum response size (hamming coded)
- *    - inventory requests responses: 14*2+2 bytes
- *    - read single block responses: (32+4)*2+2 bytes
- *    - read multiple block could be very long... -> not supported
- *    - current implementation expects it be written in one bulk into FIFO
+ * The NFC-V coding buffer and the FeliCa Poll response container are never needed at
+ * the same time: each one is only touched while gRFAL.mode is set to its technology
+ * (NFC-V/PicoPass transceive, rfalFeliCaPoll() in NFC-F mode). They therefore share
+ * one area sized by the largest enabled member.
+ *
+ * The NFC-V coding buffer holds the coded request and stages the coded response:
  *    - needs to be above FIFO water level of ST25R3918 (200)
  *    - the coding function needs to be able to
- *      put more than FIFO water level bytes into it (n*64+1)>200                                                          */
+ *      put more than FIFO water level bytes into it (n*64+1)>200
+ *    - responses are decoded chunk by chunk while the FIFO is drained (see #iso15693VICCDecodeFeed),
+ *      so their length is not limited by it but by RFAL_FEATURE_NFCV_MAX_FRAME_LEN                                      */
+typedef union { /*  PRQA S 0750 # MISRA 19.2 - Members of the union will not be used concurrently, only one mode at a time */
+  uint8_t                 nfcvCoding[RFAL_NFCV_CODING_BUF_LEN];               /*!< NFC-V coding buffer (RFAL_MODE_POLL_NFCV / PICOPASS) */
+  rfalFeliCaPollRes       nfcfPollRes[RFAL_FELICA_POLL_MAX_SLOTS];            /*!< FeliCa Poll response container for 16 slots (RFAL_MODE_POLL_NFCF) */
+} rfalScratch;
+
+
+/*! Struct that holds NFC-V current context                                                                          */
 typedef struct {
-  uint8_t                 codingBuffer[((2 + 255 + 3) * 2)]; /*!< Coding buffer,   length MUST be above 257: [257; ...]    */
   uint16_t                nfcvOffset;        /*!< Offset needed for ISO15693 coding function                             */
   rfalTransceiveContext   origCtx;           /*!< context provided by user                                               */
   uint16_t                ignoreBits;        /*!< Number of bits at the beginning of a frame to be ignored when decoding */
+  iso15693VICCDecoder     dec;               /*!< Decoder of the response being received                                 */
 } rfalNfcvWorkingData;
 
 
@@ -175,8 +192,8 @@ typedef struct {
   rfalCallbacks           callbacks; /*!< RFAL's callbacks                              */
 
   rfalWum                 wum;       /*!< RFAL's Wake-up mode management                */
-  rfalNfcfWorkingData     nfcfData;  /*!< RFAL's working data when supporting NFC-F     */
   rfalNfcvWorkingData     nfcvData;  /*!< RFAL's working data when performing NFC-V     */
+  rfalScratch             scratch;   /*!< Scratch memory owned by the current mode      */
 } rfal;
 
 
@@ -211,22 +228,6 @@ typedef struct {
   bool    ready;                  /*!< Indicate if Look Up Table is complete and ready for use */
 } rfalAnalogConfigMgmt;
 
-template <typename T>
-struct Callback;
-
-template <typename Ret, typename... Params>
-struct Callback<Ret(Params...)> {
-  template <typename... Args>
-  static Ret callback(Args... args)
-  {
-    return func(args...);
-  }
-  static std::function<Ret(Params...)> func;
-};
-
-template <typename Ret, typename... Params>
-std::function<Ret(Params...)> Callback<Ret(Params...)>::func;
-
 typedef void (*ST25R3918IrqHandler)(void);
 
 /*
@@ -358,6 +359,8 @@ typedef void (*ST25R3918IrqHandler)(void);
 
 #define rfalTimerStart( timer, time_ms )         (timer) = timerCalculateTimer((uint16_t)(time_ms))                /*!< Configures and starts the RTOX timer                                 */
 #define rfalTimerisExpired( timer )              timerIsExpired( timer )                                   /*!< Checks if timer has expired                                          */
+#define rfalTimerStartUs( timer, time_us )       (timer) = timerCalculateTimerUs((uint32_t)(time_us))              /*!< Configures and starts a microsecond timer                            */
+#define rfalTimerisExpiredUs( timer )            timerIsExpiredUs( timer )                                 /*!< Checks if a microsecond timer has expired                            */
 
 #define rfalST25R3918ObsModeDisable()            st25r3918WriteTestRegister(0x01U, (0x40U))                        /*!< Disable ST25R3918 Observation mode                                   */
 #define rfalST25R3918ObsModeTx()                 st25r3918WriteTestRegister(0x01U, (0x40U|gRFAL.conf.obsvModeTx))  /*!< Enable Tx Observation mode                                           */
@@ -385,8 +388,7 @@ class RfalRfST25R3918Class : public RfalRfClass {
     ******************************************************************************
     */
 
-    RfalRfST25R3918Class(SPIClass *spi, int cs_pin, int int_pin, uint32_t spi_speed = 5000000);
-    RfalRfST25R3918Class(TwoWire *i2c, int int_pin);
+    RfalRfST25R3918Class(ST25R3918I2C *i2c, int int_pin);
     ReturnCode rfalInitialize(void);
     ReturnCode rfalCalibrate(void);
     ReturnCode rfalAdjustRegulators(uint16_t *result);
@@ -723,6 +725,40 @@ class RfalRfST25R3918Class : public RfalRfClass {
     ReturnCode rfalChipGetRFO(uint8_t *result);
 
 
+    /*!
+     *****************************************************************************
+     * \brief  Set Antenna Tuning
+     *
+     * Sets the antenna tuning capacitors (AAT_A serial, AAT_B parallel) and
+     * keeps them: these values take precedence over the ANT_TUNE settings of
+     * the Analog Configuration table on every subsequent mode/bit rate change
+     *
+     * \param[in] serCap : AAT_A (serial capacitor) DAC value
+     * \param[in] parCap : AAT_B (parallel capacitor) DAC value
+     *
+     * \return  ERR_IO           : Internal error
+     * \return  ERR_NONE         : No error
+     *****************************************************************************
+     */
+    ReturnCode rfalChipSetAntennaTune(uint8_t serCap, uint8_t parCap);
+
+
+    /*!
+     *****************************************************************************
+     * \brief  Get Antenna Tuning
+     *
+     * Gets the antenna tuning capacitor values currently set on the chip
+     *
+     * \param[out] serCap : AAT_A (serial capacitor) DAC value
+     * \param[out] parCap : AAT_B (parallel capacitor) DAC value
+     *
+     * \return  ERR_IO           : Internal error
+     * \return  ERR_NONE         : No error
+     *****************************************************************************
+     */
+    ReturnCode rfalChipGetAntennaTune(uint8_t *serCap, uint8_t *parCap);
+
+
     /*!
      *****************************************************************************
      * \brief  Measure Amplitude
@@ -923,6 +959,57 @@ class RfalRfST25R3918Class : public RfalRfClass {
                                   bool picopassMode);
 
 
+    /*!
+     *****************************************************************************
+     *  \brief  Start decoding an ISO15693 VICC response
+     *
+     *  Streaming form of #iso15693VICCDecode: the coded stream is handed over with
+     *  #iso15693VICCDecodeFeed in chunks of any size as it is read from the FIFO,
+     *  so only the chunk being read has to be buffered. The CRC is updated as the
+     *  bytes are decoded.
+     *
+     *  \param[out] dec : decoder state
+     *  \param[out] outBuf : buffer where received data shall be written to
+     *  \param[in] outBufLen : length of output buffer
+     *  \param[in] ignoreBits : number of bits in the beginning where collisions will be ignored
+     *  \param[in] picopassMode : if set to true, the decoding will be according to Picopass
+     *****************************************************************************
+     */
+    void iso15693VICCDecodeStart(iso15693VICCDecoder *dec, uint8_t *outBuf, uint16_t outBufLen,
+                                 uint16_t ignoreBits, bool picopassMode);
+
+
+    /*!
+     *****************************************************************************
+     *  \brief  Decode the next chunk of an ISO15693 VICC response
+     *
+     *  \param[in,out] dec : decoder state, see #iso15693VICCDecodeStart
+     *  \param[in] inBuf : next bytes of the hamming coded stream
+     *  \param[in] inBufLen : number of bytes in inBuf
+     *****************************************************************************
+     */
+    void iso15693VICCDecodeFeed(iso15693VICCDecoder *dec, const uint8_t *inBuf, uint16_t inBufLen);
+
+
+    /*!
+     *****************************************************************************
+     *  \brief  Complete the decode of an ISO15693 VICC response
+     *
+     *  To be called once the whole frame was fed. Same results as #iso15693VICCDecode
+     *
+     *  \param[in,out] dec : decoder state, see #iso15693VICCDecodeStart
+     *  \param[out] outBufPos : the number of decoded bytes
+     *  \param[out] bitsBeforeCol : number of decoded bits, the collision position on ERR_RF_COLLISION
+     *
+     *  \return ERR_FRAMING : no valid SOF
+     *  \return ERR_RF_COLLISION : collision occurred, data incorrect
+     *  \return ERR_CRC : CRC error, data incorrect
+     *  \return ERR_NONE : No error.
+     *****************************************************************************
+     */
+    ReturnCode iso15693VICCDecodeFinish(iso15693VICCDecoder *dec, uint16_t *outBufPos, uint16_t *bitsBeforeCol);
+
+
     /*
     ******************************************************************************
     * RFAL ST25R3918 FUNCTION PROTOTYPES
@@ -1184,6 +1271,24 @@ class RfalRfST25R3918Class : public RfalRfClass {
      */
     ReturnCode st25r3918SetStartGPTimer(uint16_t gpt_8fcs, uint8_t trigger_source);
 
+    /*!
+     *****************************************************************************
+     *  \brief  Set and Start GPT on a command list
+     *
+     *  Same as st25r3918SetStartGPTimer() but recorded on the given command
+     *  list: GPT1, GPT2 and Timer and EMV Control are written in one burst
+     *
+     *  \param [in,out] list : command list to record on
+     *  \param [in] gpt_8fcs : general purpose timer timeout in steps of 8/fc (590ns)
+     *  \param [in] trigger_source : no trigger, start of Rx, end of Rx, end of Tx in NFC mode
+     *
+     *  \return ERR_PARAM : Invalid parameter
+     *  \return ERR_NONE  : No error
+     *
+     *****************************************************************************
+     */
+    ReturnCode st25r3918CmdListSetStartGPTimer(st25r3918CmdList *list, uint16_t gpt_8fcs, uint8_t trigger_source);
+
     /*!
      *****************************************************************************
      *  \brief  Sets the number Tx Bits
@@ -1424,6 +1529,7 @@ class RfalRfST25R3918Class : public RfalRfClass {
      *  \brief  Writes values to ST25R3918 FIFO
      *
      *  This function needs to be called in order to write to the ST25R3918 FIFO.
+     *  Longer writes are split in FIFO loads of ST25R3918_I2C_TX_BURST_LEN bytes.
      *
      *  \param[in]  values: pointer to a buffer containing the values to be written
      *                      to the FIFO.
@@ -1431,7 +1537,7 @@ class RfalRfST25R3918Class : public RfalRfClass {
      *
      *  \return ERR_NONE  : Operation successful
      *  \return ERR_PARAM : Invalid parameter
-     *  \return ERR_SEND  : Transmission error or acknowledge not received
+     *  \return ERR_IO    : Transmission error or acknowledge not received
      *****************************************************************************
      */
     ReturnCode st25r3918WriteFifo(const uint8_t *values, uint16_t length);
@@ -1441,9 +1547,10 @@ class RfalRfST25R3918Class : public RfalRfClass {
      *  \brief  Read values from ST25R3918 FIFO
      *
      *  This function needs to be called in order to read from ST25R3918 FIFO.
+     *  Longer reads are split in FIFO reads of ST25R3918_I2C_RX_BURST_LEN bytes.
      *
      *  \param[out]  buf: pointer to a buffer where the FIFO content shall be
-     *                       written to.
+     *                       written to, NULL to discard the bytes read.
      *  \param[in]  length: Number of bytes to read.
      *
      *  \note: This function doesn't check whether \a length is really the
@@ -1451,7 +1558,7 @@ class RfalRfST25R3918Class : public RfalRfClass {
      *
      *  \return ERR_NONE  : Operation successful
      *  \return ERR_PARAM : Invalid parameter
-     *  \return ERR_SEND  : Transmission error or acknowledge not received
+     *  \return ERR_IO    : Transmission error or fewer bytes received
      *****************************************************************************
      */
     ReturnCode st25r3918ReadFifo(uint8_t *buf, uint16_t length);
@@ -1691,6 +1798,181 @@ class RfalRfST25R3918Class : public RfalRfClass {
      */
     bool st25r3918IsRegValid(uint8_t reg);
 
+    /*!
+     *****************************************************************************
+     *  \brief  Initializes a register command list
+     *
+     *  Empties the given list so that register operations can be recorded
+     *
+     *  \param[out] list: command list to be initialized
+     *****************************************************************************
+     */
+    void st25r3918CmdListInit(st25r3918CmdList *list);
+
+    /*!
+     *****************************************************************************
+     *  \brief  Records a register write on a command list
+     *
+     *  The value is always written, no read is required. A later operation on
+     *  the same register (before the next barrier) is merged into this one.
+     *  If the list is full it is executed first.
+     *
+     *  \param[in,out] list: command list
+     *  \param[in]     reg: Address of the register to write
+     *  \param[in]     val: Value to be written
+     *
+     *  \return ERR_NONE  : Operation successful
+     *  \return ERR_PARAM : Invalid parameter
+     *****************************************************************************
+     */
+    ReturnCode st25r3918CmdListWrite(st25r3918CmdList *list, uint8_t reg, uint8_t val);
+
+    /*!
+     *****************************************************************************
+     *  \brief  Records a register modify on a command list
+     *
+     *  Same semantic as st25r3918ModifyRegister(): the register is read
+     *  (batched with the other reads of the list) and only written if changed
+     *
+     *  \param[in,out] list: command list
+     *  \param[in]     reg: Address of the register to modify
+     *  \param[in]     clr_mask: bitmask of bits to be cleared to 0
+     *  \param[in]     set_mask: bitmask of bits to be set to 1
+     *
+     *  \return ERR_NONE  : Operation successful
+     *  \return ERR_PARAM : Invalid parameter
+     *****************************************************************************
+     */
+    ReturnCode st25r3918CmdListModify(st25r3918CmdList *list, uint8_t reg, uint8_t clr_mask, uint8_t set_mask);
+
+    /*!
+     *****************************************************************************
+     *  \brief  Records a register change bits on a command list
+     *
+     *  Same semantic as st25r3918ChangeRegisterBits()
+     *
+     *  \param[in,out] list: command list
+     *  \param[in]     reg: Address of the register to change
+     *  \param[in]     valueMask: bitmask of bits to be changed
+     *  \param[in]     value: the bits to be written on the enabled valueMask bits
+     *
+     *  \return ERR_NONE  : Operation successful
+     *  \return ERR_PARAM : Invalid parameter
+     *****************************************************************************
+     */
+    ReturnCode st25r3918CmdListChangeBits(st25r3918CmdList *list, uint8_t reg, uint8_t valueMask, uint8_t value);
+
+    /*!
+     *****************************************************************************
+     *  \brief  Records a Test register change bits on a command list
+     *
+     *  Same semantic as st25r3918ChangeTestRegisterBits(). Test register
+     *  accesses are ordering barriers and are never merged.
+     *
+     *  \param[in,out] list: command list
+     *  \param[in]     reg: Address of the Test register to change
+     *  \param[in]     valueMask: bitmask of bits to be changed
+     *  \param[in]     value: the bits to be written on the enabled valueMask bits
+     *
+     *  \return ERR_NONE  : Operation successful
+     *****************************************************************************
+     */
+    ReturnCode st25r3918CmdListChangeTestBits(st25r3918CmdList *list, uint8_t reg, uint8_t valueMask, uint8_t value);
+
+    /*!
+     *****************************************************************************
+     *  \brief  Records a direct command on a command list
+     *
+     *  Direct commands are ordering barriers: all register operations recorded
+     *  before are executed before the command, all recorded after are executed
+     *  after it.
+     *
+     *  \param[in,out] list: command list
+     *  \param[in]     cmd: direct command to be executed
+     *
+     *  \return ERR_NONE  : Operation successful
+     *****************************************************************************
+     */
+    ReturnCode st25r3918CmdListCommand(st25r3918CmdList *list, uint8_t cmd);
+
+    /*!
+     *****************************************************************************
+     *  \brief  Executes a register command list
+     *
+     *  Executes the recorded operations with the fewest bus transactions:
+     *  operations on the same register are merged, the reads needed by the
+     *  modifies are done in auto-increment bursts, unchanged registers are not
+     *  written and writes to consecutive registers are done in one
+     *  auto-increment burst. The list is empty afterwards.
+     *
+     *  \param[in,out] list: command list to be executed
+     *
+     *  \return ERR_NONE  : Operation successful
+     *  \return ERR_SEND  : Transmission error or acknowledge not received
+     *****************************************************************************
+     */
+    ReturnCode st25r3918CmdListExecute(st25r3918CmdList *list);
+
+
+    /*
+     *****************************************************************************
+     *  \brief  Get I2C transport counters
+     *
+     *  A transaction the chip doesn't acknowledge, or a failed read of a
+     *  register that doesn't change on read, is repeated up to
+     *  ST25R3918_I2C_RETRIES times before the accessor returns ERR_IO. A failed
+     *  FIFO or IRQ register read is not repeated (bytes may already be lost)
+     *  and returns ERR_IO at once. The counters let the caller tell a broken
+     *  bus from a missing tag and escalate its recovery
+     *
+     *  \return pointer to the counters of this instance
+     *****************************************************************************
+     */
+    const st25r3918BusStats *st25r3918GetBusStats(void);
+
+
+#ifdef ST25R3918_TRACE
+    /*
+     *****************************************************************************
+     *  \brief  Read I2C trace
+     *
+     *  Moves the oldest complete trace records that fit into buf out of the
+     *  trace ring. Records are never split, call again until it returns 0
+     *  to drain the whole trace
+     *
+     *  \param[out] buf: destination of the records
+     *  \param[in]  len: size of buf
+     *
+     *  \return number of bytes copied into buf
+     *****************************************************************************
+     */
+    uint16_t st25r3918TraceRead(uint8_t *buf, uint16_t len);
+
+
+    /*
+     *****************************************************************************
+     *  \brief  Get I2C trace dropped records
+     *
+     *  \return number of records lost since the trace was last cleared
+     *****************************************************************************
+     */
+    uint32_t st25r3918TraceDropped(void);
+
+
+    /*
+     *****************************************************************************
+     *  \brief  Clear I2C trace
+     *
+     *  Discards all trace records and resets the dropped records counter
+     *****************************************************************************
+     */
+    void st25r3918TraceClear(void);
+
+
+    virtual void rfalTraceEvent(uint8_t phase, uint8_t id, uint8_t arg);
+    virtual void rfalTraceState(uint8_t id, uint8_t *traced, uint8_t state);
+#endif /* ST25R3918_TRACE */
+
 
     /*
     ******************************************************************************
@@ -1872,15 +2154,35 @@ class RfalRfST25R3918Class : public RfalRfClass {
 
     /*!
      *****************************************************************************
-     * \brief  Performs a Delay
+     * \brief  Calculate Timer (microseconds)
+     *
+     * Same as timerCalculateTimer() but with microsecond resolution, used for
+     * the guard times and settle times that state machines check on their
+     * next worker pass instead of blocking
+     *
+     * \see timerIsExpiredUs
+     *
+     * \param[in]  time : time/duration in Microseconds for the timer
+     *
+     * \return u32 : The new timer calculated based on the given time
+     *****************************************************************************
+     */
+    uint32_t timerCalculateTimerUs(uint32_t time);
+
+
+    /*!
+     *****************************************************************************
+     * \brief  Checks if a microsecond Timer is Expired
      *
-     * This method performs a delay for the given amount of time in Milliseconds
+     * \see timerCalculateTimerUs
      *
-     * \param[in]  time : time/duration in Milliseconds of the delay
+     * \param[in]  timer : the timer to check
      *
+     * \return true  : timer has already expired
+     * \return false : timer is still running
      *****************************************************************************
      */
-    void timerDelay(uint16_t time);
+    bool timerIsExpiredUs(uint32_t timer);
 
 
     /*!
@@ -1925,14 +2227,72 @@ class RfalRfST25R3918Class : public RfalRfClass {
      *                             no further information is returned, only registers
      *                             ST25R3918 (AAT_A,B) will be adapted.
      *
-     *  \return ERR_IO    : Error during communication.
-     *  \return ERR_PARAM : Invalid input parameters
-     *  \return ERR_NONE  : No error.
+     *  This call is blocking, st25r3918AatTuneStart() and st25r3918AatGetStatus()
+     *  wait for the caps to settle on later calls instead.
+     *
+     *  \return ERR_IO      : Error during communication.
+     *  \return ERR_PARAM   : Invalid input parameters
+     *  \return ERR_OVERRUN : Measure limit reached, best caps found so far set
+     *  \return ERR_NONE    : No error.
      *
      *****************************************************************************
      */
     ReturnCode st25r3918AatTune(const struct st25r3918AatTuneParams *tuningParams, struct st25r3918AatTuneResult *tuningStatus);
 
+    /*!
+     *****************************************************************************
+     *  \brief  Start antenna tuning
+     *
+     *  Starts the tuning of st25r3918AatTune() without waiting: every
+     *  measurement first lets the caps settle, st25r3918AatGetStatus() takes
+     *  it once the settle time has passed and sets the next caps.
+     *
+     *  \param[in] tuningParams : Input parameters for the tuning algorithm. If NULL
+     *                            default values starting from the current caps are used.
+     *
+     *  \return ERR_PARAM : Invalid input parameters
+     *  \return ERR_NONE  : Tuning started, poll st25r3918AatGetStatus()
+     *
+     *****************************************************************************
+     */
+    ReturnCode st25r3918AatTuneStart(const struct st25r3918AatTuneParams *tuningParams);
+
+    /*!
+     *****************************************************************************
+     *  \brief  Start a single antenna measurement
+     *
+     *  Sets the AAT_A and AAT_B registers, st25r3918AatGetStatus() measures
+     *  amplitude and phase once the caps have settled.
+     *
+     *  \param[in] serCap : serial cap (AAT_A)
+     *  \param[in] parCap : parallel cap (AAT_B)
+     *
+     *  \return ERR_NONE  : Measurement started, poll st25r3918AatGetStatus()
+     *
+     *****************************************************************************
+     */
+    ReturnCode st25r3918AatMeasureStart(uint8_t serCap, uint8_t parCap);
+
+    /*!
+     *****************************************************************************
+     *  \brief  Get antenna tuning or measurement status
+     *
+     *  Runs the tuning or measurement started by st25r3918AatTuneStart() or
+     *  st25r3918AatMeasureStart() one settled measurement further.
+     *
+     *  \param[out] tuningStatus : Caps with the amplitude and phase they gave,
+     *                             filled once done. May be NULL.
+     *
+     *  \return ERR_BUSY        : Caps still settling or more measurements to do
+     *  \return ERR_WRONG_STATE : Nothing started
+     *  \return ERR_IO          : Error during communication (measurement)
+     *  \return ERR_OVERRUN     : Measure limit reached, best caps found so far set
+     *  \return ERR_NONE        : Done
+     *
+     *****************************************************************************
+     */
+    ReturnCode st25r3918AatGetStatus(struct st25r3918AatTuneResult *tuningStatus);
+
   protected:
 
     void rfalTransceiveTx(void);
@@ -1943,19 +2303,31 @@ class RfalRfST25R3918Class : public RfalRfClass {
     void rfalErrorHandling(void);
     ReturnCode rfalRunTransceiveWorker(void);
     void rfalRunWakeUpModeWorker(void);
+    void rfalWakeUpModeEnable(void);
 
     void rfalFIFOStatusUpdate(void);
     void rfalFIFOStatusClear(void);
     bool rfalFIFOStatusIsMissingPar(void);
     bool rfalFIFOStatusIsIncompleteByte(void);
-    uint8_t rfalFIFOStatusGetNumBytes(void);
+    uint16_t rfalFIFOStatusGetNumBytes(void);
     uint8_t rfalFIFOGetNumIncompleteBits(void);
     rfalAnalogConfigNum rfalAnalogConfigSearch(rfalAnalogConfigId configId, uint16_t *configOffset);
+    ReturnCode rfalSetAnalogConfigCmdList(rfalAnalogConfigId configId, st25r3918CmdList *list);
+    ReturnCode st25r3918CmdListAppend(st25r3918CmdList *list, uint8_t type, uint8_t reg, uint8_t clr_mask, uint8_t set_mask);
+    ReturnCode st25r3918CmdListExecuteRegs(const st25r3918CmdListOp *ops, uint8_t len);
+    bool st25r3918IsIrqPinHigh(void);
+    ReturnCode st25r3918I2CTransfer(uint8_t prefix, uint8_t op, const uint8_t *txData, uint16_t txLen, uint8_t *rxData, uint16_t rxLen);
+#ifdef ST25R3918_TRACE
+    void st25r3918TraceRecord(uint8_t type, uint8_t prefix, uint8_t op, const uint8_t *data, uint16_t len);
+#endif
     uint16_t rfalCrcUpdateCcitt(uint16_t crcSeed, uint8_t dataByte);
-    ReturnCode aatHillClimb(const struct st25r3918AatTuneParams *tuningParams, struct st25r3918AatTuneResult *tuningStatus);
-    int32_t aatGreedyDescent(uint32_t *f_min, const struct st25r3918AatTuneParams *tuningParams, struct st25r3918AatTuneResult *tuningStatus, int32_t previousDir);
-    int32_t aatSteepestDescent(uint32_t *f_min, const struct st25r3918AatTuneParams *tuningParams, struct st25r3918AatTuneResult *tuningStatus, int32_t previousDir, int32_t previousDir2);
-    ReturnCode aatMeasure(uint8_t serCap, uint8_t parCap, uint8_t *amplitude, uint8_t *phase, uint16_t *measureCnt);
+    void iso15693VICCDecodePairs(iso15693VICCDecoder *dec, const uint8_t *inBuf, uint16_t base, uint16_t mpEnd);
+    void rfalNfcvReadFifo(uint16_t length);
+    ReturnCode aatHillClimbStep(uint8_t amp, uint8_t phs);
+    ReturnCode aatSteepestNext(void);
+    ReturnCode aatGreedyNext(void);
+    ReturnCode aatDescentDone(void);
+    void aatMeasureSet(uint8_t serCap, uint8_t parCap);
     uint32_t aatCalcF(const struct st25r3918AatTuneParams *tuningParams, uint8_t amplitude, uint8_t phase);
     ReturnCode aatStepDacVals(const struct st25r3918AatTuneParams *tuningParams, uint8_t *a, uint8_t *b, int32_t dir);
     void setISRPending(void);
@@ -1969,11 +2341,8 @@ class RfalRfST25R3918Class : public RfalRfClass {
      */
     void  st25r3918Isr(void);
 
-    TwoWire *dev_i2c;
-    SPIClass *dev_spi;
-    int cs_pin;
+    ST25R3918I2C *dev_i2c;
     int int_pin;
-    uint32_t spi_speed;
 
     rfal gRFAL;              /*!< RFAL module instance               */
     rfalAnalogConfigMgmt gRfalAnalogConfigMgmt;  /*!< Analog Configuration LUT management */
@@ -1981,10 +2350,15 @@ class RfalRfST25R3918Class : public RfalRfClass {
     uint32_t gST25R3918NRT_64fcs;
     volatile st25r3918Interrupt st25r3918interrupt; /*!< Instance of ST25R3918 interrupt */
     uint32_t timerStopwatchTick;
-    bool i2c_enabled;
     volatile bool isr_pending;
     volatile bool bus_busy;
     ST25R3918IrqHandler irq_handler;
+    st25r3918BusStats gBusStats;  /*!< I2C transport counters            */
+    struct st25r3918AatCtx gAat;  /*!< Non-blocking antenna tuning       */
+#ifdef ST25R3918_TRACE
+    st25r3918Trace gTrace;   /*!< I2C transaction trace              */
+    uint8_t gTraceTxRxState; /*!< Transceive state last traced       */
+#endif
 };
 
 #ifdef __cplusplus
@@ -157,6 +157,19 @@ ReturnCode RfalRfST25R3918Class::rfalAnalogConfigListRead(rfalAnalogConfigOffset
 
 
 ReturnCode RfalRfST25R3918Class::rfalSetAnalogConfig(rfalAnalogConfigId configId)
+{
+  ReturnCode       retCode;
+  st25r3918CmdList list;
+
+  st25r3918CmdListInit(&list);
+  EXIT_ON_ERR(retCode, rfalSetAnalogConfigCmdList(configId, &list));
+
+  return st25r3918CmdListExecute(&list);
+} /* rfalSetAnalogConfig() */
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::rfalSetAnalogConfigCmdList(rfalAnalogConfigId configId, st25r3918CmdList *list)
 {
   rfalAnalogConfigOffset configOffset = 0;
   rfalAnalogConfigNum numConfigSet;
@@ -175,7 +188,7 @@ ReturnCode RfalRfST25R3918Class::rfalSetAnalogConfig(rfalAnalogConfigId configId
       break;
     }
 
-    configTbl = (rfalAnalogConfigRegAddrMaskVal *)((uint32_t)gRfalAnalogConfigMgmt.currentAnalogConfigTbl + (uint32_t)configOffset);
+    configTbl = (rfalAnalogConfigRegAddrMaskVal *)&gRfalAnalogConfigMgmt.currentAnalogConfigTbl[configOffset];
     /* Increment the offset to the next index to search from. */
     configOffset += (uint16_t)(numConfigSet * sizeof(rfalAnalogConfigRegAddrMaskVal));
 
@@ -184,17 +197,23 @@ ReturnCode RfalRfST25R3918Class::rfalSetAnalogConfig(rfalAnalogConfigId configId
       return ERR_NOMEM;
     }
 
+    /* Record the settings, they are applied on the chip when the list is executed */
     for (i = 0; i < numConfigSet; i++) {
       if ((GETU16(configTbl[i].addr) & RFAL_TEST_REG) != 0U) {
-        EXIT_ON_ERR(retCode, rfalChipChangeTestRegBits((GETU16(configTbl[i].addr) & ~RFAL_TEST_REG), configTbl[i].mask, configTbl[i].val));
+        EXIT_ON_ERR(retCode, st25r3918CmdListChangeTestBits(list, (uint8_t)(GETU16(configTbl[i].addr) & ~RFAL_TEST_REG), configTbl[i].mask, configTbl[i].val));
+      } else if (gRFAL.conf.antTuneSet && (GETU16(configTbl[i].addr) == ST25R3918_REG_ANT_TUNE_A)) {
+        /* Antenna tuning set by the user takes precedence over the table */
+        EXIT_ON_ERR(retCode, st25r3918CmdListWrite(list, ST25R3918_REG_ANT_TUNE_A, gRFAL.conf.antTuneA));
+      } else if (gRFAL.conf.antTuneSet && (GETU16(configTbl[i].addr) == ST25R3918_REG_ANT_TUNE_B)) {
+        EXIT_ON_ERR(retCode, st25r3918CmdListWrite(list, ST25R3918_REG_ANT_TUNE_B, gRFAL.conf.antTuneB));
       } else {
-        EXIT_ON_ERR(retCode, rfalChipChangeRegBits(GETU16(configTbl[i].addr), configTbl[i].mask, configTbl[i].val));
+        EXIT_ON_ERR(retCode, st25r3918CmdListChangeBits(list, (uint8_t)GETU16(configTbl[i].addr), configTbl[i].mask, configTbl[i].val));
       }
     }
   } /* while(found Analog Config Id) */
 
   return retCode;
-} /* rfalSetAnalogConfig() */
+} /* rfalSetAnalogConfigCmdList() */
 
 
 /*!
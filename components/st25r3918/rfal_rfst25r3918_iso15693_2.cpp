@@ -237,49 +237,163 @@ ReturnCode RfalRfST25R3918Class::iso15693VCDCode(uint8_t *buffer, uint16_t lengt
   return err;
 }
 
-ReturnCode RfalRfST25R3918Class::iso15693VICCDecode(const uint8_t *inBuf,
-                                                    uint16_t inBufLen,
-                                                    uint8_t *outBuf,
-                                                    uint16_t outBufLen,
-                                                    uint16_t *outBufPos,
-                                                    uint16_t *bitsBeforeCol,
-                                                    uint16_t ignoreBits,
-                                                    bool picopassMode)
+void RfalRfST25R3918Class::iso15693VICCDecodeStart(iso15693VICCDecoder *dec,
+                                                   uint8_t *outBuf,
+                                                   uint16_t outBufLen,
+                                                   uint16_t ignoreBits,
+                                                   bool picopassMode)
 {
-  ReturnCode err = ERR_NONE;
-  uint16_t crc;
-  uint16_t mp; /* Current bit position in manchester bit inBuf*/
-  uint16_t bp; /* Current bit position in outBuf */
+  dec->outBuf     = outBuf;
+  dec->outBufLen  = outBufLen;
+  dec->ignoreBits = ignoreBits;
+  dec->picopass   = picopassMode;
+  dec->rawLen     = 0;
+  dec->mp         = 5; /* 5 bits are SOF, then manchester starts: 2 bits per payload bit */
+  dec->bp         = 0;
+  dec->crc        = ((picopassMode) ? 0xE012U : 0xFFFFU);
+  dec->crcLen     = 0;
+  dec->done       = false;
+  dec->err        = ERR_NONE;
+
+  if (outBuf != NULL) {
+    ST_MEMSET(outBuf, 0, outBufLen);
+  }
+}
+
+void RfalRfST25R3918Class::iso15693VICCDecodeFeed(iso15693VICCDecoder *dec, const uint8_t *inBuf, uint16_t inBufLen)
+{
+  uint16_t base = dec->rawLen;
+  uint16_t i;
+
+  if (dec->done || (inBufLen == 0U)) {
+    return;
+  }
+  dec->rawLen = (uint16_t)(base + inBufLen);
+
+  if (base == 0U) {
+    /* first check for valid SOF. Since it starts with 3 unmodulated pulses it is 0x17. */
+    if ((inBuf[0] & 0x1fU) != 0x17U) {
+      ISO_15693_DEBUG("0x%x\n", inBuf[0]);
+      dec->err  = ERR_FRAMING;
+      dec->done = true;
+      return;
+    }
+    if (dec->outBufLen == 0U) {
+      dec->done = true;
+      return;
+    }
+  }
+
+  /* Decode the bit pairs whose EOF look-ahead byte has arrived */
+  iso15693VICCDecodePairs(dec, inBuf, base, (uint16_t)((dec->rawLen - 1U) * 8U));
+
+  /* Keep the last bytes for the pairs still pending */
+  for (i = ((inBufLen > 4U) ? (uint16_t)(inBufLen - 4U) : 0U); i < inBufLen; i++) {
+    dec->raw[(base + i) & 3U] = inBuf[i];
+  }
+}
 
+ReturnCode RfalRfST25R3918Class::iso15693VICCDecodeFinish(iso15693VICCDecoder *dec, uint16_t *outBufPos, uint16_t *bitsBeforeCol)
+{
   *bitsBeforeCol = 0;
   *outBufPos = 0;
 
-  /* first check for valid SOF. Since it starts with 3 unmodulated pulses it is 0x17. */
-  if ((inBuf[0] & 0x1fU) != 0x17U) {
-    ISO_15693_DEBUG("0x%x\n", iso15693PhyBitBuffer[0]);
+  if (dec->rawLen == 0U) {
     return ERR_FRAMING;
   }
-  ISO_15693_DEBUG("SOF\n");
-
-  if (outBufLen == 0U) {
+  if (dec->err == ERR_FRAMING) {
+    return ERR_FRAMING;
+  }
+  if (dec->outBufLen == 0U) {
     return ERR_NONE;
   }
 
-  mp = 5; /* 5 bits were SOF, now manchester starts: 2 bits per payload bit */
-  bp = 0;
+  /* Frame ended without EOF: decode up to the last complete bit pair */
+  if (!dec->done) {
+    iso15693VICCDecodePairs(dec, NULL, dec->rawLen, (uint16_t)((dec->rawLen * 8U) - 2U));
+  }
 
-  ST_MEMSET(outBuf, 0, outBufLen);
+  *outBufPos = (dec->bp / 8U);
+  *bitsBeforeCol = dec->bp;
 
-  if (inBufLen == 0U) {
+  if (dec->err != ERR_NONE) {
+    return dec->err;
+  }
+
+  if ((dec->bp % 8U) != 0U) {
     return ERR_CRC;
   }
 
-  for (; mp < ((inBufLen * 8U) - 2U); mp += 2U) {
-    bool isEOF = false;
+  /* finally, check crc: over payload and CRC it leaves the residue */
+  if ((*outBufPos > 2U) && (dec->crc == ((dec->picopass) ? 0U : ISO15693_CRC_RESIDUE))) {
+    ISO_15693_DEBUG("OK\n");
+    return ERR_NONE;
+  }
+
+  ISO_15693_DEBUG("error! CRC: 0x%x\n", dec->crc);
+  return ERR_CRC;
+}
+
+ReturnCode RfalRfST25R3918Class::iso15693VICCDecode(const uint8_t *inBuf,
+                                                    uint16_t inBufLen,
+                                                    uint8_t *outBuf,
+                                                    uint16_t outBufLen,
+                                                    uint16_t *outBufPos,
+                                                    uint16_t *bitsBeforeCol,
+                                                    uint16_t ignoreBits,
+                                                    bool picopassMode)
+{
+  iso15693VICCDecoder dec;
+
+  iso15693VICCDecodeStart(&dec, outBuf, outBufLen, ignoreBits, picopassMode);
+  iso15693VICCDecodeFeed(&dec, inBuf, inBufLen);
+  return iso15693VICCDecodeFinish(&dec, outBufPos, bitsBeforeCol);
+}
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+/*!
+ *****************************************************************************
+ *  \brief  Decode the Manchester bit pairs of a VICC response up to a position
+ *
+ *  Decodes the pairs starting below \a mpEnd into \a dec->outBuf and feeds every
+ *  completed byte to the running CRC. Coded bytes not received (yet) read as 0.
+ *
+ *  \param[in,out] dec : decoder state
+ *  \param[in] inBuf : chunk being fed, coded bytes from \a base on
+ *  \param[in] base : position of inBuf in the coded stream, earlier bytes are in dec->raw
+ *  \param[in] mpEnd : first pair position not to decode
+ *****************************************************************************
+ */
+void RfalRfST25R3918Class::iso15693VICCDecodePairs(iso15693VICCDecoder *dec, const uint8_t *inBuf, uint16_t base, uint16_t mpEnd)
+{
+  /* Working copies: the writes to outBuf would otherwise reload them every pair */
+  uint8_t    *outBuf = dec->outBuf;
+  uint16_t   bpEnd   = (uint16_t)(dec->outBufLen * 8U);
+  uint16_t   rawLen  = dec->rawLen;
+  uint16_t   mp      = dec->mp;
+  uint16_t   bp      = dec->bp;
+  uint16_t   crc     = dec->crc;
+  uint16_t   crcLen  = dec->crcLen;
+  ReturnCode err     = ERR_NONE;
+  uint16_t   pos;
+  uint16_t   win;
+  uint8_t    man;
+  bool       isEOF = false;
+
+  for (; mp < mpEnd; mp += 2U) {
+    /* Byte holding the first bit of the pair and the one after it (second bit, EOF check) */
+    pos = (uint16_t)(mp / 8U);
+    win = ((pos >= base) ? inBuf[pos - base] : dec->raw[pos & 3U]);
+    pos++;
+    if (pos < rawLen) {
+      win |= (uint16_t)((uint16_t)((pos >= base) ? inBuf[pos - base] : dec->raw[pos & 3U]) << 8U);
+    }
 
-    uint8_t man;
-    man  = (inBuf[mp / 8U] >> (mp % 8U)) & 0x1U;
-    man |= ((inBuf[(mp + 1U) / 8U] >> ((mp + 1U) % 8U)) & 0x1U) << 1;
+    man = (uint8_t)((win >> (mp % 8U)) & 0x3U);
     if (1U == man) {
       bp++;
     }
@@ -289,68 +403,44 @@ ReturnCode RfalRfST25R3918Class::iso15693VICCDecode(const uint8_t *inBuf,
     }
     if ((bp % 8U) == 0U) {
       /* Check for EOF */
-      ISO_15693_DEBUG("ceof %hhx %hhx\n", inBuf[mp / 8U], inBuf[mp / 8 + 1]);
-      if (((inBuf[mp / 8U]   & 0xe0U) == 0xa0U)
-          && (inBuf[(mp / 8U) + 1U] == 0x03U)) {
+      if (((win & 0xe0U) == 0xa0U) && ((win >> 8U) == 0x03U)) {
         /* Now we know that it was 10111000 = EOF */
         ISO_15693_DEBUG("EOF\n");
         isEOF = true;
       }
     }
     if (((0U == man) || (3U == man)) && !isEOF) {
-      if (bp >= ignoreBits) {
+      if (bp >= dec->ignoreBits) {
         err = ERR_RF_COLLISION;
       } else {
         /* ignored collision: leave as 0 */
         bp++;
       }
     }
-    if ((bp >= (outBufLen * 8U)) || (err == ERR_RF_COLLISION) || isEOF) {
+
+    /* Bytes below bp are final */
+    if (crcLen < (bp / 8U)) {
+      crc = rfalCrcUpdateCcitt(crc, outBuf[crcLen]);
+      crcLen++;
+    }
+
+    if ((bp >= bpEnd) || (err == ERR_RF_COLLISION) || isEOF) {
       /* Don't write beyond the end */
+      dec->done = true;
+      mp += 2U;
       break;
     }
   }
 
-  *outBufPos = (bp / 8U);
-  *bitsBeforeCol = bp;
-
+  dec->mp     = mp;
+  dec->bp     = bp;
+  dec->crc    = crc;
+  dec->crcLen = crcLen;
   if (err != ERR_NONE) {
-    return err;
-  }
-
-  if ((bp % 8U) != 0U) {
-    return ERR_CRC;
-  }
-
-  if (*outBufPos > 2U) {
-    /* finally, check crc */
-    ISO_15693_DEBUG("Calculate CRC, val: 0x%x, outBufLen: ", *outBuf);
-    ISO_15693_DEBUG("0x%x ", *outBufPos - 2);
-
-    crc = rfalCrcCalculateCcitt(((picopassMode) ? 0xE012U : 0xFFFFU), outBuf, *outBufPos - 2U);
-    crc = (uint16_t)((picopassMode) ? crc : ~crc);
-
-    if (((crc & 0xffU) == outBuf[*outBufPos - 2U]) &&
-        (((crc >> 8U) & 0xffU) == outBuf[*outBufPos - 1U])) {
-      err = ERR_NONE;
-      ISO_15693_DEBUG("OK\n");
-    } else {
-      ISO_15693_DEBUG("error! Expected: 0x%x, got ", crc);
-      ISO_15693_DEBUG("0x%hhx 0x%hhx\n", outBuf[*outBufPos - 2], outBuf[*outBufPos - 1]);
-      err = ERR_CRC;
-    }
-  } else {
-    err = ERR_CRC;
+    dec->err = err;
   }
-
-  return err;
 }
 
-/*
-******************************************************************************
-* LOCAL FUNCTIONS
-******************************************************************************
-*/
 /*!
  *****************************************************************************
  *  \brief  Perform 1 of 4 coding and send coded data
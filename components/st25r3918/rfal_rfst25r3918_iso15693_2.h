@@ -66,6 +66,22 @@ struct iso15693StreamConfig {
   uint8_t dout;                 /*!< the divider for the in subcarrier frequency fc/2^dout */
   uint8_t report_period_length; /*!< the length of the reporting period 2^report_period_length*/
 };
+
+/*! State of a VICC response decode, fed while the FIFO is drained (see #iso15693VICCDecodeStart) */
+typedef struct {
+  uint8_t    *outBuf;     /*!< Decoded payload (with CRC)                                     */
+  uint16_t   outBufLen;   /*!< Size of outBuf                                                 */
+  uint16_t   ignoreBits;  /*!< Bits at the beginning where collisions are ignored             */
+  bool       picopass;    /*!< PicoPass CRC preset, CRC not inverted                          */
+  uint8_t    raw[4];      /*!< Last coded bytes received, indexed by position modulo 4        */
+  uint16_t   rawLen;      /*!< Coded bytes received so far                                    */
+  uint16_t   mp;          /*!< Next Manchester bit pair position in the coded stream          */
+  uint16_t   bp;          /*!< Decoded bits                                                   */
+  uint16_t   crc;         /*!< Running CRC over the decoded bytes                             */
+  uint16_t   crcLen;      /*!< Decoded bytes included in crc                                  */
+  bool       done;        /*!< EOF, collision, full outBuf or bad SOF: later bytes are ignored */
+  ReturnCode err;         /*!< ERR_FRAMING (bad SOF), ERR_RF_COLLISION or ERR_NONE            */
+} iso15693VICCDecoder;
 /*
 ******************************************************************************
 * GLOBAL CONSTANTS
@@ -75,6 +91,7 @@ struct iso15693StreamConfig {
 #define ISO15693_REQ_FLAG_TWO_SUBCARRIERS 0x01U   /*!< Flag indication that communication uses two subcarriers */
 #define ISO15693_REQ_FLAG_HIGH_DATARATE   0x02U   /*!< Flag indication that communication uses high bitrate    */
 #define ISO15693_MASK_FDT_LISTEN         (65)     /*!< t1min = 308,2us = 4192/fc = 65.5 * 64/fc                */
+#define ISO15693_CRC_RESIDUE             0xF0B8U  /*!< CRC over payload + inverted CRC of a valid frame          */
 
 /*! t1max = 323,3us = 4384/fc = 68.5 * 64/fc
  *         12 = 768/fc unmodulated time of single subcarrior SoF */
@@ -3,10 +3,13 @@ import esphome.config_validation as cv
 from esphome.components import sensor
 from esphome.const import (
     UNIT_HOUR,
+    UNIT_MINUTE,
     UNIT_PERCENT,
     ICON_TIMER,
     STATE_CLASS_TOTAL_INCREASING,
     STATE_CLASS_MEASUREMENT,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_SIGNAL,
 )
 from . import ST25R3918Component, st25r3918_ns
 
@@ -14,8 +17,27 @@ DEPENDENCIES = ["st25r3918"]
 
 CONF_USAGE_TIME = "usage_time"
 CONF_SCENT_REMAINING = "scent_remaining"
+CONF_LINK_RSSI = "link_rssi"
+CONF_CRC_ERROR_RATE = "crc_error_rate"
+CONF_FRAMING_ERROR_RATE = "framing_error_rate"
+CONF_TIMEOUT_RATE = "timeout_rate"
+CONF_I2C_ERRORS = "i2c_errors"
+CONF_DAILY_USAGE = "daily_usage"
 CONF_ST25R3918_ID = "st25r3918_id"
 
+UNIT_MILLIVOLT = "mV"
+
+
+def link_rate_schema():
+    return sensor.sensor_schema(
+        unit_of_measurement=UNIT_PERCENT,
+        icon="mdi:alert-circle-outline",
+        accuracy_decimals=1,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(CONF_ST25R3918_ID): cv.use_id(ST25R3918Component),
@@ -25,12 +47,37 @@ CONFIG_SCHEMA = cv.Schema(
             accuracy_decimals=1,
             state_class=STATE_CLASS_TOTAL_INCREASING,
         ),
+        # Heating time of the current cart today (from the usage journal)
+        cv.Optional(CONF_DAILY_USAGE): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MINUTE,
+            icon=ICON_TIMER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+        ),
         cv.Optional(CONF_SCENT_REMAINING): sensor.sensor_schema(
             unit_of_measurement=UNIT_PERCENT,
             icon="mdi:bottle-tonic-outline",
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
         ),
+        # Link quality of the tag reads, averaged over each update interval
+        cv.Optional(CONF_LINK_RSSI): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLIVOLT,
+            icon=ICON_SIGNAL,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_CRC_ERROR_RATE): link_rate_schema(),
+        cv.Optional(CONF_FRAMING_ERROR_RATE): link_rate_schema(),
+        cv.Optional(CONF_TIMEOUT_RATE): link_rate_schema(),
+        # NACKed transfers and failed reads on the chip's I2C bus since boot
+        cv.Optional(CONF_I2C_ERRORS): sensor.sensor_schema(
+            icon="mdi:alert-circle-outline",
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
     }
 )
 
@@ -42,6 +89,30 @@ async def to_code(config):
         sens = await sensor.new_sensor(config[CONF_USAGE_TIME])
         cg.add(parent.set_usage_time_sensor(sens))
 
+    if CONF_DAILY_USAGE in config:
+        sens = await sensor.new_sensor(config[CONF_DAILY_USAGE])
+        cg.add(parent.set_daily_usage_sensor(sens))
+
     if CONF_SCENT_REMAINING in config:
         sens = await sensor.new_sensor(config[CONF_SCENT_REMAINING])
         cg.add(parent.set_scent_remaining_sensor(sens))
+
+    if CONF_LINK_RSSI in config:
+        sens = await sensor.new_sensor(config[CONF_LINK_RSSI])
+        cg.add(parent.set_link_rssi_sensor(sens))
+
+    if CONF_CRC_ERROR_RATE in config:
+        sens = await sensor.new_sensor(config[CONF_CRC_ERROR_RATE])
+        cg.add(parent.set_crc_error_rate_sensor(sens))
+
+    if CONF_FRAMING_ERROR_RATE in config:
+        sens = await sensor.new_sensor(config[CONF_FRAMING_ERROR_RATE])
+        cg.add(parent.set_framing_error_rate_sensor(sens))
+
+    if CONF_TIMEOUT_RATE in config:
+        sens = await sensor.new_sensor(config[CONF_TIMEOUT_RATE])
+        cg.add(parent.set_timeout_rate_sensor(sens))
+
+    if CONF_I2C_ERRORS in config:
+        sens = await sensor.new_sensor(config[CONF_I2C_ERRORS])
+        cg.add(parent.set_i2c_errors_sensor(sens))
@@ -465,10 +465,28 @@ ReturnCode RfalRfST25R3918Class::st25r3918SetStartGPTimer(uint16_t gpt_8fcs, uin
 }
 
 
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918CmdListSetStartGPTimer(st25r3918CmdList *list, uint16_t gpt_8fcs, uint8_t trigger_source)
+{
+  ReturnCode ret;
+
+  EXIT_ON_ERR(ret, st25r3918CmdListWrite(list, ST25R3918_REG_GPT1, (uint8_t)(gpt_8fcs >> 8)));
+  EXIT_ON_ERR(ret, st25r3918CmdListWrite(list, ST25R3918_REG_GPT2, (uint8_t)(gpt_8fcs & 0xFFU)));
+  EXIT_ON_ERR(ret, st25r3918CmdListChangeBits(list, ST25R3918_REG_TIMER_EMV_CONTROL, ST25R3918_REG_TIMER_EMV_CONTROL_gptc_mask, trigger_source));
+
+  /* If there's no trigger source, start GPT immediately */
+  if (trigger_source == ST25R3918_REG_TIMER_EMV_CONTROL_gptc_no_trigger) {
+    EXIT_ON_ERR(ret, st25r3918CmdListCommand(list, ST25R3918_CMD_START_GP_TIMER));
+  }
+
+  return ERR_NONE;
+}
+
+
 /*******************************************************************************/
 bool RfalRfST25R3918Class::st25r3918CheckChipID(uint8_t *rev)
 {
-  uint8_t id;
+  uint8_t id = 0;  /* Stays 0 (no match) if the chip doesn't answer */
   st25r3918ReadRegister(ST25R3918_REG_IC_IDENTITY, &id);
 
   const uint8_t chipId = id & ST25R3918_REG_IC_IDENTITY_ic_type_mask;
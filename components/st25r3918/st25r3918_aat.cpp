@@ -75,8 +75,22 @@
 ReturnCode RfalRfST25R3918Class::st25r3918AatTune(const struct st25r3918AatTuneParams *tuningParams, struct st25r3918AatTuneResult *tuningStatus)
 {
   ReturnCode err;
+
+  EXIT_ON_ERR(err, st25r3918AatTuneStart(tuningParams));
+
+  /* Blocking by API, the component runs the Start/GetStatus pair from its worker */
+  do {
+    yield();
+    err = st25r3918AatGetStatus(tuningStatus);
+  } while (err == ERR_BUSY);
+
+  return err;
+}
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918AatTuneStart(const struct st25r3918AatTuneParams *tuningParams)
+{
   const struct st25r3918AatTuneParams *tp = tuningParams;
-  struct st25r3918AatTuneResult *ts = tuningStatus;
   struct st25r3918AatTuneParams defaultTuningParams = {
     .aat_a_min = 0,
     .aat_a_max = 255,
@@ -95,7 +109,6 @@ ReturnCode RfalRfST25R3918Class::st25r3918AatTune(const struct st25r3918AatTuneP
     .doDynamicSteps = true,
     .measureLimit = 50,
   };
-  struct st25r3918AatTuneResult defaultTuneResult;
 
   if ((NULL != tp) && (
         (tp->aat_a_min > tp->aat_a_max)
@@ -115,124 +128,208 @@ ReturnCode RfalRfST25R3918Class::st25r3918AatTune(const struct st25r3918AatTuneP
     tp = &defaultTuningParams;
   }
 
-  if (NULL == ts) {
-    ts = &defaultTuneResult;
-  }
+  gAat.tp            = *tp; /* local copy, the step widths get reduced */
+  gAat.ts.aat_a      = tp->aat_a_start;
+  gAat.ts.aat_b      = tp->aat_b_start;
+  gAat.ts.amp        = 0;
+  gAat.ts.pha        = 0;
+  gAat.ts.measureCnt = 0; /* Clear current measure count */
+  gAat.err           = ERR_NONE;
+  gAat.state         = ST25R3918_AAT_ST_START;
 
-  ts->measureCnt = 0; /* Clear current measure count */
+  /* Get a proper start value */
+  aatMeasureSet(gAat.ts.aat_a, gAat.ts.aat_b);
 
-  err = aatHillClimb(tp, ts);
+  return ERR_NONE;
+}
 
-  return err;
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918AatMeasureStart(uint8_t serCap, uint8_t parCap)
+{
+  gAat.ts.aat_a      = serCap;
+  gAat.ts.aat_b      = parCap;
+  gAat.ts.amp        = 0;
+  gAat.ts.pha        = 0;
+  gAat.ts.measureCnt = 0;
+  gAat.err           = ERR_NONE;
+  gAat.state         = ST25R3918_AAT_ST_MEASURE;
+
+  aatMeasureSet(serCap, parCap);
+
+  return ERR_NONE;
 }
 
 /*******************************************************************************/
-ReturnCode RfalRfST25R3918Class::aatHillClimb(const struct st25r3918AatTuneParams *tuningParams, struct st25r3918AatTuneResult *tuningStatus)
+ReturnCode RfalRfST25R3918Class::st25r3918AatGetStatus(struct st25r3918AatTuneResult *tuningStatus)
 {
-  ReturnCode  err = ERR_NONE;
-  uint32_t f_min;
-  int32_t direction, gdirection;
-  uint8_t amp, phs;
-  struct st25r3918AatTuneParams tp = *tuningParams; // local copy to obey const
+  ReturnCode err;
+  uint8_t amp = 0, phs = 0;
 
-  tuningStatus->aat_a = tuningParams->aat_a_start;
-  tuningStatus->aat_b = tuningParams->aat_b_start;
+  if (gAat.state == ST25R3918_AAT_ST_IDLE) {
+    return ERR_WRONG_STATE;
+  }
 
-  /* Get a proper start value */
-  aatMeasure(tuningStatus->aat_a, tuningStatus->aat_b, &amp, &phs, &tuningStatus->measureCnt);
-  f_min = aatCalcF(&tp, amp, phs);
-  direction = 0;
+  /* Caps set on a previous call, measure once they have settled */
+  if (!rfalTimerisExpiredUs(gAat.tmr)) {
+    return ERR_BUSY;
+  }
 
-  st25r3918AatLog("%d %d: %d***\n", tuningStatus->aat_a, tuningStatus->aat_b, f_min);
+  /* Get amplitude and phase .. */
+  err = rfalChipMeasureAmplitude(&amp);
+  if (ERR_NONE == err) {
+    err = rfalChipMeasurePhase(&phs);
+  }
+  gAat.ts.measureCnt++;
+
+  if (gAat.state == ST25R3918_AAT_ST_MEASURE) {
+    gAat.ts.amp = amp;
+    gAat.ts.pha = phs;
+  } else {
+    /* As in the blocking climb a failed measurement only gives a bad cost */
+    err = aatHillClimbStep(amp, phs);
+    if (err == ERR_BUSY) {
+      return ERR_BUSY;
+    }
+    /* Leave the best caps found set */
+    st25r3918WriteRegister(ST25R3918_REG_ANT_TUNE_A, gAat.ts.aat_a);
+    st25r3918WriteRegister(ST25R3918_REG_ANT_TUNE_B, gAat.ts.aat_b);
+  }
 
-  do {
-    direction = 0; /* Initially and after reducing step sizes we don't have a previous direction */
-    do {
-      /* With the greedy step below always executed aftwards the -direction does never need to be investigated */
-      direction = aatSteepestDescent(&f_min, &tp, tuningStatus, direction, -direction);
-      if (tuningStatus->measureCnt > tp.measureLimit) {
-        err = ERR_OVERRUN;
-        break;
+  gAat.state = ST25R3918_AAT_ST_IDLE;
+  if (tuningStatus != NULL) {
+    *tuningStatus = gAat.ts;
+  }
+  return err;
+}
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::aatHillClimbStep(uint8_t amp, uint8_t phs)
+{
+  uint32_t f = aatCalcF(&gAat.tp, amp, phs);
+
+  switch (gAat.state) {
+    case ST25R3918_AAT_ST_START:
+      gAat.f_min  = f;
+      gAat.ts.amp = amp;
+      gAat.ts.pha = phs;
+      st25r3918AatLog("%d %d: %d***\n", gAat.ts.aat_a, gAat.ts.aat_b, f);
+
+      /* Initially we don't have a previous direction */
+      gAat.direction = 0;
+      gAat.dir       = -2;
+      gAat.bestdir   = 0;
+      gAat.state     = ST25R3918_AAT_ST_STEEPEST;
+      return aatSteepestNext();
+
+    case ST25R3918_AAT_ST_STEEPEST:
+      st25r3918AatLog("%d : %d %d: %d\n", gAat.dir, gAat.a, gAat.b, f);
+      if (f < gAat.f_min) {
+        /* Value is better than all previous ones */
+        gAat.f_min   = f;
+        gAat.bestdir = gAat.dir;
+        gAat.bestAmp = amp;
+        gAat.bestPha = phs;
       }
-      do {
-        gdirection = aatGreedyDescent(&f_min, &tp, tuningStatus, direction);
-        if (tuningStatus->measureCnt > tp.measureLimit) {
-          err = ERR_OVERRUN;
-          break;
+      gAat.dir++;
+      return aatSteepestNext();
+
+    case ST25R3918_AAT_ST_GREEDY:
+      st25r3918AatLog("g : %d %d: %d\n", gAat.a, gAat.b, f);
+      if (f < gAat.f_min) {
+        /* Value is better than previous one */
+        gAat.ts.aat_a = gAat.a;
+        gAat.ts.aat_b = gAat.b;
+        gAat.ts.amp   = amp;
+        gAat.ts.pha   = phs;
+        gAat.f_min    = f;
+        if (gAat.ts.measureCnt > gAat.tp.measureLimit) {
+          gAat.err = ERR_OVERRUN;
+          return aatDescentDone();
         }
-      } while (0 != gdirection);
-    } while (0 != direction);
-    tp.aat_a_stepWidth /= 2U; /* Reduce step sizes */
-    tp.aat_b_stepWidth /= 2U;
-  } while (tp.doDynamicSteps && ((tp.aat_a_stepWidth > 0U) || (tp.aat_b_stepWidth > 0U)));
+        return aatGreedyNext();
+      }
+      if (gAat.ts.measureCnt > gAat.tp.measureLimit) {
+        gAat.err = ERR_OVERRUN;
+      }
+      return aatDescentDone();
 
-  return err;
+    default:
+      return ERR_WRONG_STATE;
+  }
 }
 
 /*******************************************************************************/
-int32_t RfalRfST25R3918Class::aatSteepestDescent(uint32_t *f_min, const struct st25r3918AatTuneParams *tuningParams, struct st25r3918AatTuneResult *tuningStatus, int32_t previousDir, int32_t previousDir2)
+ReturnCode RfalRfST25R3918Class::aatSteepestNext(void)
 {
-  int32_t i;
-  uint8_t amp, phs;
-  uint32_t f;
-  int32_t bestdir = 0; /* Negative direction: decrease, Positive: increase. (-)1: aat_a, (-)2: aat_b */
+  /* Negative direction: decrease, Positive: increase. (-)1: aat_a, (-)2: aat_b */
+  for (; gAat.dir <= 2; gAat.dir++) {
+    uint8_t a = gAat.ts.aat_a, b = gAat.ts.aat_b;
 
-  for (i = -2; i <= 2; i++) {
-    uint8_t a = tuningStatus->aat_a, b = tuningStatus->aat_b;
-
-    if ((0 == i) || (i == -previousDir) || (i == -previousDir2)) {
+    /* With the greedy step always executed afterwards the -direction does never need to be investigated */
+    if ((0 == gAat.dir) || (gAat.dir == gAat.direction) || (gAat.dir == -gAat.direction)) {
       /* Skip no direction and avoid going backwards */
       continue;
     }
-    if (0U != aatStepDacVals(tuningParams, &a, &b, i)) {
+    if (ERR_NONE != aatStepDacVals(&gAat.tp, &a, &b, gAat.dir)) {
       /* If stepping did not change the value, omit this direction */
       continue;
     }
 
-    aatMeasure(a, b, &amp, &phs, &tuningStatus->measureCnt);
-    f = aatCalcF(tuningParams, amp, phs);
-    st25r3918AatLog("%d : %d %d: %d", i, a, b, f);
-    if (f < *f_min) {
-      /* Value is better than all previous ones */
-      st25r3918AatLog("*");
-      *f_min = f;
-      bestdir = i;
-    }
-    st25r3918AatLog("\n");
+    aatMeasureSet(a, b);
+    return ERR_BUSY;
   }
-  if (0 != bestdir) {
+
+  gAat.direction = gAat.bestdir;
+  if (0 != gAat.bestdir) {
     /* Walk into the best direction */
-    aatStepDacVals(tuningParams, &tuningStatus->aat_a, &tuningStatus->aat_b, bestdir);
+    aatStepDacVals(&gAat.tp, &gAat.ts.aat_a, &gAat.ts.aat_b, gAat.bestdir);
+    gAat.ts.amp = gAat.bestAmp;
+    gAat.ts.pha = gAat.bestPha;
+  }
+  if (gAat.ts.measureCnt > gAat.tp.measureLimit) {
+    gAat.err = ERR_OVERRUN;
+    gAat.direction = 0; /* Leave this step size */
+    return aatDescentDone();
   }
-  return bestdir;
+
+  gAat.state = ST25R3918_AAT_ST_GREEDY;
+  return aatGreedyNext();
 }
 
 /*******************************************************************************/
-int32_t RfalRfST25R3918Class::aatGreedyDescent(uint32_t *f_min, const struct st25r3918AatTuneParams *tuningParams, struct st25r3918AatTuneResult *tuningStatus, int32_t previousDir)
+ReturnCode RfalRfST25R3918Class::aatGreedyNext(void)
 {
-  uint8_t amp, phs;
-  uint32_t f;
-  uint8_t a = tuningStatus->aat_a, b = tuningStatus->aat_b;
+  uint8_t a = gAat.ts.aat_a, b = gAat.ts.aat_b;
 
-  if (0U != aatStepDacVals(tuningParams, &a, &b, previousDir)) {
+  if (ERR_NONE != aatStepDacVals(&gAat.tp, &a, &b, gAat.direction)) {
     /* If stepping did not change the value, omit this direction */
-    return 0;
+    if (gAat.ts.measureCnt > gAat.tp.measureLimit) {
+      gAat.err = ERR_OVERRUN;
+    }
+    return aatDescentDone();
   }
 
-  aatMeasure(a, b, &amp, &phs, &tuningStatus->measureCnt);
-  f = aatCalcF(tuningParams, amp, phs);
-  st25r3918AatLog("g : %d %d: %d", a, b, f);
-  if (f < *f_min) {
-    /* Value is better than previous one */
-    st25r3918AatLog("*\n");
-    tuningStatus->aat_a = a;
-    tuningStatus->aat_b = b;
-    *f_min = f;
-    return previousDir;
+  aatMeasureSet(a, b);
+  return ERR_BUSY;
+}
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::aatDescentDone(void)
+{
+  if (0 == gAat.direction) {
+    /* No better point at this step size: reduce step sizes */
+    gAat.tp.aat_a_stepWidth /= 2U;
+    gAat.tp.aat_b_stepWidth /= 2U;
+    if (!gAat.tp.doDynamicSteps || ((gAat.tp.aat_a_stepWidth == 0U) && (gAat.tp.aat_b_stepWidth == 0U))) {
+      return gAat.err;
+    }
   }
 
-  st25r3918AatLog("\n");
-  return 0;
+  /* After reducing step sizes we don't have a previous direction */
+  gAat.dir     = -2;
+  gAat.bestdir = 0;
+  gAat.state   = ST25R3918_AAT_ST_STEEPEST;
+  return aatSteepestNext();
 }
 
 /*******************************************************************************/
@@ -298,27 +395,14 @@ ReturnCode RfalRfST25R3918Class::aatStepDacVals(const struct st25r3918AatTunePar
 }
 
 /*******************************************************************************/
-ReturnCode RfalRfST25R3918Class::aatMeasure(uint8_t serCap, uint8_t parCap, uint8_t *amplitude, uint8_t *phase, uint16_t *measureCnt)
+void RfalRfST25R3918Class::aatMeasureSet(uint8_t serCap, uint8_t parCap)
 {
-  ReturnCode err;
-
-  *amplitude = 0;
-  *phase     = 0;
+  gAat.a = serCap;
+  gAat.b = parCap;
 
   st25r3918WriteRegister(ST25R3918_REG_ANT_TUNE_A, serCap);
   st25r3918WriteRegister(ST25R3918_REG_ANT_TUNE_B, parCap);
 
-  /* Wait till caps have settled.. */
-  delay(ST25R3918_AAT_CAP_DELAY_MAX);
-
-  /* Get amplitude and phase .. */
-  err = rfalChipMeasureAmplitude(amplitude);
-  if (ERR_NONE == err) {
-    err = rfalChipMeasurePhase(phase);
-  }
-
-  if (measureCnt != NULL) {
-    (*measureCnt)++;
-  }
-  return err;
+  /* Wait till caps have settled: st25r3918AatGetStatus() measures once the timer expires */
+  rfalTimerStartUs(gAat.tmr, (ST25R3918_AAT_CAP_DELAY_MAX * RFAL_US_IN_MS));
 }
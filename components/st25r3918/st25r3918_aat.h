@@ -84,4 +84,36 @@ struct st25r3918AatTuneResult {
 };
 
 
+/*!
+ * states of a non-blocking tuning or measurement
+ */
+enum st25r3918AatState {
+  ST25R3918_AAT_ST_IDLE,        /*!< nothing running */
+  ST25R3918_AAT_ST_MEASURE,     /*!< single measurement at given caps */
+  ST25R3918_AAT_ST_START,       /*!< hill climb: measuring the start point */
+  ST25R3918_AAT_ST_STEEPEST,    /*!< hill climb: measuring all directions around the current point */
+  ST25R3918_AAT_ST_GREEDY,      /*!< hill climb: walking on in the best direction */
+};
+
+
+/*!
+ * context of a non-blocking tuning or measurement, one step per settled measurement
+ */
+struct st25r3918AatCtx {
+  enum st25r3918AatState state; /*!< current state */
+  struct st25r3918AatTuneParams tp; /*!< working copy of the params, step widths get reduced */
+  struct st25r3918AatTuneResult ts; /*!< best point so far */
+  uint32_t f_min;               /*!< cost of the best point */
+  int32_t direction;            /*!< direction of the last steepest descent */
+  int32_t dir;                  /*!< direction being measured by the steepest descent */
+  int32_t bestdir;              /*!< best direction of the steepest descent so far */
+  uint8_t bestAmp;              /*!< amplitude in bestdir */
+  uint8_t bestPha;              /*!< phase in bestdir */
+  uint8_t a;                    /*!< serial cap being measured */
+  uint8_t b;                    /*!< parallel cap being measured */
+  uint32_t tmr;                 /*!< cap settle timer (us) */
+  ReturnCode err;               /*!< error to report once done */
+};
+
+
 #endif /* ST25R3918_AAT_H */
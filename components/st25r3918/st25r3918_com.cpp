@@ -72,6 +72,8 @@
 * LOCAL FUNCTION PROTOTYPES
 ******************************************************************************
 */
+static bool st25r3918CmdListIsGapReadable(uint8_t from, uint8_t to);
+static bool st25r3918I2CReadIsDestructive(uint8_t prefix, uint8_t op, uint16_t len);
 
 
 /*
@@ -89,31 +91,12 @@ ReturnCode RfalRfST25R3918Class::st25r3918ReadRegister(uint8_t reg, uint8_t *val
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::st25r3918ReadMultipleRegisters(uint8_t reg, uint8_t *values, uint8_t length)
 {
-  if (length > 0U) {
-    bus_busy = true;
-    dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-    /* If is a space-B register send a direct command first */
-    if ((reg & ST25R3918_SPACE_B) != 0U) {
-      dev_i2c->write(ST25R3918_CMD_SPACE_B_ACCESS);
-    }
-
-    dev_i2c->write((reg & ~ST25R3918_SPACE_B) | ST25R3918_READ_MODE);
-    dev_i2c->endTransmission(false);
-    dev_i2c->requestFrom(((uint8_t)(ST25R3918_I2C_ADDR & 0x7F)), (uint8_t) length);
-
-    int i = 0;
-    while (dev_i2c->available()) {
-      values[i] = dev_i2c->read();
-      i++;
-    }
-    bus_busy = false;
-    if (isr_pending) {
-      st25r3918Isr();
-      isr_pending = false;
-    }
+  if (length == 0U) {
+    return ERR_NONE;
   }
 
-  return ERR_NONE;
+  /* If is a space-B register send a direct command first */
+  return st25r3918I2CTransfer((((reg & ST25R3918_SPACE_B) != 0U) ? ST25R3918_CMD_SPACE_B_ACCESS : 0U), ((reg & ~ST25R3918_SPACE_B) | ST25R3918_READ_MODE), NULL, 0U, values, length);
 }
 
 
@@ -128,53 +111,33 @@ ReturnCode RfalRfST25R3918Class::st25r3918WriteRegister(uint8_t reg, uint8_t val
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::st25r3918WriteMultipleRegisters(uint8_t reg, const uint8_t *values, uint8_t length)
 {
-  if (length > 0U) {
-    bus_busy = true;
-    dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-    /* If is a space-B register send a direct command first */
-    if ((reg & ST25R3918_SPACE_B) != 0U) {
-      dev_i2c->write(ST25R3918_CMD_SPACE_B_ACCESS);
-    }
-
-    dev_i2c->write((reg & ~ST25R3918_SPACE_B) | ST25R3918_WRITE_MODE);
-
-    for (uint16_t i = 0 ; i < length ; i++) {
-      dev_i2c->write(values[i]);
-    }
-    dev_i2c->endTransmission(true);
-    bus_busy = false;
-    if (isr_pending) {
-      st25r3918Isr();
-      isr_pending = false;
-    }
+  if (length == 0U) {
+    return ERR_NONE;
   }
 
-  return ERR_NONE;
+  /* If is a space-B register send a direct command first */
+  return st25r3918I2CTransfer((((reg & ST25R3918_SPACE_B) != 0U) ? ST25R3918_CMD_SPACE_B_ACCESS : 0U), ((reg & ~ST25R3918_SPACE_B) | ST25R3918_WRITE_MODE), values, length, NULL, 0U);
 }
 
 
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::st25r3918WriteFifo(const uint8_t *values, uint16_t length)
 {
+  ReturnCode ret;
+  uint16_t   burst;
+  uint16_t   done;
+
   if (length > ST25R3918_FIFO_DEPTH) {
     return ERR_PARAM;
   }
 
-  if (length > 0U) {
-    bus_busy = true;
-    dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
+  /* The FIFO content changes: a status snapshot taken with the IRQs is stale */
+  st25r3918interrupt.fifoStatusValid = false;
 
-    dev_i2c->write(ST25R3918_FIFO_LOAD);
-
-    for (uint16_t i = 0 ; i < length ; i++) {
-      dev_i2c->write(values[i]);
-    }
-    dev_i2c->endTransmission(true);
-    bus_busy = false;
-    if (isr_pending) {
-      st25r3918Isr();
-      isr_pending = false;
-    }
+  /* Consecutive FIFO loads append, so load in bursts that fit one I2C transaction */
+  for (done = 0U; done < length; done += burst) {
+    burst = (uint16_t)MIN((uint16_t)(length - done), ST25R3918_I2C_TX_BURST_LEN);
+    EXIT_ON_ERR(ret, st25r3918I2CTransfer(0U, ST25R3918_FIFO_LOAD, &values[done], burst, NULL, 0U));
   }
 
   return ERR_NONE;
@@ -184,23 +147,17 @@ ReturnCode RfalRfST25R3918Class::st25r3918WriteFifo(const uint8_t *values, uint1
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::st25r3918ReadFifo(uint8_t *buf, uint16_t length)
 {
-  if (length > 0U) {
-    bus_busy = true;
-    dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-    dev_i2c->write(ST25R3918_FIFO_READ);
-    dev_i2c->endTransmission(false);
-    dev_i2c->requestFrom(((uint8_t)(ST25R3918_I2C_ADDR & 0x7F)), (uint8_t) length);
+  ReturnCode ret;
+  uint16_t   burst;
+  uint16_t   done;
 
-    int i = 0;
-    while (dev_i2c->available()) {
-      buf[i] = dev_i2c->read();
-      i++;
-    }
-    bus_busy = false;
-    if (isr_pending) {
-      st25r3918Isr();
-      isr_pending = false;
-    }
+  st25r3918interrupt.fifoStatusValid = false;
+
+  /* Consecutive FIFO reads continue where the last one stopped, so read in bursts *
+   * that fit one I2C transaction. Without buf the bytes are drained and discarded */
+  for (done = 0U; done < length; done += burst) {
+    burst = (uint16_t)MIN((uint16_t)(length - done), ST25R3918_I2C_RX_BURST_LEN);
+    EXIT_ON_ERR(ret, st25r3918I2CTransfer(0U, ST25R3918_FIFO_READ, NULL, 0U, ((buf != NULL) ? &buf[done] : NULL), burst));
   }
 
   return ERR_NONE;
@@ -214,61 +171,34 @@ ReturnCode RfalRfST25R3918Class::st25r3918WritePTMem(const uint8_t *values, uint
     return ERR_PARAM;
   }
 
-  if (length > 0U) {
-    bus_busy = true;
-    dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-
-    dev_i2c->write(ST25R3918_PT_A_CONFIG_LOAD);
-
-    for (uint16_t i = 0 ; i < length ; i++) {
-      dev_i2c->write(values[i]);
-    }
-    dev_i2c->endTransmission(true);
-    bus_busy = false;
-    if (isr_pending) {
-      st25r3918Isr();
-      isr_pending = false;
-    }
+  if (length == 0U) {
+    return ERR_NONE;
   }
 
-  return ERR_NONE;
+  return st25r3918I2CTransfer(0U, ST25R3918_PT_A_CONFIG_LOAD, values, length, NULL, 0U);
 }
 
 
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::st25r3918ReadPTMem(uint8_t *values, uint16_t length)
 {
-  uint8_t tmp[ST25R3918_REG_LEN + ST25R3918_PTM_LEN];  /* local buffer to handle prepended byte on I2C */
-
-  if (length > 0U) {
-    if (length > ST25R3918_PTM_LEN) {
-      return ERR_PARAM;
-    }
-
-    bus_busy = true;
+  uint8_t    tmp[ST25R3918_REG_LEN + ST25R3918_PTM_LEN];  /* local buffer to handle prepended byte on I2C */
+  ReturnCode ret;
 
-    dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-    dev_i2c->write(ST25R3918_PT_MEM_READ);
-    dev_i2c->endTransmission(false);
-    dev_i2c->requestFrom(((uint8_t)(ST25R3918_I2C_ADDR & 0x7F)), (uint8_t)(ST25R3918_REG_LEN + length));
+  if (length == 0U) {
+    return ERR_NONE;
+  }
 
-    int i = 0;
-    while (dev_i2c->available()) {
-      tmp[i] = dev_i2c->read();
-      i++;
-    }
+  if (length > ST25R3918_PTM_LEN) {
+    return ERR_PARAM;
+  }
 
-    /* Copy PTMem content without prepended byte */
-    ST_MEMCPY(values, (tmp + ST25R3918_REG_LEN), length);
+  ret = st25r3918I2CTransfer(0U, ST25R3918_PT_MEM_READ, NULL, 0U, tmp, (uint16_t)(ST25R3918_REG_LEN + length));
 
-    bus_busy = false;
-    if (isr_pending) {
-      st25r3918Isr();
-      isr_pending = false;
-    }
-  }
+  /* Copy PTMem content without prepended byte */
+  ST_MEMCPY(values, (tmp + ST25R3918_REG_LEN), length);
 
-  return ERR_NONE;
+  return ret;
 }
 
 
@@ -279,24 +209,11 @@ ReturnCode RfalRfST25R3918Class::st25r3918WritePTMemF(const uint8_t *values, uin
     return ERR_PARAM;
   }
 
-  if (length > 0U) {
-    bus_busy = true;
-    dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-
-    dev_i2c->write(ST25R3918_PT_F_CONFIG_LOAD);
-
-    for (uint16_t i = 0 ; i < length ; i++) {
-      dev_i2c->write(values[i]);
-    }
-    dev_i2c->endTransmission(true);
-    bus_busy = false;
-    if (isr_pending) {
-      st25r3918Isr();
-      isr_pending = false;
-    }
+  if (length == 0U) {
+    return ERR_NONE;
   }
 
-  return ERR_NONE;
+  return st25r3918I2CTransfer(0U, ST25R3918_PT_F_CONFIG_LOAD, values, length, NULL, 0U);
 }
 
 
@@ -307,94 +224,43 @@ ReturnCode RfalRfST25R3918Class::st25r3918WritePTMemTSN(const uint8_t *values, u
     return ERR_PARAM;
   }
 
-  if (length > 0U) {
-    bus_busy = true;
-    dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-
-    dev_i2c->write(ST25R3918_PT_TSN_DATA_LOAD);
-
-    for (uint16_t i = 0 ; i < length ; i++) {
-      dev_i2c->write(values[i]);
-    }
-    dev_i2c->endTransmission(true);
-    bus_busy = false;
-    if (isr_pending) {
-      st25r3918Isr();
-      isr_pending = false;
-    }
+  if (length == 0U) {
+    return ERR_NONE;
   }
 
-  return ERR_NONE;
+  return st25r3918I2CTransfer(0U, ST25R3918_PT_TSN_DATA_LOAD, values, length, NULL, 0U);
 }
 
 
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::st25r3918ExecuteCommand(uint8_t cmd)
 {
-  bus_busy = true;
-  dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-
-  dev_i2c->write((cmd | ST25R3918_CMD_MODE));
-
-  dev_i2c->endTransmission(true);
-
-  bus_busy = false;
-  if (isr_pending) {
-    st25r3918Isr();
-    isr_pending = false;
-  }
+  /* Commands clear, transmit or receive into the FIFO: drop the status snapshot */
+  st25r3918interrupt.fifoStatusValid = false;
 
-  return ERR_NONE;
+  return st25r3918I2CTransfer(0U, (cmd | ST25R3918_CMD_MODE), NULL, 0U, NULL, 0U);
 }
 
 
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::st25r3918ReadTestRegister(uint8_t reg, uint8_t *val)
 {
-  bus_busy = true;
-  dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-
-  dev_i2c->write(ST25R3918_CMD_TEST_ACCESS);
-  dev_i2c->write((reg | ST25R3918_READ_MODE));
-  dev_i2c->endTransmission(false);
-  dev_i2c->requestFrom(((uint8_t)(ST25R3918_I2C_ADDR & 0x7F)), ST25R3918_REG_LEN);
-
-  if (dev_i2c->available()) {
-    *val = dev_i2c->read();
-  }
-
-  bus_busy = false;
-  if (isr_pending) {
-    st25r3918Isr();
-    isr_pending = false;
-  }
-
-  return ERR_NONE;
+  return st25r3918I2CTransfer(ST25R3918_CMD_TEST_ACCESS, (reg | ST25R3918_READ_MODE), NULL, 0U, val, ST25R3918_REG_LEN);
 }
 
 
 /*******************************************************************************/
 ReturnCode RfalRfST25R3918Class::st25r3918WriteTestRegister(uint8_t reg, uint8_t val)
 {
-  bus_busy = true;
-
-  dev_i2c->beginTransmission((uint8_t)(ST25R3918_I2C_ADDR & 0x7F));
-
-  dev_i2c->write(ST25R3918_CMD_TEST_ACCESS);
-
-  dev_i2c->write((reg | ST25R3918_WRITE_MODE));
-
-  dev_i2c->write(val);
-
-  dev_i2c->endTransmission(true);
+  uint8_t value = val;               /* MISRA 17.8: use intermediate variable */
+  return st25r3918I2CTransfer(ST25R3918_CMD_TEST_ACCESS, (reg | ST25R3918_WRITE_MODE), &value, ST25R3918_REG_LEN, NULL, 0U);
+}
 
-  bus_busy = false;
-  if (isr_pending) {
-    st25r3918Isr();
-    isr_pending = false;
-  }
 
-  return ERR_NONE;
+/*******************************************************************************/
+const st25r3918BusStats *RfalRfST25R3918Class::st25r3918GetBusStats(void)
+{
+  return &gBusStats;
 }
 
 
@@ -512,8 +378,482 @@ bool RfalRfST25R3918Class::st25r3918IsRegValid(uint8_t reg)
   return true;
 }
 
+
+/*******************************************************************************/
+void RfalRfST25R3918Class::st25r3918CmdListInit(st25r3918CmdList *list)
+{
+  list->len      = 0U;
+  list->segStart = 0U;
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918CmdListWrite(st25r3918CmdList *list, uint8_t reg, uint8_t val)
+{
+  /* A write is a modify clearing all bits: no read required */
+  return st25r3918CmdListModify(list, reg, 0xFFU, val);
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918CmdListModify(st25r3918CmdList *list, uint8_t reg, uint8_t clr_mask, uint8_t set_mask)
+{
+  uint8_t i;
+
+  if (!st25r3918IsRegValid(reg)) {
+    return ERR_PARAM;
+  }
+
+  /* Merge with a previous operation on the same register since the last barrier */
+  for (i = list->segStart; i < list->len; i++) {
+    if ((list->ops[i].type == (uint8_t)ST25R3918_CMDLIST_OP_REG) && (list->ops[i].reg == reg)) {
+      list->ops[i].setMask  = (uint8_t)((list->ops[i].setMask & ~clr_mask) | set_mask);
+      list->ops[i].clrMask |= clr_mask;
+      return ERR_NONE;
+    }
+  }
+
+  return st25r3918CmdListAppend(list, (uint8_t)ST25R3918_CMDLIST_OP_REG, reg, clr_mask, set_mask);
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918CmdListChangeBits(st25r3918CmdList *list, uint8_t reg, uint8_t valueMask, uint8_t value)
+{
+  return st25r3918CmdListModify(list, reg, valueMask, (valueMask & value));
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918CmdListChangeTestBits(st25r3918CmdList *list, uint8_t reg, uint8_t valueMask, uint8_t value)
+{
+  return st25r3918CmdListAppend(list, (uint8_t)ST25R3918_CMDLIST_OP_TEST, reg, valueMask, (valueMask & value));
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918CmdListCommand(st25r3918CmdList *list, uint8_t cmd)
+{
+  return st25r3918CmdListAppend(list, (uint8_t)ST25R3918_CMDLIST_OP_CMD, cmd, 0U, 0U);
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918CmdListExecute(st25r3918CmdList *list)
+{
+  ReturnCode ret;
+  uint8_t    start;
+  uint8_t    end;
+
+  ret   = ERR_NONE;
+  start = 0U;
+
+  while ((start < list->len) && (ret == ERR_NONE)) {
+    /* Find the end of the current segment (next barrier or end of list) */
+    end = start;
+    while ((end < list->len) && (list->ops[end].type == (uint8_t)ST25R3918_CMDLIST_OP_REG)) {
+      end++;
+    }
+
+    if (end > start) {
+      ret = st25r3918CmdListExecuteRegs(&list->ops[start], (uint8_t)(end - start));
+    }
+
+    /* Execute the barrier itself */
+    if ((end < list->len) && (ret == ERR_NONE)) {
+      if (list->ops[end].type == (uint8_t)ST25R3918_CMDLIST_OP_CMD) {
+        ret = st25r3918ExecuteCommand(list->ops[end].reg);
+      } else {
+        ret = st25r3918ChangeTestRegisterBits(list->ops[end].reg, list->ops[end].clrMask, list->ops[end].setMask);
+      }
+      end++;
+    }
+    start = end;
+  }
+
+  st25r3918CmdListInit(list);
+  return ret;
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918CmdListAppend(st25r3918CmdList *list, uint8_t type, uint8_t reg, uint8_t clr_mask, uint8_t set_mask)
+{
+  ReturnCode ret;
+
+  /* No room left: execute what has been recorded so far, order is kept */
+  if (list->len >= ST25R3918_CMDLIST_MAX_OPS) {
+    EXIT_ON_ERR(ret, st25r3918CmdListExecute(list));
+  }
+
+  list->ops[list->len].type    = type;
+  list->ops[list->len].reg     = reg;
+  list->ops[list->len].clrMask = clr_mask;
+  list->ops[list->len].setMask = set_mask;
+  list->len++;
+
+  /* Nothing may be merged across a barrier */
+  if (type != (uint8_t)ST25R3918_CMDLIST_OP_REG) {
+    list->segStart = list->len;
+  }
+
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918CmdListExecuteRegs(const st25r3918CmdListOp *ops, uint8_t len)
+{
+  ReturnCode ret;
+  uint8_t    idx[ST25R3918_CMDLIST_MAX_OPS];   /* ops indexes sorted by register address   */
+  uint8_t    val[ST25R3918_CMDLIST_MAX_OPS];   /* value to be written, in sorted order      */
+  bool       wr[ST25R3918_CMDLIST_MAX_OPS];    /* register has to be written, sorted order  */
+  uint8_t    buf[ST25R3918_CMDLIST_MAX_OPS];   /* burst buffer                              */
+  uint8_t    i;
+  uint8_t    j;
+  uint8_t    k;
+  uint8_t    tmp;
+  uint8_t    first;
+  uint8_t    last;
+  uint8_t    rdVal;
+
+  /* Sort by register address (insertion sort, registers are unique within a segment) */
+  for (i = 0U; i < len; i++) {
+    j = i;
+    while ((j > 0U) && (ops[idx[j - 1U]].reg > ops[i].reg)) {
+      idx[j] = idx[j - 1U];
+      j--;
+    }
+    idx[j] = i;
+  }
+
+  /* Plain writes need no read */
+  for (i = 0U; i < len; i++) {
+    val[i] = ops[idx[i]].setMask;
+    wr[i]  = (ops[idx[i]].clrMask == 0xFFU);
+  }
+
+  /*******************************************************************************/
+  /* Read the registers to be modified, merging close registers in one burst     */
+  i = 0U;
+  while (i < len) {
+    if (ops[idx[i]].clrMask == 0xFFU) {
+      i++;
+      continue;
+    }
+
+    first = ops[idx[i]].reg;
+    last  = first;
+    j     = (uint8_t)(i + 1U);
+    while (j < len) {
+      tmp = ops[idx[j]].reg;
+      if (ops[idx[j]].clrMask != 0xFFU) {
+        if (((tmp & ST25R3918_SPACE_B) != (first & ST25R3918_SPACE_B))           ||
+            ((uint8_t)(tmp - last) > (ST25R3918_CMDLIST_READ_GAP + 1U))          ||
+            ((uint8_t)(tmp - first) >= ST25R3918_CMDLIST_MAX_OPS)                ||
+            !st25r3918CmdListIsGapReadable(last, tmp)) {
+          break;
+        }
+        last = tmp;
+      }
+      j++;
+    }
+
+    EXIT_ON_ERR(ret, st25r3918ReadMultipleRegisters(first, buf, (uint8_t)((last - first) + 1U)));
+
+    for (k = i; (k < len) && (ops[idx[k]].reg <= last); k++) {
+      if (ops[idx[k]].clrMask == 0xFFU) {
+        continue;
+      }
+
+      rdVal   = buf[ops[idx[k]].reg - first];
+      val[k]  = (uint8_t)(rdVal & ~ops[idx[k]].clrMask);
+      val[k] |= ops[idx[k]].setMask;
+
+      /* Only perform a Write if the value to be written is different */
+      wr[k]   = (!ST25R3918_OPTIMIZE || (rdVal != val[k]));
+    }
+    i = k;
+  }
+
+  /*******************************************************************************/
+  /* Write the registers, consecutive addresses in one auto-increment burst      */
+  i = 0U;
+  while (i < len) {
+    if (!wr[i]) {
+      i++;
+      continue;
+    }
+
+    first  = ops[idx[i]].reg;
+    buf[0] = val[i];
+    j      = (uint8_t)(i + 1U);
+    while ((j < len) && wr[j] && (ops[idx[j]].reg == (uint8_t)(ops[idx[j - 1U]].reg + 1U)) &&
+           ((ops[idx[j]].reg & ST25R3918_SPACE_B) == (first & ST25R3918_SPACE_B))) {
+      buf[j - i] = val[j];
+      j++;
+    }
+
+    EXIT_ON_ERR(ret, st25r3918WriteMultipleRegisters(first, buf, (uint8_t)(j - i)));
+    i = j;
+  }
+
+  return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R3918Class::st25r3918I2CTransfer(uint8_t prefix, uint8_t op, const uint8_t *txData, uint16_t txLen, uint8_t *rxData, uint16_t rxLen)
+{
+  ReturnCode ret;
+  uint8_t    attempt;
+  uint8_t    status;
+  uint16_t   len;
+  uint8_t    buf[ST25R3918_I2C_BUF_LEN];
+
+  if ((txLen > ST25R3918_I2C_TX_BURST_LEN) || (rxLen > ST25R3918_I2C_RX_BURST_LEN)) {
+    return ERR_PARAM;
+  }
+
+  bus_busy = true;
+  rfalTraceMark(this, RFAL_TRACE_BEGIN, RFAL_TRACE_EV_COM, op);
+
+  ret = ERR_IO;
+  for (attempt = 0U; attempt <= ST25R3918_I2C_RETRIES; attempt++) {
+    if (attempt > 0U) {
+      gBusStats.retries++;
+    }
+
+    /* Prefix, operation and payload go out in one write (rebuilt: a discarded read reuses buf) */
+    len = 0U;
+    if (prefix != 0U) {
+      buf[len++] = prefix;
+    }
+    buf[len++] = op;
+    if (txLen != 0U) {
+      ST_MEMCPY(&buf[len], txData, txLen);
+      len += txLen;
+    }
+
+    if (rxLen == 0U) {
+      /* Write: the chip has to acknowledge address and every byte */
+      status = dev_i2c->write(buf, len);
+      st25r3918TraceLog(((status == ST25R3918_I2C_OK) ? ST25R3918_TRACE_WRITE : ST25R3918_TRACE_WRITE_NACK), prefix, op, txData, txLen);
+      if (status == ST25R3918_I2C_OK) {
+        ret = ERR_NONE;
+        break;
+      }
+      gBusStats.nacks++;
+      continue;
+    }
+
+    /* Read: opcode, repeated start and exactly rxLen bytes in one transaction *
+     * (no rxData: bytes drained from the FIFO into buf and discarded)         */
+    status = dev_i2c->writeRead(buf, len, ((rxData != NULL) ? rxData : buf), rxLen);
+    if (status == ST25R3918_I2C_OK) {
+      st25r3918TraceLog(ST25R3918_TRACE_READ, prefix, op, rxData, rxLen);
+      ret = ERR_NONE;
+      break;
+    }
+    if (status == ST25R3918_I2C_NACK) {
+      /* Opcode not taken, nothing was clocked out: safe to repeat */
+      st25r3918TraceLog(ST25R3918_TRACE_WRITE_NACK, prefix, op, NULL, 0U);
+      gBusStats.nacks++;
+      continue;
+    }
+    st25r3918TraceLog(ST25R3918_TRACE_READ, prefix, op, NULL, 0U);
+    gBusStats.shortReads++;
+    /* An unknown number of bytes were popped from the FIFO or cleared from the IRQ *
+     * registers: repeating would silently lose them, report the failure instead    */
+    if (st25r3918I2CReadIsDestructive(prefix, op, rxLen)) {
+      break;
+    }
+  }
+
+  if (ret == ERR_NONE) {
+    gBusStats.consecutive = 0U;
+  } else {
+    /* Never hand stale bytes to the caller as register content */
+    if (rxData != NULL) {
+      ST_MEMSET(rxData, 0x00, rxLen);
+    }
+    gBusStats.failures++;
+    gBusStats.consecutive++;
+  }
+
+  rfalTraceMark(this, RFAL_TRACE_END, RFAL_TRACE_EV_COM, ret);
+  bus_busy = false;
+  if (isr_pending) {
+    st25r3918Isr();
+    isr_pending = false;
+  }
+
+  return ret;
+}
+
+#ifdef ST25R3918_TRACE
+/*******************************************************************************/
+void RfalRfST25R3918Class::st25r3918TraceRecord(uint8_t type, uint8_t prefix, uint8_t op, const uint8_t *data, uint16_t len)
+{
+  uint8_t  hdr[ST25R3918_TRACE_REC_HDR_LEN + 2U];
+  uint8_t  hdrLen;
+  uint32_t recLen;
+  uint32_t now;
+  uint32_t pos;
+  uint32_t i;
+
+  /* Record header: opcode bytes are present on bus transactions only */
+  hdrLen = 0U;
+  if (type != ST25R3918_TRACE_IRQ) {
+    if (prefix != 0U) {
+      hdr[ST25R3918_TRACE_REC_HDR_LEN + hdrLen++] = prefix;
+    }
+    hdr[ST25R3918_TRACE_REC_HDR_LEN + hdrLen++] = op;
+  }
+
+  now    = micros();
+  hdr[0] = (uint8_t)((type << 4) | hdrLen);
+  hdr[1] = (uint8_t)(now >> 0U);
+  hdr[2] = (uint8_t)(now >> 8U);
+  hdr[3] = (uint8_t)(now >> 16U);
+  hdr[4] = (uint8_t)(now >> 24U);
+  hdr[5] = (uint8_t)(len >> 0U);
+  hdr[6] = (uint8_t)(len >> 8U);
+
+  recLen = (ST25R3918_TRACE_REC_HDR_LEN + (uint32_t)hdrLen + (uint32_t)len);
+  if (recLen > ST25R3918_TRACE_SIZE) {
+    gTrace.dropped++;
+    return;
+  }
+
+  /* Overwrite the oldest records until the new one fits */
+  while ((ST25R3918_TRACE_SIZE - gTrace.used) < recLen) {
+    uint32_t oldLen;
+
+    oldLen  = (ST25R3918_TRACE_REC_HDR_LEN + (gTrace.buf[gTrace.tail] & 0x0FU));
+    oldLen += gTrace.buf[(gTrace.tail + 5U) % ST25R3918_TRACE_SIZE];
+    oldLen += ((uint32_t)gTrace.buf[(gTrace.tail + 6U) % ST25R3918_TRACE_SIZE] << 8U);
+
+    gTrace.tail  = ((gTrace.tail + oldLen) % ST25R3918_TRACE_SIZE);
+    gTrace.used -= oldLen;
+    gTrace.dropped++;
+  }
+
+  pos = ((gTrace.tail + gTrace.used) % ST25R3918_TRACE_SIZE);
+  for (i = 0; i < (ST25R3918_TRACE_REC_HDR_LEN + (uint32_t)hdrLen); i++) {
+    gTrace.buf[pos] = hdr[i];
+    pos = ((pos + 1U) % ST25R3918_TRACE_SIZE);
+  }
+  for (i = 0; i < len; i++) {
+    gTrace.buf[pos] = ((data != NULL) ? data[i] : 0U);   /* Discarded FIFO bytes are not kept */
+    pos = ((pos + 1U) % ST25R3918_TRACE_SIZE);
+  }
+  gTrace.used += recLen;
+}
+
+
+/*******************************************************************************/
+uint16_t RfalRfST25R3918Class::st25r3918TraceRead(uint8_t *buf, uint16_t len)
+{
+  uint16_t cnt;
+  uint32_t recLen;
+  uint32_t i;
+
+  cnt = 0U;
+  while (gTrace.used > 0U) {
+    recLen  = (ST25R3918_TRACE_REC_HDR_LEN + (gTrace.buf[gTrace.tail] & 0x0FU));
+    recLen += gTrace.buf[(gTrace.tail + 5U) % ST25R3918_TRACE_SIZE];
+    recLen += ((uint32_t)gTrace.buf[(gTrace.tail + 6U) % ST25R3918_TRACE_SIZE] << 8U);
+
+    /* Records are never split, a record larger than buf stays until a larger buf is given */
+    if (((uint32_t)cnt + recLen) > len) {
+      break;
+    }
+
+    for (i = 0; i < recLen; i++) {
+      buf[cnt++] = gTrace.buf[gTrace.tail];
+      gTrace.tail = ((gTrace.tail + 1U) % ST25R3918_TRACE_SIZE);
+    }
+    gTrace.used -= recLen;
+  }
+
+  return cnt;
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R3918Class::rfalTraceEvent(uint8_t phase, uint8_t id, uint8_t arg)
+{
+  st25r3918TraceRecord(ST25R3918_TRACE_EVENT, phase, id, &arg, 1U);
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R3918Class::rfalTraceState(uint8_t id, uint8_t *traced, uint8_t state)
+{
+  if (state == *traced) {
+    return;
+  }
+  if (*traced != 0U) {
+    st25r3918TraceRecord(ST25R3918_TRACE_EVENT, RFAL_TRACE_END, id, traced, 1U);
+  }
+  if (state != 0U) {
+    st25r3918TraceRecord(ST25R3918_TRACE_EVENT, RFAL_TRACE_BEGIN, id, &state, 1U);
+  }
+  *traced = state;
+}
+
+
+/*******************************************************************************/
+uint32_t RfalRfST25R3918Class::st25r3918TraceDropped(void)
+{
+  return gTrace.dropped;
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R3918Class::st25r3918TraceClear(void)
+{
+  gTrace.tail    = 0U;
+  gTrace.used    = 0U;
+  gTrace.dropped = 0U;
+}
+#endif /* ST25R3918_TRACE */
+
 /*
 ******************************************************************************
 * LOCAL FUNCTIONS
 ******************************************************************************
 */
+
+
+/*******************************************************************************/
+static bool st25r3918CmdListIsGapReadable(uint8_t from, uint8_t to)
+{
+  uint8_t reg;
+
+  /* Registers in between two needed ones are read only if reading has no side effect:
+   * the Interrupt registers are cleared on read                                      */
+  for (reg = (uint8_t)(from + 1U); reg < to; reg++) {
+    if ((((uint8_t)(reg & ~ST25R3918_SPACE_B)) >= ST25R3918_REG_IRQ_MAIN) && (((uint8_t)(reg & ~ST25R3918_SPACE_B)) <= ST25R3918_REG_IRQ_TARGET)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*******************************************************************************/
+/* A read that changes the chip state: the FIFO pops what it clocks out, the   *
+ * IRQ registers clear on read                                                  */
+static bool st25r3918I2CReadIsDestructive(uint8_t prefix, uint8_t op, uint16_t len)
+{
+  uint8_t reg;
+
+  if (op == ST25R3918_FIFO_READ) {
+    return true;
+  }
+  if ((prefix != 0U) || ((op & ST25R3918_CMD_MODE) != ST25R3918_READ_MODE)) {
+    return false;
+  }
+  reg = (uint8_t)(op & ~ST25R3918_CMD_MODE);
+  return ((reg <= ST25R3918_REG_IRQ_TARGET) && (((uint16_t)reg + len) > ST25R3918_REG_IRQ_MAIN));
+}
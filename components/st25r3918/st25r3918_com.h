@@ -986,6 +986,90 @@
 
 /*! \endcond DOXYGEN_SUPRESS */
 
+#define ST25R3918_CMDLIST_MAX_OPS                           24U      /*!< Max operations held by a register command list       */
+#define ST25R3918_CMDLIST_READ_GAP                          8U       /*!< Max unneeded registers read to merge two read bursts */
+
+#ifndef ST25R3918_TRACE_SIZE
+#define ST25R3918_TRACE_SIZE                                4096U    /*!< Bytes of the I2C trace ring (ST25R3918_TRACE builds)  */
+#endif
+#define ST25R3918_TRACE_REC_HDR_LEN                         7U       /*!< Trace record header: type/hdrLen, time (4), len (2)   */
+#define ST25R3918_TRACE_WRITE                               1U       /*!< Trace record: I2C write (register, FIFO, PT mem, cmd) */
+#define ST25R3918_TRACE_READ                                2U       /*!< Trace record: I2C read (opcode sent, bytes received)  */
+#define ST25R3918_TRACE_IRQ                                 3U       /*!< Trace record: IRQ pin sampled high                    */
+#define ST25R3918_TRACE_WRITE_NACK                          4U       /*!< Trace record: I2C write or read opcode not acknowledged */
+#define ST25R3918_TRACE_EVENT                               5U       /*!< Trace record: timeline event (phase, id), 1 byte arg  */
+
+#ifndef ST25R3918_I2C_RETRIES
+#define ST25R3918_I2C_RETRIES                               2U       /*!< Repetitions of a failed I2C transaction               */
+#endif
+
+#ifndef ST25R3918_I2C_BUF_LEN
+#define ST25R3918_I2C_BUF_LEN                               128U     /*!< Bytes per I2C transaction: st25r3918I2CTransfer() stack buffer, FIFO accesses are split to it */
+#endif
+#define ST25R3918_I2C_TX_BURST_LEN                          (ST25R3918_I2C_BUF_LEN - 2U) /*!< Data bytes per write: buffer less prefix and opcode */
+#define ST25R3918_I2C_RX_BURST_LEN                          ST25R3918_I2C_BUF_LEN        /*!< Bytes per read                                       */
+
+/*
+******************************************************************************
+* GLOBAL DATATYPES
+******************************************************************************
+*/
+
+/*! Register command list operation types */
+typedef enum {
+  ST25R3918_CMDLIST_OP_REG  = 0,                  /*!< Register write/modify: clrMask 0xFF means plain write          */
+  ST25R3918_CMDLIST_OP_TEST = 1,                  /*!< Test register change bits (ordering barrier)                   */
+  ST25R3918_CMDLIST_OP_CMD  = 2                   /*!< Direct command (ordering barrier)                              */
+} st25r3918CmdListOpType;
+
+/*! Register command list operation */
+typedef struct {
+  uint8_t type;                                   /*!< Operation type, see st25r3918CmdListOpType                     */
+  uint8_t reg;                                    /*!< Register address (incl. Space-B flag) or direct command        */
+  uint8_t clrMask;                                /*!< Bits to be cleared before setMask is applied                   */
+  uint8_t setMask;                                /*!< Bits to be set                                                 */
+} st25r3918CmdListOp;
+
+/*! Register command list: register accesses recorded to be executed as the fewest possible bus transactions.
+ *  Register operations between two barriers (direct command or test register) are merged per register and
+ *  may be reordered by address, so only order independent configuration must be recorded between barriers */
+typedef struct {
+  st25r3918CmdListOp ops[ST25R3918_CMDLIST_MAX_OPS]; /*!< Recorded operations                                        */
+  uint8_t            len;                         /*!< Number of recorded operations                                  */
+  uint8_t            segStart;                    /*!< Index of the first operation after the last barrier            */
+} st25r3918CmdList;
+
+/*! I2C transport counters. Every accessor returns ERR_IO once a transaction failed all its repetitions;
+ *  a FIFO or IRQ register read is not repeated once the chip may have clocked bytes out */
+typedef struct {
+  uint32_t           nacks;                       /*!< Attempts not acknowledged (address, opcode or data byte)       */
+  uint32_t           shortReads;                  /*!< Read attempts failed after the opcode (bus error or timeout)   */
+  uint32_t           retries;                     /*!< Attempts repeated after a failed one                           */
+  uint32_t           failures;                    /*!< Transactions failed after all repetitions                      */
+  uint32_t           consecutive;                 /*!< Failed transactions since the last successful one              */
+} st25r3918BusStats;
+
+/*! I2C transaction trace, a ring of variable length records, oldest records are overwritten.
+ *  Record: [type<<4 | hdrLen] [timestamp us, 4 bytes LE] [dataLen, 2 bytes LE] [hdr: prefix, opcode] [data]
+ *  Timeline events use the same layout with hdr [phase, id] and data [arg] */
+typedef struct {
+  uint8_t            buf[ST25R3918_TRACE_SIZE];   /*!< Record storage                                                 */
+  uint32_t           tail;                        /*!< Offset of the oldest record                                    */
+  uint32_t           used;                        /*!< Bytes in use                                                   */
+  uint32_t           dropped;                     /*!< Records lost (overwritten or too long)                         */
+} st25r3918Trace;
+
+/*
+******************************************************************************
+* GLOBAL MACROS
+******************************************************************************
+*/
+#ifdef ST25R3918_TRACE
+#define st25r3918TraceLog(type, prefix, op, data, len)  st25r3918TraceRecord((type), (prefix), (op), (data), (len)) /*!< Record an I2C trace entry */
+#else
+#define st25r3918TraceLog(type, prefix, op, data, len)                                                               /*!< I2C trace disabled        */
+#endif
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTION PROTOTYPES
@@ -3,35 +3,48 @@
 #include "esphome/core/application.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
 #include "rfal_nfcv.h"
 
-#include <Wire.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
-#include <Preferences.h>
+
+#ifdef USE_ESP32
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#endif
+#ifndef RTC_NOINIT_ATTR
+#define RTC_NOINIT_ATTR
+#endif
 
 namespace esphome {
 namespace st25r3918 {
 
 static const char *const TAG = "st25r3918";
 
-// Static instance for callback
-ST25R3918Component *ST25R3918Component::instance_ = nullptr;
+// Usage journals, one per reader (at most one reader per I2C controller). Not
+// cleared at boot: a soft reset or OTA reboot finds them as they were.
+static constexpr size_t USAGE_JOURNAL_SLOTS = 2;
+static RTC_NOINIT_ATTR UsageJournalData usage_journal_rtc[USAGE_JOURNAL_SLOTS];
+static bool usage_journal_claimed[USAGE_JOURNAL_SLOTS];
 
-// Static callback function for RFAL
-void ST25R3918Component::nfc_callback_(rfalNfcState state) {
-  if (instance_ != nullptr && instance_->rfal_nfc_ != nullptr) {
+// RFAL notification: ctx is the component that started the discovery
+void ST25R3918Component::nfc_callback_(void *ctx, rfalNfcState state) {
+  auto *self = static_cast<ST25R3918Component *>(ctx);
+  if (self != nullptr && self->rfal_nfc_ != nullptr) {
     rfalNfcDevice *dev = nullptr;
-    instance_->rfal_nfc_->rfalNfcGetActiveDevice(&dev);
-    instance_->handle_nfc_state_(state, dev);
+    self->rfal_nfc_->rfalNfcGetActiveDevice(&dev);
+    rfalTraceMark(self->rfal_hardware_, RFAL_TRACE_BEGIN, TRACE_EV_NFC_CALLBACK, state);
+    self->handle_nfc_state_(state, dev);
+    rfalTraceMark(self->rfal_hardware_, RFAL_TRACE_END, TRACE_EV_NFC_CALLBACK, state);
   }
 }
 
 void ST25R3918Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ST25R3918...");
 
-  instance_ = this;
-  this->boot_time_ = millis();
-
   // Setup IRQ pin
   if (this->irq_pin_ != nullptr) {
     this->irq_pin_->setup();
@@ -44,85 +57,255 @@ void ST25R3918Component::setup() {
 
   // Load usage data from flash
   this->load_usage_data_();
+
+  // Each reader has its own antenna, so its own key. Loaded before the worker
+  // context starts, which only compares against it from then on.
+  if (this->antenna_tuning_) {
+    this->antenna_pref_ =
+        global_preferences->make_preference<AntennaTune>(fnv1_hash(this->preference_id_ + "_aat"));
+    this->antenna_stored_valid_ = this->antenna_pref_.load(&this->antenna_stored_);
+  }
+  if (this->power_control_) {
+    this->power_pref_ =
+        global_preferences->make_preference<PowerSetpoint>(fnv1_hash(this->preference_id_ + "_rfo"));
+    PowerSetpoint stored;
+    if (this->power_pref_.load(&stored) && this->power_.restore(stored)) {
+      ESP_LOGCONFIG(TAG, "RF power restored: RFO %u", stored.rfo);
+    }
+  }
+
+  // Create RFAL objects
+  // Get IRQ pin number (required for interrupt-based operation)
+  if (this->irq_pin_ != nullptr) {
+    // Cast to InternalGPIOPin to access the pin number
+    auto *internal_pin = static_cast<InternalGPIOPin *>(this->irq_pin_);
+    this->irq_pin_num_ = internal_pin->get_pin();
+    ESP_LOGCONFIG(TAG, "Using IRQ pin: %d", this->irq_pin_num_);
+  } else {
+    ESP_LOGW(TAG, "No IRQ pin configured - interrupt handling may not work!");
+  }
+
+  this->construct_rfal_();
+
+  // The chip is probed and initialized from the worker context (dedicated task
+  // or loop()), so the rest of the ESPHome setup doesn't wait for it
+  if (this->dedicated_task_) {
+    if (this->nfc_task_.start(nfc_task_body_, this, this->task_core_)) {
+      ESP_LOGCONFIG(TAG, "NFC worker running in dedicated task on core %d", this->task_core_);
+    } else {
+      ESP_LOGW(TAG, "Failed to start NFC task - running worker from loop()");
+    }
+  }
 }
 
 void ST25R3918Component::loop() {
-  if (!this->initialized_ || this->rfal_nfc_ == nullptr) {
+  // In dedicated task mode the worker runs elsewhere, only consume its events here
+  if (this->nfc_task_.is_running()) {
+    NfcEvent event;
+    while (this->events_.pop(event)) {
+      this->apply_event_(event);
+    }
+    return;
+  }
+
+  this->worker_step_();
+}
+
+void ST25R3918Component::on_shutdown() { this->nfc_task_.stop(); }
+
+void ST25R3918Component::nfc_task_body_(void *arg) {
+  static_cast<ST25R3918Component *>(arg)->worker_step_();
+}
+
+// One pass of the worker context: chip bring-up until it is initialized, then
+// transport recovery and the RFAL worker
+void ST25R3918Component::worker_step_() {
+  this->mirror_bus_stats_();
+  if (!this->initialized_) {
+    this->init_step_();
     return;
   }
 
+#ifdef ST25R3918_TRACE
+  this->dump_trace_();
+#endif
+
+  this->check_bus_();
+  if (!this->initialized_) {
+    return;  // Chip being re-initialized
+  }
+
   // Run the RFAL worker to process NFC state machine
   this->rfal_nfc_->rfalNfcWorker();
 }
 
-void ST25R3918Component::update() {
-  // Wait 2 seconds after boot before initializing
-  if (!this->initialized_) {
-    uint32_t elapsed = millis() - this->boot_time_;
-    if (elapsed < 2000) {
-      return;
-    }
+// Transport recovery. Each transfer is already retried by the com layer, and
+// the I2C driver frees a bus held low by a slave when a transaction times out;
+// when transfers keep failing anyway, soft-reset and re-initialize the chip in place.
+void ST25R3918Component::check_bus_() {
+  uint32_t fails = this->rfal_hardware_->st25r3918GetBusStats()->consecutive;
+  if (fails < CHIP_REINIT_AFTER) {
+    return;
+  }
 
-    ESP_LOGI(TAG, "Initializing ST25R3918...");
-    if (this->init_rfal_()) {
-      this->initialized_ = true;
-      ESP_LOGI(TAG, "ST25R3918 initialized - ready for NFC tags");
-    } else {
-      ESP_LOGE(TAG, "ST25R3918 initialization failed - will retry");
-      this->boot_time_ = millis() - 2000 + 5000;
-    }
+  ESP_LOGW(TAG, "%u I2C transfers failed in a row - re-initializing the ST25R3918", (unsigned) fails);
+  this->chip_reinits_++;
+  this->initialized_ = false;
+  this->discovery_started_ = false;
+  // rfalInitialize() soft-resets the chip (SET_DEFAULT) once it answers again
+  this->destroy_rfal_();
+  this->construct_rfal_();
+  this->init_attempts_ = 0;
+  this->init_retry_at_ = millis();
+}
+
+// Publish the I2C counters of the current RFAL instance, plus the totals of
+// the ones before it, for the other contexts
+void ST25R3918Component::mirror_bus_stats_() {
+  const st25r3918BusStats *stats = this->rfal_hardware_->st25r3918GetBusStats();
+  this->i2c_errors_.store(this->i2c_errors_prior_ + stats->nacks + stats->shortReads, std::memory_order_relaxed);
+  this->i2c_failures_.store(this->i2c_failures_prior_ + stats->failures, std::memory_order_relaxed);
+  this->i2c_nacks_.store(stats->nacks, std::memory_order_relaxed);
+  this->i2c_short_reads_.store(stats->shortReads, std::memory_order_relaxed);
+  this->i2c_retries_.store(stats->retries, std::memory_order_relaxed);
+}
+
+#ifdef ST25R3918_TRACE
+// Drain the trace buffer as "TRACE:" hex lines; tools/st25r3918_trace.py turns
+// them back into a binary capture for the host replayer. Runs in the worker
+// context so no transaction is recorded while the buffer is read.
+void ST25R3918Component::dump_trace_() {
+  if (!this->trace_dump_requested_.exchange(false, std::memory_order_acq_rel)) {
     return;
   }
+  // Read whole records and log them in shorter lines
+  static const uint16_t TRACE_LINE_LEN = 96;
+  uint8_t *chunk = this->trace_chunk_;
+  char line[TRACE_LINE_LEN * 2 + 1];
+  uint32_t total = 0;
+
+  ESP_LOGI(TAG, "TRACE BEGIN dropped=%u", (unsigned) this->rfal_hardware_->st25r3918TraceDropped());
+  uint16_t len;
+  while ((len = this->rfal_hardware_->st25r3918TraceRead(chunk, sizeof(this->trace_chunk_))) > 0) {
+    for (uint16_t pos = 0; pos < len; pos += TRACE_LINE_LEN) {
+      uint16_t n = std::min<uint16_t>(TRACE_LINE_LEN, len - pos);
+      for (uint16_t i = 0; i < n; i++) {
+        sprintf(&line[i * 2], "%02X", chunk[pos + i]);
+      }
+      ESP_LOGI(TAG, "TRACE:%s", line);
+      yield();
+    }
+    total += len;
+  }
+  ESP_LOGI(TAG, "TRACE END bytes=%u", (unsigned) total);
+}
+#endif
 
-  // Update usage time tracking
+void ST25R3918Component::update() {
+  // Count heater on-time, also while the chip is down (bounds the micros() span)
   this->update_usage_time_();
 
-  // Publish sensor values
-  this->publish_sensors_();
+  if (!this->initialized_) {
+    return;
+  }
+
+  // Publish what changed, everything on the heartbeat
+  bool heartbeat = false;
+  if (this->heartbeat_interval_ > 0 && millis() - this->last_heartbeat_ >= this->heartbeat_interval_) {
+    this->last_heartbeat_ = millis();
+    heartbeat = true;
+  }
+  if (heartbeat || this->cart_dirty_ || this->presence_dirty_ || this->usage_dirty_) {
+    this->publish_sensors_(heartbeat);
+  }
+  this->publish_link_quality_();
+  this->publish_bus_errors_();
 }
 
-bool ST25R3918Component::init_rfal_() {
-  // Initialize Arduino Wire library with configured pins
-  ESP_LOGI(TAG, "Initializing Wire with SDA=%d, SCL=%d...", this->sda_pin_, this->scl_pin_);
-  Wire.begin(this->sda_pin_, this->scl_pin_);
-  Wire.setClock(100000);  // 100kHz
-
-  // Scan I2C bus
-  ESP_LOGI(TAG, "Scanning I2C bus...");
-  bool found = false;
-  for (uint8_t addr = 0x08; addr < 0x78; addr++) {
-    Wire.beginTransmission(addr);
-    if (Wire.endTransmission() == 0) {
-      ESP_LOGI(TAG, "  Device found at 0x%02X", addr);
-      if (addr == 0x50) {
-        found = true;
-      }
+// The RFAL objects (several KB, mostly RfalNfcClass) live in storage reserved
+// inside the component: no heap allocation, and nothing to leak on a retry.
+void ST25R3918Component::construct_rfal_() {
+  this->rfal_hardware_ = new (this->rfal_hardware_storage_) RfalRfST25R3918Class(&this->rfal_i2c_, this->irq_pin_num_);
+  this->rfal_nfc_ = new (this->rfal_nfc_storage_) RfalNfcClass(this->rfal_hardware_);
+  this->ndef_ = new (this->ndef_storage_) NdefClass(this->rfal_nfc_);
+}
+
+void ST25R3918Component::destroy_rfal_() {
+  if (this->rfal_hardware_ != nullptr) {
+    // Keep the I2C error totals across the rebuild
+    const st25r3918BusStats *stats = this->rfal_hardware_->st25r3918GetBusStats();
+    this->i2c_errors_prior_ += stats->nacks + stats->shortReads;
+    this->i2c_failures_prior_ += stats->failures;
+  }
+  if (this->ndef_ != nullptr) {
+    this->ndef_->~NdefClass();
+    this->ndef_ = nullptr;
+  }
+  if (this->rfal_nfc_ != nullptr) {
+    this->rfal_nfc_->~RfalNfcClass();
+    this->rfal_nfc_ = nullptr;
+  }
+  if (this->rfal_hardware_ != nullptr) {
+    this->rfal_hardware_->~RfalRfST25R3918Class();
+    this->rfal_hardware_ = nullptr;
+  }
+}
+
+void ST25R3918Component::init_step_() {
+  // Antenna check or tuning started below, one settled measurement per pass
+  if (this->antenna_step_ != AntennaStep::IDLE) {
+    if (this->tune_antenna_()) {
+      this->finish_init_();
     }
+    return;
   }
 
-  if (!found) {
-    ESP_LOGE(TAG, "ST25R3918 not found at address 0x50");
-    return false;
+  uint32_t now = millis();
+  if ((int32_t) (now - this->init_retry_at_) < 0) {
+    return;
   }
 
-  // Create RFAL objects
-  // Get IRQ pin number (required for interrupt-based operation)
-  int irq_pin_num = -1;
-  if (this->irq_pin_ != nullptr) {
-    // Cast to InternalGPIOPin to access the pin number
-    auto *internal_pin = static_cast<InternalGPIOPin *>(this->irq_pin_);
-    irq_pin_num = internal_pin->get_pin();
-    ESP_LOGI(TAG, "Using IRQ pin: %d", irq_pin_num);
-  } else {
-    ESP_LOGW(TAG, "No IRQ pin configured - interrupt handling may not work!");
+  // Probe the chip directly: a single IC identity read instead of a bus scan.
+  // It answers a few ms after power-up, so poll it briefly instead of waiting blind.
+  uint8_t rev = 0;
+  if (!this->rfal_hardware_->st25r3918CheckChipID(&rev)) {
+    if (this->init_attempts_++ == INIT_PROBE_LOG_AFTER) {
+      ESP_LOGW(TAG, "ST25R3918 not responding at address 0x%02X - still probing", this->address_);
+    }
+    this->init_retry_at_ = now + INIT_PROBE_INTERVAL_MS;
+    return;
   }
 
-  ESP_LOGD(TAG, "Creating RFAL hardware instance...");
-  this->rfal_hardware_ = new RfalRfST25R3918Class(&Wire, irq_pin_num);
+  ESP_LOGI(TAG, "ST25R3918 found (rev %u) after %ums, initializing...", rev, now);
+  if (!this->init_rfal_()) {
+    this->retry_init_();
+    return;
+  }
+  if (this->antenna_tuning_) {
+    this->start_antenna_tune_();
+    return;
+  }
+  this->finish_init_();
+}
+
+void ST25R3918Component::finish_init_() {
+  if (!this->start_discovery_()) {
+    this->retry_init_();
+    return;
+  }
+  this->initialized_ = true;
+  ESP_LOGI(TAG, "ST25R3918 initialized in %ums - ready for NFC tags", millis());
+}
 
-  ESP_LOGD(TAG, "Creating RFAL NFC instance...");
-  this->rfal_nfc_ = new RfalNfcClass(this->rfal_hardware_);
+void ST25R3918Component::retry_init_() {
+  ESP_LOGE(TAG, "ST25R3918 initialization failed - will retry");
+  // Retry from clean RFAL state, rebuilt in the same storage
+  this->destroy_rfal_();
+  this->construct_rfal_();
+  this->init_retry_at_ = millis() + INIT_RETRY_INTERVAL_MS;
+}
 
+bool ST25R3918Component::init_rfal_() {
   // Initialize RFAL
   ESP_LOGD(TAG, "Initializing RFAL NFC stack...");
   ReturnCode err = this->rfal_nfc_->rfalNfcInitialize();
@@ -132,6 +315,13 @@ bool ST25R3918Component::init_rfal_() {
   }
 
   ESP_LOGI(TAG, "RFAL NFC stack initialized!");
+  return true;
+}
+
+bool ST25R3918Component::start_discovery_() {
+  if (this->power_control_) {
+    this->apply_power_setpoint_();
+  }
 
   // Configure discovery parameters
   rfalNfcDiscoverParam discParam;
@@ -149,16 +339,17 @@ bool ST25R3918Component::init_rfal_() {
 
   discParam.GBLen = RFAL_NFCDEP_GB_MAX_LEN;
   discParam.notifyCb = nfc_callback_;
-  discParam.totalDuration = 2000U;  // Increased from 1000ms
+  discParam.notifyCtx = this;
+  discParam.totalDuration = this->cadence_.poll_period();  // Until a cart is identified
   discParam.wakeupEnabled = false;
   discParam.wakeupConfigDefault = true;
 
-  ESP_LOGI(TAG, "Discovery config: techs2Find=0x%04X, duration=%dms",
-           discParam.techs2Find, discParam.totalDuration);
+  ESP_LOGI(TAG, "Discovery config: techs2Find=0x%04X, poll every %ums, presence check every %ums",
+           discParam.techs2Find, this->cadence_.poll_period(), this->cadence_.presence_period());
 
   // Start discovery
   ESP_LOGD(TAG, "Starting NFC discovery...");
-  err = this->rfal_nfc_->rfalNfcDiscover(&discParam);
+  ReturnCode err = this->rfal_nfc_->rfalNfcDiscover(&discParam);
   if (err != ERR_NONE) {
     ESP_LOGE(TAG, "rfalNfcDiscover failed with error: %d", err);
     return false;
@@ -170,67 +361,187 @@ bool ST25R3918Component::init_rfal_() {
   return true;
 }
 
+void ST25R3918Component::start_antenna_tune_() {
+  RfalRfST25R3918Class *hw = this->rfal_hardware_;
+
+  // Measure in the NFC-V poll configuration, the one the carts are read with
+  hw->rfalSetMode(RFAL_MODE_POLL_NFCV, RFAL_BR_26p48, RFAL_BR_26p48);
+  hw->rfalFieldOnAndStartGT();
+
+  if (this->antenna_stored_valid_) {
+    // Reapply the stored caps and check they still give the same operating point
+    hw->st25r3918AatMeasureStart(this->antenna_stored_.aat_a, this->antenna_stored_.aat_b);
+    this->antenna_step_ = AntennaStep::CHECK;
+  } else {
+    hw->st25r3918AatTuneStart(nullptr);
+    this->antenna_tune_start_ = millis();
+    this->antenna_step_ = AntennaStep::TUNE;
+  }
+}
+
+// True once the antenna check or tuning is over, the caps then stay set
+bool ST25R3918Component::tune_antenna_() {
+  RfalRfST25R3918Class *hw = this->rfal_hardware_;
+  const AntennaTune &stored = this->antenna_stored_;
+  struct st25r3918AatTuneResult result;
+  ReturnCode err = hw->st25r3918AatGetStatus(&result);
+  if (err == ERR_BUSY) {
+    return false;  // Caps settling
+  }
+
+  if (err != ERR_NONE) {
+    // Keep the stored caps, a retune over a failing measurement can't do better
+    ESP_LOGW(TAG, "Antenna %s failed with error: %d", this->antenna_step_ == AntennaStep::CHECK ? "check" : "tuning",
+             err);
+    if (this->antenna_stored_valid_) {
+      hw->rfalChipSetAntennaTune(stored.aat_a, stored.aat_b);
+    }
+    hw->rfalFieldOff();
+    this->antenna_step_ = AntennaStep::IDLE;
+    return true;
+  }
+
+  NfcEvent event;
+  if (this->antenna_step_ == AntennaStep::CHECK) {
+    int amp_drift = abs((int) result.amp - (int) stored.amp);
+    int pha_drift = abs((int) result.pha - (int) stored.pha);
+    if (amp_drift <= this->tuning_drift_threshold_ && pha_drift <= this->tuning_drift_threshold_) {
+      ESP_LOGI(TAG, "Antenna tuning restored: A=%u B=%u (amp %u, phase %u)", stored.aat_a, stored.aat_b, result.amp,
+               result.pha);
+      event.type = NfcEventType::ANTENNA_RESTORED;
+    } else {
+      ESP_LOGW(TAG, "Antenna drifted (amp %u->%u, phase %u->%u) - retuning", stored.amp, result.amp, stored.pha,
+               result.pha);
+      // Hill-climb starting from the current caps, the stored ones
+      hw->st25r3918AatTuneStart(nullptr);
+      this->antenna_tune_start_ = millis();
+      this->antenna_step_ = AntennaStep::TUNE;
+      return false;
+    }
+  } else {
+    ESP_LOGI(TAG, "Antenna tuned in %ums (%u steps): A=%u B=%u (amp %u, phase %u)",
+             millis() - this->antenna_tune_start_, result.measureCnt, result.aat_a, result.aat_b, result.amp,
+             result.pha);
+    this->antenna_stored_ = {result.aat_a, result.aat_b, result.amp, result.pha};
+    this->antenna_stored_valid_ = true;
+    event.type = NfcEventType::ANTENNA_TUNED;
+  }
+
+  hw->rfalFieldOff();
+  this->antenna_step_ = AntennaStep::IDLE;
+  event.values[0] = result.aat_a;
+  event.values[1] = result.aat_b;
+  event.values[2] = result.amp;
+  event.values[3] = result.pha;
+  this->dispatch_event_(event);
+  return true;
+}
+
+// rfalNfcInitialize() sets the driver to full power (analog configuration),
+// so the setpoint goes back on after every (re)initialization
+void ST25R3918Component::apply_power_setpoint_() {
+  this->rfal_hardware_->rfalChipSetRFO(this->power_.rfo());
+  this->rfo_ = this->power_.rfo();
+}
+
+// One activation (after a missed presence check: with errors) as input to the power control.
+// Amplitude and supply are only measured when a step down is due, with the
+// field on and the tag loading the antenna.
+void ST25R3918Component::control_power_(bool errors) {
+  bool changed = false;
+  uint8_t amplitude = 0;
+  if (errors) {
+    changed = this->power_.errors();
+  } else if (this->power_.clean()) {
+    uint8_t vdd = 0;
+    this->rfal_hardware_->rfalChipMeasureAmplitude(&amplitude);
+    this->rfal_hardware_->rfalChipMeasurePowerSupply(ST25R3918_REG_REGULATOR_CONTROL_mpsv_vdd, &vdd);
+    uint16_t vdd_mv = (uint16_t) ((vdd * 234U) / 10U);  // 23.4 mV steps
+    changed = this->power_.step_down(amplitude, vdd_mv);
+    ESP_LOGV(TAG, "RF power check: RFO %u, amplitude %u, VDD %umV", this->power_.rfo(), amplitude, vdd_mv);
+  }
+  if (!changed) {
+    return;
+  }
+
+  uint8_t previous = this->rfo_;
+  this->rfal_hardware_->rfalChipSetRFO(this->power_.rfo());
+  this->rfo_ = this->power_.rfo();
+  if (errors) {
+    ESP_LOGD(TAG, "RF power up: RFO %u after read errors", this->power_.rfo());
+  } else {
+    ESP_LOGD(TAG, "RF power %s: RFO %u (amplitude %u)", this->power_.rfo() > previous ? "down" : "up",
+             this->power_.rfo(), amplitude);
+  }
+  // Saved from loop()
+  PowerSetpoint setpoint = this->power_.setpoint();
+  NfcEvent event;
+  event.type = NfcEventType::POWER_SETPOINT;
+  event.values[0] = setpoint.rfo;
+  event.values[1] = setpoint.fail_rfo;
+  this->dispatch_event_(event);
+}
+
 void ST25R3918Component::handle_nfc_state_(rfalNfcState state, rfalNfcDevice *nfc_dev) {
+  // Runs in the RFAL worker context (loop() or the dedicated NFC task):
+  // only touch RFAL and last_detected_uid_ here, everything else goes through an event
   switch (state) {
     case RFAL_NFC_STATE_ACTIVATED:
       if (nfc_dev != nullptr) {
-        this->tag_present_ = true;
+        NfcEvent event;
 
         // Store UID
-        this->last_uid_len_ = nfc_dev->nfcidLen;
-        if (this->last_uid_len_ > sizeof(this->last_uid_)) {
-          this->last_uid_len_ = sizeof(this->last_uid_);
+        event.uid_len = nfc_dev->nfcidLen;
+        if (event.uid_len > sizeof(event.uid)) {
+          event.uid_len = sizeof(event.uid);
         }
-        memcpy(this->last_uid_, nfc_dev->nfcid, this->last_uid_len_);
+        memcpy(event.uid, nfc_dev->nfcid, event.uid_len);
 
         // Check if this is a different tag than last time
-        bool same_tag = (this->last_uid_len_ == this->last_detected_uid_len_) &&
-                        (memcmp(this->last_uid_, this->last_detected_uid_, this->last_uid_len_) == 0);
+        bool same_tag = (event.uid_len == this->last_detected_uid_len_) &&
+                        (memcmp(event.uid, this->last_detected_uid_, event.uid_len) == 0);
 
-        // Only process if it's a NEW/different tag
+        // Only read memory if it's a NEW/different tag
         if (!same_tag) {
-          // Save usage data for previous cart if applicable
-          if (!this->active_cart_id_.empty() && this->active_cart_id_ != this->cart_id_) {
-            this->save_usage_data_();
-          }
+          event.type = NfcEventType::TAG_READ;
 
           // Check for ST manufacturer (Pura carts)
-          bool is_pura_cart = (nfc_dev->type == RFAL_NFC_LISTEN_TYPE_NFCV &&
-                               nfc_dev->nfcidLen >= 8 &&
-                               nfc_dev->nfcid[7] == 0xE0 &&
-                               nfc_dev->nfcid[6] == 0x02);
+          event.is_pura_cart = (nfc_dev->type == RFAL_NFC_LISTEN_TYPE_NFCV &&
+                                nfc_dev->nfcidLen >= 8 &&
+                                nfc_dev->nfcid[7] == 0xE0 &&
+                                nfc_dev->nfcid[6] == 0x02);
 
           // Read tag memory for NFC-V tags
+          bool complete = true;
+          uint32_t link_errors = this->link_.counters().errors();
           if (nfc_dev->type == RFAL_NFC_LISTEN_TYPE_NFCV && this->rfal_nfc_ != nullptr) {
-            this->read_nfcv_memory_(nfc_dev, is_pura_cart);
+            complete = this->read_nfcv_memory_(nfc_dev, event.is_pura_cart, event);
+            this->apply_link_policy_();
+          }
+          if (this->power_control_) {
+            this->control_power_(!complete || this->link_.counters().errors() != link_errors);
           }
 
-          // Log the detection with fragrance name if available
-          if (is_pura_cart && this->fragrance_name_[0] != '\0') {
-            ESP_LOGI(TAG, "Pura cart detected: %s", this->fragrance_name_);
-            // Set active cart for usage tracking
-            this->active_cart_id_ = this->cart_id_;
-          } else if (is_pura_cart) {
-            ESP_LOGI(TAG, "Pura cart detected: %s (not configured)", this->cart_id_);
-            this->active_cart_id_ = this->cart_id_;
+          this->cadence_.activated(complete);
+          if (complete) {
+            // Update last detected tag
+            memcpy(this->last_detected_uid_, event.uid, event.uid_len);
+            this->last_detected_uid_len_ = event.uid_len;
           } else {
-            // Format UID for non-Pura tags
-            char uid_str[32] = {0};
-            for (int i = 0; i < this->last_uid_len_ && i < 10; i++) {
-              sprintf(uid_str + (i * 3), "%02X:", this->last_uid_[i]);
-            }
-            if (this->last_uid_len_ > 0) {
-              uid_str[this->last_uid_len_ * 3 - 1] = '\0';
-            }
-            ESP_LOGI(TAG, "NFC tag detected: %s", uid_str);
-            this->active_cart_id_.clear();
+            // Don't publish a partial cart, read it again on the next activation
+            ESP_LOGW(TAG, "Incomplete tag read, retrying on next activation");
+            event.type = NfcEventType::TAG_PRESENT;
+          }
+        } else {
+          this->cadence_.activated(true);
+          if (this->power_control_) {
+            // Found again right after a missed presence check: that miss was a read error
+            this->control_power_(this->presence_missed_);
           }
-
-          // Update last detected tag
-          memcpy(this->last_detected_uid_, this->last_uid_, this->last_uid_len_);
-          this->last_detected_uid_len_ = this->last_uid_len_;
         }
 
+        this->dispatch_event_(event);
+
         // Deactivate and restart discovery
         if (this->rfal_nfc_ != nullptr) {
           this->rfal_nfc_->rfalNfcDeactivate(true);
@@ -238,10 +549,19 @@ void ST25R3918Component::handle_nfc_state_(rfalNfcState state, rfalNfcDevice *nf
       }
       break;
 
-    case RFAL_NFC_STATE_START_DISCOVERY:
-      // Note: tag_present_ stays true because we immediately restart discovery
-      // The cart is considered "removed" when a different cart is detected
-      // or when we clear the detected UID (future: timeout based removal)
+    case RFAL_NFC_STATE_LISTEN_TECHDETECT:
+      // End of a discovery cycle: poll fast until a cart is identified, then only
+      // check it is still there. A missed check goes back to fast polling; the
+      // same cart found again is not re-read (last_detected_uid_ is kept).
+      // Note: tag_present_ stays true, the cart is considered "removed" when a
+      // different cart is detected (future: timeout based removal)
+      if (this->rfal_nfc_ != nullptr) {
+        bool was_present = this->cadence_.present();
+        this->rfal_nfc_->rfalNfcSetDiscoveryPeriod(this->cadence_.cycle_done());
+        // A presence check that misses the cart is the field being too weak only
+        // if the next (fast) cycle finds the same cart again, else it was removed
+        this->presence_missed_ = was_present && !this->cadence_.present();
+      }
       break;
 
     default:
@@ -249,202 +569,470 @@ void ST25R3918Component::handle_nfc_state_(rfalNfcState state, rfalNfcDevice *nf
   }
 }
 
-void ST25R3918Component::read_nfcv_memory_(rfalNfcDevice *nfc_dev, bool is_pura_cart) {
-  ReturnCode err;
+void ST25R3918Component::dispatch_event_(const NfcEvent &event) {
+  rfalTraceMark(this->rfal_hardware_, RFAL_TRACE_INSTANT, TRACE_EV_NFC_EVENT, event.type);
+  if (this->nfc_task_.is_running()) {
+    if (!this->events_.push(event)) {
+      ESP_LOGW(TAG, "NFC event queue full, event dropped (%u total)", this->events_.dropped());
+    }
+    return;
+  }
+  this->apply_event_(event);
+}
+
+void ST25R3918Component::apply_event_(const NfcEvent &event) {
+  if (event.type == NfcEventType::ANTENNA_TUNED || event.type == NfcEventType::ANTENNA_RESTORED) {
+    this->apply_antenna_tune_(event);
+    return;
+  }
+  if (event.type == NfcEventType::POWER_SETPOINT) {
+    PowerSetpoint setpoint{event.values[0], event.values[1]};
+    this->power_pref_.save(&setpoint);
+    return;
+  }
+
+  if (!this->tag_present_) {
+    this->tag_present_ = true;
+    this->presence_dirty_ = true;
+  }
+  this->last_uid_len_ = event.uid_len;
+  memcpy(this->last_uid_, event.uid, event.uid_len);
+
+  if (event.type != NfcEventType::TAG_READ) {
+    return;
+  }
+
+  // Count and save the usage of the previous cart
+  if (!this->active_cart_id_.empty() && this->active_cart_id_ != event.cart_id) {
+    this->update_usage_time_();
+    this->save_usage_data_();
+  }
+
+  // Take over cart info read by the worker
+  if (strncmp(this->cart_id_, event.cart_id, sizeof(this->cart_id_) - 1) != 0) {
+    this->cart_dirty_ = true;
+    this->usage_dirty_ = true;
+  }
+  strncpy(this->cart_id_, event.cart_id, sizeof(this->cart_id_) - 1);
+  this->cart_id_[sizeof(this->cart_id_) - 1] = '\0';
+  strncpy(this->cart_url_, event.cart_url, sizeof(this->cart_url_) - 1);
+  this->cart_url_[sizeof(this->cart_url_) - 1] = '\0';
+  this->fragrance_name_[0] = '\0';
+
+  // Look up fragrance name from YAML config
+  if (this->cart_id_[0] != '\0') {
+    auto it = this->configured_cart_names_.find(this->cart_id_);
+    if (it != this->configured_cart_names_.end()) {
+      strncpy(this->fragrance_name_, it->second.c_str(), sizeof(this->fragrance_name_) - 1);
+      this->fragrance_name_[sizeof(this->fragrance_name_) - 1] = '\0';
+    }
+  }
+
+  // Log the detection with fragrance name if available
+  if (event.is_pura_cart && this->fragrance_name_[0] != '\0') {
+    ESP_LOGI(TAG, "Pura cart detected: %s", this->fragrance_name_);
+    // Set active cart for usage tracking
+    this->active_cart_id_ = this->cart_id_;
+  } else if (event.is_pura_cart) {
+    ESP_LOGI(TAG, "Pura cart detected: %s (not configured)", this->cart_id_);
+    this->active_cart_id_ = this->cart_id_;
+  } else {
+    // Format UID for non-Pura tags
+    char uid_str[32] = {0};
+    for (int i = 0; i < this->last_uid_len_ && i < 10; i++) {
+      sprintf(uid_str + (i * 3), "%02X:", this->last_uid_[i]);
+    }
+    if (this->last_uid_len_ > 0) {
+      uid_str[this->last_uid_len_ * 3 - 1] = '\0';
+    }
+    ESP_LOGI(TAG, "NFC tag detected: %s", uid_str);
+    this->active_cart_id_.clear();
+  }
+}
+
+// Tuning result of the worker: shown by dump_config(), saved when it changed
+void ST25R3918Component::apply_antenna_tune_(const NfcEvent &event) {
+  this->antenna_tune_ = {event.values[0], event.values[1], event.values[2], event.values[3]};
+  this->antenna_tuned_ = true;
+  if (event.type == NfcEventType::ANTENNA_TUNED) {
+    this->antenna_pref_.save(&this->antenna_tune_);
+  }
+}
+
+void ST25R3918Component::apply_link_policy_() {
+  this->rfal_nfc_->rfalNfcvPollerSetFwtMargin(this->link_.fwt_margin());
+  this->rfal_nfc_->rfalNfcvPollerSetInventorySlots(this->link_.prefer_16_slots() ? RFAL_NFCV_NUM_SLOTS_16
+                                                                                 : RFAL_NFCV_NUM_SLOTS_1);
+}
+
+bool ST25R3918Component::read_nfcv_memory_(rfalNfcDevice *nfc_dev, bool is_pura_cart, NfcEvent &event) {
   uint8_t rxBuf[64];
   uint16_t rcvLen;
 
   // Clear previous cart info
-  this->cart_id_[0] = '\0';
-  this->cart_url_[0] = '\0';
-  this->fragrance_name_[0] = '\0';
-
-  // Buffer to accumulate NDEF data for URL extraction
-  uint8_t ndefData[64];
-  int ndefLen = 0;
-
-  // Read first 16 blocks of memory (4 bytes per block = 64 bytes total)
-  for (uint8_t block = 0; block < 16; block++) {
-    memset(rxBuf, 0, sizeof(rxBuf));
-    err = this->rfal_nfc_->rfalNfcvPollerReadSingleBlock(
-        RFAL_NFCV_REQ_FLAG_DEFAULT,
-        nfc_dev->dev.nfcv.InvRes.UID,
-        block,
-        rxBuf, sizeof(rxBuf), &rcvLen);
-
-    if (err == ERR_NONE && rcvLen > 1) {
-      int dataLen = rcvLen - 1;
-      if (dataLen > 4) dataLen = 4;
-      if (ndefLen + dataLen <= (int)sizeof(ndefData)) {
-        memcpy(ndefData + ndefLen, rxBuf + 1, dataLen);
-        ndefLen += dataLen;
+  event.cart_id[0] = '\0';
+  event.cart_url[0] = '\0';
+
+  // Select the tag and pick the response rate, then read the blocks without the UID when possible
+  NfcvTagInfo info = this->nfcv_reader_.begin(this->rfal_nfc_, nfc_dev->dev.nfcv.InvRes.UID);
+  if (info.sys_info) {
+    ESP_LOGD(TAG, "NFC-V IC: manufacturer 0x%02X, reference 0x%02X, %u blocks of %u bytes", info.ic_mfg,
+             info.ic_ref, info.blocks, info.block_size);
+  }
+  ESP_LOGD(TAG, "NFC-V reads: %s mode, %s rate", info.selected ? "selected" : "addressed",
+           info.fast ? "fast" : "standard");
+
+  // Read only the blocks the CC and the NDEF TLV say are needed. The block size
+  // comes from Get System Info, or from the length of the first block read.
+  uint8_t memory[CART_MEMORY_MAX];
+  size_t have = 0;
+  size_t block_size = info.sys_info ? info.block_size : 0;
+  uint8_t block = 0;
+  auto read_to = [&](size_t need) -> ReturnCode {
+    while (have < need) {
+      ReturnCode err = this->nfcv_reader_.read_block(this->rfal_nfc_, this->rfal_hardware_, block, rxBuf,
+                                                     sizeof(rxBuf), &rcvLen);
+      if (err != ERR_NONE) {
+        ESP_LOGD(TAG, "Block %u read failed with error: %d", block, err);
+        return err;
+      }
+      size_t data_len = rcvLen > 1 ? rcvLen - 1 : 0;  // Response flags first
+      if (block_size == 0) {
+        block_size = data_len;
       }
+      if (data_len == 0 || data_len != block_size) {
+        return ERR_PROTO;
+      }
+      if (have + block_size > sizeof(memory)) {
+        return ERR_NOMEM;
+      }
+      memcpy(memory + have, rxBuf + 1, block_size);
+      have += block_size;
+      block++;
+    }
+    return ERR_NONE;
+  };
+
+  CartNdefLayout layout;
+  CartNdefStatus status;
+  size_t need = 4;
+  do {
+    ReturnCode err = read_to(need);
+    if (err == ERR_NOMEM) {
+      ESP_LOGW(TAG, "NDEF message doesn't fit %u bytes, not parsed", (unsigned) sizeof(memory));
+      return true;
+    }
+    if (err != ERR_NONE) {
+      // Retries exhausted: the cart ID would be partial, give up on this activation
+      return false;
     }
+    status = locate_cart_ndef(memory, have, &layout, &need);
+  } while (status == CartNdefStatus::NEED_MORE);
+
+  if (status != CartNdefStatus::FOUND) {
+    ESP_LOGD(TAG, "No NDEF message on the tag (%u bytes read)", (unsigned) have);
+    return true;
   }
 
   // Parse NDEF message to extract URL (only for Pura carts)
-  if (ndefLen > 0 && is_pura_cart) {
-    // Find NDEF message TLV (type 0x03) after 4-byte Capability Container
-    int idx = 4;
-    if (idx < ndefLen && ndefData[idx] == 0x03) {
-      idx += 2;  // Skip TLV type and length
-
-      // Parse NDEF record header
-      if (idx + 4 < ndefLen) {
-        idx++;  // Skip header byte
-        idx++;  // Skip type length
-        uint8_t payloadLen = ndefData[idx++];
-        uint8_t recordType = ndefData[idx++];
-
-        // Check for URI record (type 'U' = 0x55)
-        if (recordType == 0x55 && idx < ndefLen) {
-          uint8_t uriCode = ndefData[idx++];
-
-          const char *uriPrefix = "";
-          if (uriCode == 0x02) uriPrefix = "https://www.";
-          else if (uriCode == 0x01) uriPrefix = "http://www.";
-
-          // Extract URI payload
-          int uriLen = payloadLen - 1;
-          if (uriLen > 0 && idx + uriLen <= ndefLen) {
-            snprintf(this->cart_url_, sizeof(this->cart_url_), "%s", uriPrefix);
-            int prefixLen = strlen(this->cart_url_);
-
-            for (int i = 0; i < uriLen && (prefixLen + i) < (int)sizeof(this->cart_url_) - 1; i++) {
-              this->cart_url_[prefixLen + i] = ndefData[idx + i];
-            }
-
-            // Extract cart ID from URL (format: pura.com/ss?d=CARTID.yyy.CHECKSUM)
-            char *idStart = strstr(this->cart_url_, "?d=");
-            if (idStart != nullptr) {
-              idStart += 3;
-              char *dotPos = strchr(idStart, '.');
-              if (dotPos != nullptr) {
-                int idLen = dotPos - idStart;
-                strncpy(this->cart_id_, idStart, (idLen < 31) ? idLen : 31);
-                this->cart_id_[31] = '\0';
-              }
-            }
-          }
-        }
-      }
+  if (is_pura_cart) {
+    ReturnCode err = read_to(layout.msg_offset + layout.msg_len);
+    if (err == ERR_NOMEM) {
+      ESP_LOGW(TAG, "NDEF message of %u bytes doesn't fit, not parsed", (unsigned) layout.msg_len);
+      return true;
     }
-
-    // Look up fragrance name from YAML config
-    if (this->cart_id_[0] != '\0') {
-      auto it = this->configured_cart_names_.find(this->cart_id_);
-      if (it != this->configured_cart_names_.end()) {
-        strncpy(this->fragrance_name_, it->second.c_str(), sizeof(this->fragrance_name_) - 1);
-        this->fragrance_name_[sizeof(this->fragrance_name_) - 1] = '\0';
-      }
+    if (err != ERR_NONE) {
+      return false;
+    }
+    ESP_LOGV(TAG, "NDEF message: %u bytes at %u, %u blocks read", (unsigned) layout.msg_len,
+             (unsigned) layout.msg_offset, block);
+    if (!parse_cart_ndef(this->ndef_, memory + layout.msg_offset, layout.msg_len, event.cart_url,
+                         sizeof(event.cart_url), event.cart_id, sizeof(event.cart_id))) {
+      ESP_LOGD(TAG, "No cart URL in the NDEF message");
     }
   }
+  return true;
 }
 
-void ST25R3918Component::publish_sensors_() {
+void ST25R3918Component::publish_sensors_(bool force) {
 #ifdef USE_TEXT_SENSOR
-  if (this->fragrance_name_sensor_ != nullptr) {
-    std::string name = this->fragrance_name_[0] != '\0' ? this->fragrance_name_ : "";
-    if (this->fragrance_name_sensor_->state != name) {
-      this->fragrance_name_sensor_->publish_state(name);
+  if (this->cart_dirty_ || force) {
+    if (this->fragrance_name_sensor_ != nullptr) {
+      this->fragrance_name_sensor_->publish_state(this->fragrance_name_);
     }
-  }
-  if (this->cart_id_sensor_ != nullptr) {
-    std::string id = this->cart_id_[0] != '\0' ? this->cart_id_ : "";
-    if (this->cart_id_sensor_->state != id) {
-      this->cart_id_sensor_->publish_state(id);
+    if (this->cart_id_sensor_ != nullptr) {
+      this->cart_id_sensor_->publish_state(this->cart_id_);
     }
   }
 #endif
+  this->cart_dirty_ = false;
 #ifdef USE_BINARY_SENSOR
-  if (this->tag_present_sensor_ != nullptr) {
+  if ((this->presence_dirty_ || force) && this->tag_present_sensor_ != nullptr) {
     this->tag_present_sensor_->publish_state(this->tag_present_);
   }
 #endif
+  this->presence_dirty_ = false;
 #ifdef USE_SENSOR
-  if (!this->active_cart_id_.empty()) {
+  if ((this->usage_dirty_ || force) && !this->active_cart_id_.empty()) {
     auto it = this->cart_usage_seconds_.find(this->active_cart_id_);
     uint32_t usage_seconds = (it != this->cart_usage_seconds_.end()) ? it->second : 0;
     float hours = usage_seconds / 3600.0f;
 
     if (this->usage_time_sensor_ != nullptr) {
-      if (std::abs(this->usage_time_sensor_->state - hours) > 0.01f || std::isnan(this->usage_time_sensor_->state)) {
+      if (force || std::abs(this->usage_time_sensor_->state - hours) > 0.01f || std::isnan(this->usage_time_sensor_->state)) {
         this->usage_time_sensor_->publish_state(hours);
       }
     }
 
+    if (this->daily_usage_sensor_ != nullptr) {
+      float minutes = this->journal_.day_seconds(usage_key_(this->active_cart_id_), this->today_()) / 60.0f;
+      if (force || std::abs(this->daily_usage_sensor_->state - minutes) >= 1.0f ||
+          std::isnan(this->daily_usage_sensor_->state)) {
+        this->daily_usage_sensor_->publish_state(minutes);
+      }
+    }
+
     if (this->scent_remaining_sensor_ != nullptr) {
       float remaining = 100.0f * (1.0f - (float)usage_seconds / (float)TOTAL_LIFE_SECONDS);
       if (remaining < 0.0f) remaining = 0.0f;
       if (remaining > 100.0f) remaining = 100.0f;
-      if (std::abs(this->scent_remaining_sensor_->state - remaining) > 0.1f || std::isnan(this->scent_remaining_sensor_->state)) {
+      if (force || std::abs(this->scent_remaining_sensor_->state - remaining) > 0.1f || std::isnan(this->scent_remaining_sensor_->state)) {
         this->scent_remaining_sensor_->publish_state(remaining);
       }
     }
   }
+#endif
+  this->usage_dirty_ = false;
+}
+
+void ST25R3918Component::publish_link_quality_() {
+#ifdef USE_SENSOR
+  LinkCounters now = this->link_.counters();
+  uint32_t total = now.total - this->link_published_.total;
+  if (total == 0) {
+    return;  // No transceives since the last publish
+  }
+  uint32_t ok = total - (now.crc - this->link_published_.crc) - (now.framing - this->link_published_.framing) -
+                (now.timeout - this->link_published_.timeout) - (now.other - this->link_published_.other);
+
+  if (this->link_rssi_sensor_ != nullptr && ok > 0) {
+    this->link_rssi_sensor_->publish_state((float) (now.rssi_sum - this->link_published_.rssi_sum) / ok);
+  }
+  if (this->crc_error_rate_sensor_ != nullptr) {
+    this->crc_error_rate_sensor_->publish_state(100.0f * (now.crc - this->link_published_.crc) / total);
+  }
+  if (this->framing_error_rate_sensor_ != nullptr) {
+    this->framing_error_rate_sensor_->publish_state(100.0f * (now.framing - this->link_published_.framing) / total);
+  }
+  if (this->timeout_rate_sensor_ != nullptr) {
+    this->timeout_rate_sensor_->publish_state(100.0f * (now.timeout - this->link_published_.timeout) / total);
+  }
+  this->link_published_ = now;
+#endif
+}
+
+void ST25R3918Component::publish_bus_errors_() {
+#ifdef USE_SENSOR
+  if (this->i2c_errors_sensor_ == nullptr) {
+    return;
+  }
+  uint32_t errors = this->i2c_errors_.load(std::memory_order_relaxed);
+  if (!this->i2c_errors_sensor_->has_state() || errors != this->i2c_errors_published_) {
+    this->i2c_errors_sensor_->publish_state(errors);
+    this->i2c_errors_published_ = errors;
+  }
 #endif
 }
 
+void ST25R3918Component::set_heating(bool heating) {
+  if (!this->heater_edges_) {
+    this->heater_meter_.set(heating, micros());
+  }
+  // Collect the heating time into the journal; it reaches flash on the save interval
+  if (this->heating_ && !heating) {
+    this->update_usage_time_();
+  }
+  this->heating_ = heating;
+}
+
+void ST25R3918Component::set_heater_on(bool on) {
+  this->heater_edges_ = true;
+  this->heater_meter_.set(on, micros());
+}
+
 void ST25R3918Component::update_usage_time_() {
-  uint32_t now = millis();
+  uint32_t seconds = this->heater_meter_.take_seconds(micros());
 
-  // Only track if a cart is present AND heater is on
-  if (this->heating_ && this->tag_present_ && !this->active_cart_id_.empty()) {
-    // Calculate elapsed time since last update
-    if (this->last_usage_update_ > 0) {
-      uint32_t elapsed_ms = now - this->last_usage_update_;
-
-      // Accumulate milliseconds, convert to seconds when we have enough
-      this->accumulated_ms_ += elapsed_ms;
-      uint32_t elapsed_seconds = this->accumulated_ms_ / 1000;
-      this->accumulated_ms_ %= 1000;  // Keep remainder
-
-      if (elapsed_seconds > 0) {
-        this->cart_usage_seconds_[this->active_cart_id_] += elapsed_seconds;
-
-        // Save to flash every 60 seconds
-        static uint32_t last_save = 0;
-        if (now - last_save > 60000) {
-          this->save_usage_data_();
-          last_save = now;
-        }
-      }
-    }
+  // Only count heating with a cart present
+  if (seconds == 0 || !this->tag_present_ || this->active_cart_id_.empty()) {
+    return;
   }
+  this->cart_usage_seconds_[this->active_cart_id_] += seconds;
+  this->journal_.add(usage_key_(this->active_cart_id_), this->today_(), this->strength_, seconds);
+  this->usage_dirty_ = true;
 
-  this->last_usage_update_ = now;
+  // The journal survives soft resets: fold it into NVS only a few times a day
+  uint32_t now = millis();
+  if (now - this->last_usage_save_ >= this->usage_save_interval_) {
+    this->save_usage_data_();
+    this->last_usage_save_ = now;
+  }
 }
 
 void ST25R3918Component::load_usage_data_() {
-  Preferences prefs;
-  if (prefs.begin("pura_usage", true)) {  // true = read-only
-    // Load usage for each configured cart
-    for (const auto &pair : this->configured_cart_names_) {
-      uint32_t seconds = prefs.getUInt(pair.first.c_str(), 0);
-      if (seconds > 0) {
-        this->cart_usage_seconds_[pair.first] = seconds;
-        ESP_LOGD(TAG, "Loaded usage for %s: %.1f hours", pair.second.c_str(), seconds / 3600.0f);
-      }
+  this->attach_journal_();
+
+  // Time counted before a reset but not saved yet: add it to the lifetime counters
+  bool pending = false;
+  for (size_t i = 0; i < this->journal_.size(); i++) {
+    const UsageJournalEntry &entry = this->journal_.at(i);
+    if (entry.pending == 0) {
+      continue;
+    }
+    ESPPreferenceObject pref = global_preferences->make_preference<uint32_t>(entry.cart);
+    uint32_t total = 0;
+    pref.load(&total);
+    total += entry.pending;
+    pref.save(&total);
+    pending = true;
+  }
+  if (pending) {
+    ESP_LOGI(TAG, "Recovered unsaved usage from the journal");
+    this->journal_.clear_pending();
+    this->journal_pref_.save(&this->journal_.data());
+  }
+
+  // Load usage for each configured cart
+  for (const auto &pair : this->configured_cart_names_) {
+    uint32_t seconds = 0;
+    if (this->usage_preference_(pair.first).load(&seconds) && seconds > 0) {
+      this->cart_usage_seconds_[pair.first] = seconds;
+      this->usage_saved_seconds_[pair.first] = seconds;
+      ESP_LOGD(TAG, "Loaded usage for %s: %.1f hours", pair.second.c_str(), seconds / 3600.0f);
     }
-    prefs.end();
   }
 }
 
 void ST25R3918Component::save_usage_data_() {
-  Preferences prefs;
-  if (prefs.begin("pura_usage", false)) {
-    for (const auto &pair : this->cart_usage_seconds_) {
-      prefs.putUInt(pair.first.c_str(), pair.second);
+  // The counters are per cart, shared by all readers: add the time counted here
+  // since the last save to the stored total instead of overwriting it
+  for (auto &pair : this->cart_usage_seconds_) {
+    uint32_t &saved = this->usage_saved_seconds_[pair.first];
+    if (pair.second == saved) {
+      continue;
     }
-    prefs.end();
-    ESP_LOGD(TAG, "Saved usage data to flash");
+    ESPPreferenceObject &pref = this->usage_preference_(pair.first);
+    uint32_t total = 0;
+    pref.load(&total);
+    total += pair.second - saved;
+    pref.save(&total);
+    pair.second = total;
+    saved = total;
+  }
+  this->journal_.clear_pending();
+  this->journal_pref_.save(&this->journal_.data());
+  ESP_LOGD(TAG, "Saved usage data to flash");
+}
+
+// Usage counter of a cart in the preferences, keyed by the cart ID hash
+ESPPreferenceObject &ST25R3918Component::usage_preference_(const std::string &cart_id) {
+  auto it = this->usage_prefs_.find(cart_id);
+  if (it == this->usage_prefs_.end()) {
+    it = this->usage_prefs_.emplace(cart_id, global_preferences->make_preference<uint32_t>(usage_key_(cart_id))).first;
+  }
+  return it->second;
+}
+
+uint32_t ST25R3918Component::usage_key_(const std::string &cart_id) { return fnv1_hash("pura_usage_" + cart_id); }
+
+// Claim this reader's journal in RTC memory: the one it kept across a reset,
+// else a slot holding no other reader's journal. After a power cycle the RTC
+// content is gone and the copy from the last save is restored.
+void ST25R3918Component::attach_journal_() {
+  uint32_t owner = fnv1_hash(this->preference_id_);
+  size_t slot = USAGE_JOURNAL_SLOTS;
+  for (size_t i = 0; i < USAGE_JOURNAL_SLOTS && slot == USAGE_JOURNAL_SLOTS; i++) {
+    if (!usage_journal_claimed[i] && UsageJournal::holds(usage_journal_rtc[i], owner)) {
+      slot = i;
+    }
+  }
+  for (size_t i = 0; i < USAGE_JOURNAL_SLOTS && slot == USAGE_JOURNAL_SLOTS; i++) {
+    if (!usage_journal_claimed[i] && !UsageJournal::is_journal(usage_journal_rtc[i])) {
+      slot = i;
+    }
+  }
+  for (size_t i = 0; i < USAGE_JOURNAL_SLOTS && slot == USAGE_JOURNAL_SLOTS; i++) {
+    if (!usage_journal_claimed[i]) {
+      slot = i;
+    }
+  }
+  UsageJournalData *data;
+  if (slot < USAGE_JOURNAL_SLOTS) {
+    usage_journal_claimed[slot] = true;
+    data = &usage_journal_rtc[slot];
+  } else {
+    ESP_LOGW(TAG, "No RTC memory left for the usage journal - a reset loses unsaved usage");
+    data = new UsageJournalData();  // Lives as long as the component
+  }
+
+  this->journal_pref_ =
+      global_preferences->make_preference<UsageJournalData>(fnv1_hash(this->preference_id_ + "_journal"));
+  if (this->journal_.attach(data, owner)) {
+    ESP_LOGCONFIG(TAG, "Usage journal kept across reset (%u entries)", (unsigned) this->journal_.size());
+    return;
+  }
+  UsageJournalData copy;
+  if (this->journal_pref_.load(&copy) && this->journal_.restore(copy)) {
+    ESP_LOGCONFIG(TAG, "Usage journal restored from flash (%u entries)", (unsigned) this->journal_.size());
+  }
+}
+
+// Bucket of the usage journal for today, 0 while the clock isn't set
+uint16_t ST25R3918Component::today_() {
+#ifdef USE_TIME
+  if (this->time_ != nullptr) {
+    ESPTime now = this->time_->now();
+    if (now.is_valid()) {
+      return UsageJournal::days_from_civil(now.year, now.month, now.day_of_month);
+    }
+  }
+#endif
+  return 0;
+}
+
+void ST25R3918Component::dump_usage_history() {
+  std::map<uint32_t, const std::string *> names;
+  for (const auto &pair : this->configured_cart_names_) {
+    names[usage_key_(pair.first)] = &pair.second;
+  }
+
+  ESP_LOGI(TAG, "Usage history (%u entries):", (unsigned) this->journal_.size());
+  for (size_t i = 0; i < this->journal_.size(); i++) {
+    const UsageJournalEntry &entry = this->journal_.at(i);
+    char date[16] = "no clock";
+    if (entry.day != 0) {
+      int year;
+      unsigned month, day;
+      UsageJournal::civil_from_days(entry.day, &year, &month, &day);
+      snprintf(date, sizeof(date), "%04d-%02u-%02u", year, month, day);
+    }
+    char cart[12];
+    auto it = names.find(entry.cart);
+    if (it == names.end()) {
+      snprintf(cart, sizeof(cart), "%08X", (unsigned) entry.cart);
+    }
+    char preset[4] = "-";
+    if (entry.preset != USAGE_PRESET_UNKNOWN) {
+      snprintf(preset, sizeof(preset), "%u", entry.preset);
+    }
+    ESP_LOGI(TAG, "  %s %s, preset %s: %u min", date, it != names.end() ? it->second->c_str() : cart, preset,
+             (unsigned) (entry.seconds / 60));
   }
 }
 
 void ST25R3918Component::dump_config() {
   ESP_LOGCONFIG(TAG, "ST25R3918 NFC Reader:");
-  ESP_LOGCONFIG(TAG, "  SDA Pin: %d", this->sda_pin_);
-  ESP_LOGCONFIG(TAG, "  SCL Pin: %d", this->scl_pin_);
+  LOG_I2C_DEVICE(this);
   LOG_PIN("  IRQ Pin: ", this->irq_pin_);
   LOG_UPDATE_INTERVAL(this);
   if (this->initialized_) {
@@ -452,6 +1040,42 @@ void ST25R3918Component::dump_config() {
   } else {
     ESP_LOGCONFIG(TAG, "  Status: Not initialized");
   }
+  if (this->antenna_tuning_) {
+    ESP_LOGCONFIG(TAG, "  Antenna Tuning: drift threshold %u", this->tuning_drift_threshold_);
+    if (this->antenna_tuned_) {
+      ESP_LOGCONFIG(TAG, "    Caps: A=%u B=%u (amp %u, phase %u)", this->antenna_tune_.aat_a,
+                    this->antenna_tune_.aat_b, this->antenna_tune_.amp, this->antenna_tune_.pha);
+    }
+  }
+  if (this->power_control_) {
+    ESP_LOGCONFIG(TAG, "  RF Power Control: RFO %u", (unsigned) this->rfo_.load());
+  }
+  if (this->dedicated_task_) {
+    ESP_LOGCONFIG(TAG, "  NFC Task: core %d (%s)", this->task_core_,
+                  this->nfc_task_.is_running() ? "running" : "not running");
+  }
+  ESP_LOGCONFIG(TAG, "  Discovery: poll every %ums, presence check every %ums", this->cadence_.poll_period(),
+                this->cadence_.presence_period());
+  static const char *const NFCV_RATE_NAMES[] = {"standard", "fast", "auto"};
+  ESP_LOGCONFIG(TAG, "  NFC-V Data Rate: %s", NFCV_RATE_NAMES[static_cast<uint8_t>(this->nfcv_reader_.get_rate())]);
+  ESP_LOGCONFIG(TAG, "  RFAL State: %u bytes (in component)",
+                (unsigned) (sizeof(RfalRfST25R3918Class) + sizeof(RfalNfcClass)));
+#ifdef USE_ESP32
+  size_t heap_total = heap_caps_get_total_size(MALLOC_CAP_8BIT);
+  ESP_LOGCONFIG(TAG, "  Heap: peak %u of %u bytes used, %u free now",
+                (unsigned) (heap_total - heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT)), (unsigned) heap_total,
+                (unsigned) heap_caps_get_free_size(MALLOC_CAP_8BIT));
+#endif
+  ESP_LOGCONFIG(TAG, "  I2C Errors: %u (%u NACK, %u failed read), %u retries, %u failed transfers",
+                (unsigned) this->i2c_errors_.load(), (unsigned) this->i2c_nacks_.load(),
+                (unsigned) this->i2c_short_reads_.load(), (unsigned) this->i2c_retries_.load(),
+                (unsigned) this->i2c_failures_.load());
+  ESP_LOGCONFIG(TAG, "  I2C Recovery: %u chip re-inits", (unsigned) this->chip_reinits_.load());
+  ESP_LOGCONFIG(TAG, "  Usage Journal: %u of %u entries, saved every %us", (unsigned) this->journal_.size(),
+                (unsigned) USAGE_JOURNAL_ENTRIES, (unsigned) (this->usage_save_interval_ / 1000));
+#ifdef ST25R3918_TRACE
+  ESP_LOGCONFIG(TAG, "  I2C Trace: %u bytes", (unsigned) ST25R3918_TRACE_SIZE);
+#endif
 
   // Log configured carts and their usage
   for (const auto &pair : this->configured_cart_names_) {
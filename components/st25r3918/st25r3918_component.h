@@ -4,6 +4,7 @@
 #include "esphome/core/gpio.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/defines.h"
+#include "esphome/components/i2c/i2c.h"
 
 #ifdef USE_TEXT_SENSOR
 #include "esphome/components/text_sensor/text_sensor.h"
@@ -14,31 +15,99 @@
 #ifdef USE_SENSOR
 #include "esphome/components/sensor/sensor.h"
 #endif
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
 
 // Include RFAL headers directly
 #include "rfal_nfc.h"
 #include "rfal_rfst25r3918.h"
 
+#include "discovery_cadence.h"
+#include "heater_meter.h"
+#include "link_quality.h"
+#include "nfcv_reader.h"
+#include "nfc_event_ring.h"
+#include "nfc_worker_task.h"
+#include "power_control.h"
+#include "pura_cart.h"
+#include "usage_journal.h"
+
+#include <atomic>
 #include <map>
+#include <new>
 #include <string>
 
 namespace esphome {
 namespace st25r3918 {
 
-class ST25R3918Component : public PollingComponent {
+// RFAL transport over an ESPHome I2C device (bus shared with other devices).
+// A read is a single write_read() transaction, opcode and data with a repeated start.
+class RfalI2CDevice : public ST25R3918I2C {
+ public:
+  explicit RfalI2CDevice(i2c::I2CDevice *dev) : dev_(dev) {}
+  uint8_t write(const uint8_t *data, uint16_t len) override { return status_(this->dev_->write(data, len)); }
+  uint8_t writeRead(const uint8_t *tx_data, uint16_t tx_len, uint8_t *rx_data, uint16_t rx_len) override {
+    return status_(this->dev_->write_read(tx_data, tx_len, rx_data, rx_len));
+  }
+
+ protected:
+  // Only a NACK tells for sure that the chip didn't clock anything out
+  static uint8_t status_(i2c::ErrorCode err) {
+    if (err == i2c::ERROR_OK) {
+      return ST25R3918_I2C_OK;
+    }
+    return err == i2c::ERROR_NOT_ACKNOWLEDGED ? ST25R3918_I2C_NACK : ST25R3918_I2C_ERROR;
+  }
+
+  i2c::I2CDevice *dev_;
+};
+
+class ST25R3918Component : public PollingComponent, public i2c::I2CDevice {
  public:
   void setup() override;
   void update() override;
   void dump_config() override;
   void loop() override;
+  void on_shutdown() override;
 
   float get_setup_priority() const override { return setup_priority::DATA; }
 
   void set_irq_pin(GPIOPin *pin) { this->irq_pin_ = pin; }
-  void set_i2c_pins(int sda, int scl) { this->sda_pin_ = sda; this->scl_pin_ = scl; }
+  // Stable per reader name, keys this reader's entries in the preferences
+  void set_preference_id(const std::string &id) { this->preference_id_ = id; }
+  // Republish all sensors at this interval even without changes (0 = never)
+  void set_heartbeat_interval(uint32_t interval_ms) { this->heartbeat_interval_ = interval_ms; }
+  void set_nfcv_data_rate(NfcvRate rate) { this->nfcv_reader_.set_rate(rate); }
+  void set_discovery_intervals(uint16_t poll_ms, uint16_t presence_ms) {
+    this->cadence_.set_periods(poll_ms, presence_ms);
+  }
+  // Run the RFAL worker and cart reads in a dedicated task pinned to task_core
+  void set_dedicated_task(bool enabled, int task_core) {
+    this->dedicated_task_ = enabled;
+    this->task_core_ = task_core;
+  }
+  // Tune the antenna once, keep the caps in NVS and retune only when amplitude or
+  // phase drift more than drift_threshold ADC steps from the stored values
+  void set_antenna_tuning(bool enabled, uint8_t drift_threshold) {
+    this->antenna_tuning_ = enabled;
+    this->tuning_drift_threshold_ = drift_threshold;
+  }
+  // Lower the RF output power while reads stay clean and the field amplitude keeps
+  // min_amplitude ADC steps, down to driver resistance max_rfo (0 full power, 15 weakest)
+  void set_power_control(bool enabled, uint8_t max_rfo, uint8_t min_amplitude) {
+    this->power_control_ = enabled;
+    this->power_.configure(max_rfo, min_amplitude);
+  }
   void add_cart_name(const std::string &cart_id, const std::string &name) {
     this->configured_cart_names_[cart_id] = name;
   }
+  // Fold the usage journal into the lifetime counters in NVS at this interval
+  void set_usage_save_interval(uint32_t interval_ms) { this->usage_save_interval_ = interval_ms; }
+#ifdef USE_TIME
+  // Clock for the per day buckets of the usage journal (without it all time goes to day 0)
+  void set_time(time::RealTimeClock *time) { this->time_ = time; }
+#endif
 
 #ifdef USE_TEXT_SENSOR
   void set_fragrance_name_sensor(text_sensor::TextSensor *sensor) { this->fragrance_name_sensor_ = sensor; }
@@ -50,19 +119,40 @@ class ST25R3918Component : public PollingComponent {
 #ifdef USE_SENSOR
   void set_usage_time_sensor(sensor::Sensor *sensor) { this->usage_time_sensor_ = sensor; }
   void set_scent_remaining_sensor(sensor::Sensor *sensor) { this->scent_remaining_sensor_ = sensor; }
+  void set_link_rssi_sensor(sensor::Sensor *sensor) { this->link_rssi_sensor_ = sensor; }
+  void set_crc_error_rate_sensor(sensor::Sensor *sensor) { this->crc_error_rate_sensor_ = sensor; }
+  void set_framing_error_rate_sensor(sensor::Sensor *sensor) { this->framing_error_rate_sensor_ = sensor; }
+  void set_timeout_rate_sensor(sensor::Sensor *sensor) { this->timeout_rate_sensor_ = sensor; }
+  void set_i2c_errors_sensor(sensor::Sensor *sensor) { this->i2c_errors_sensor_ = sensor; }
+  void set_daily_usage_sensor(sensor::Sensor *sensor) { this->daily_usage_sensor_ = sensor; }
 #endif
 
   // Force an immediate write of usage counters to NVS (call before rebooting).
-  void flush_usage() { this->save_usage_data_(); }
-
-  // Called from YAML to indicate heater state (flush on OFF edge).
-  void set_heating(bool heating) {
-    if (this->heating_ && !heating) {
-      this->save_usage_data_();
-    }
-    this->heating_ = heating;
+  void flush_usage() {
+    this->save_usage_data_();
+    global_preferences->sync();
   }
 
+  // Called from YAML with the strength preset index, recorded with the heating time.
+  void set_strength(uint8_t preset) { this->strength_ = preset; }
+
+  // Log the usage journal: heating minutes per day, cart and preset.
+  void dump_usage_history();
+
+  // Called from YAML to indicate heater state (usage journaled on OFF edge).
+  void set_heating(bool heating);
+
+  // Called from YAML on every switch of the heater output (thermostat heat and
+  // idle actions); usage then counts the real on-time between these edges
+  // instead of the whole set_heating() period.
+  void set_heater_on(bool on);
+
+#ifdef ST25R3918_TRACE
+  // Log the I2C trace buffer as hex lines (drained from the worker context).
+  // It also holds timeline events; tools/st25r3918_trace.py --chrome exports them.
+  void dump_trace() { this->trace_dump_requested_.store(true, std::memory_order_release); }
+#endif
+
   // Getters for Home Assistant sensors
   const char *get_cart_id() const { return this->cart_id_; }
   const char *get_fragrance_name() const { return this->fragrance_name_; }
@@ -70,17 +160,29 @@ class ST25R3918Component : public PollingComponent {
 
  protected:
   GPIOPin *irq_pin_{nullptr};
-  int sda_pin_{27};
-  int scl_pin_{14};
+  std::string preference_id_{"st25r3918"};
 
-  // RFAL objects
+  // RFAL objects, constructed in place in the storage below. Only the worker
+  // context (dedicated task or loop()) touches them: it rebuilds them on recovery
+  int irq_pin_num_{-1};
+  RfalI2CDevice rfal_i2c_{this};
   RfalRfST25R3918Class *rfal_hardware_{nullptr};
   RfalNfcClass *rfal_nfc_{nullptr};
+  NdefClass *ndef_{nullptr};
+  alignas(RfalRfST25R3918Class) uint8_t rfal_hardware_storage_[sizeof(RfalRfST25R3918Class)];
+  alignas(RfalNfcClass) uint8_t rfal_nfc_storage_[sizeof(RfalNfcClass)];
+  alignas(NdefClass) uint8_t ndef_storage_[sizeof(NdefClass)];
 
-  bool initialized_{false};
+  std::atomic<bool> initialized_{false};  // Set by the worker context, read by loop()/update()
   bool discovery_started_{false};
   bool tag_present_{false};
 
+  // Dedicated NFC task: the worker produces events, loop() consumes them
+  bool dedicated_task_{false};
+  int task_core_{0};
+  NfcWorkerTask nfc_task_;
+  SpscRing<NfcEvent, 8> events_;
+
   uint8_t last_uid_[10];
   uint8_t last_uid_len_{0};
 
@@ -89,23 +191,111 @@ class ST25R3918Component : public PollingComponent {
   char cart_url_[128]{0};
   char fragrance_name_[64]{0};
 
-  // Tag detection - only log new tags
+  // Antenna tuning (serial/parallel cap DACs and the amplitude/phase they gave).
+  // The stored tune is loaded in setup(); the worker checks or retunes it one
+  // settled measurement per pass and hands the result to loop(), which saves it.
+  bool antenna_tuning_{false};
+  uint8_t tuning_drift_threshold_{16};
+  struct AntennaTune {
+    uint8_t aat_a;
+    uint8_t aat_b;
+    uint8_t amp;
+    uint8_t pha;
+  };
+  enum class AntennaStep : uint8_t { IDLE, CHECK, TUNE };
+  AntennaStep antenna_step_{AntennaStep::IDLE};  // Worker context
+  AntennaTune antenna_stored_{0, 0, 0, 0};       // Worker context once setup() loaded it
+  bool antenna_stored_valid_{false};
+  uint32_t antenna_tune_start_{0};
+  ESPPreferenceObject antenna_pref_;             // loop() context
+  AntennaTune antenna_tune_{0, 0, 0, 0};         // loop() context, for dump_config()
+  bool antenna_tuned_{false};
+
+  // RF output power control (worker context once setup() restored the stored
+  // setpoint); the driver resistance in use is mirrored for dump_config(), new
+  // setpoints go to loop() to be saved
+  bool power_control_{false};
+  PowerControl power_;
+  ESPPreferenceObject power_pref_;  // loop() context
+  std::atomic<uint8_t> rfo_{0};
+
+  // Per-transceive link statistics (written by the worker) and the counters
+  // at the last diagnostic publish
+  LinkQuality link_;
+  LinkCounters link_published_;
+
+  // NFC-V cart reads: Select and response rate (worker context)
+  NfcvReader nfcv_reader_{&this->link_};
+
+  // Field off wait between discovery cycles: fast polling vs presence checks (worker context)
+  DiscoveryCadence cadence_;
+  bool presence_missed_{false};  // The last cycle missed a present cart
+
+  // Tag detection - only read/log new tags (owned by the NFC worker context)
   uint8_t last_detected_uid_[10];
   uint8_t last_detected_uid_len_{0};
 
-  // Boot delay tracking
-  uint32_t boot_time_{0};
+  // Chip probe/initialization retries
+  uint32_t init_retry_at_{0};
+  uint32_t init_attempts_{0};
+  static constexpr uint32_t INIT_PROBE_INTERVAL_MS = 20;
+  static constexpr uint32_t INIT_PROBE_LOG_AFTER = 50;  // ~1 s of probing
+  static constexpr uint32_t INIT_RETRY_INTERVAL_MS = 5000;
+
+  // I2C recovery (worker context): chip re-init once transfers keep failing
+  uint32_t i2c_errors_prior_{0};    // Totals of the RFAL instances before the last rebuild
+  uint32_t i2c_failures_prior_{0};
+  // Bus counters mirrored by the worker on every pass: update() and dump_config()
+  // read these, never the RFAL instance the worker may be rebuilding
+  std::atomic<uint32_t> chip_reinits_{0};
+  std::atomic<uint32_t> i2c_errors_{0};       // NACKs and short reads, all instances
+  std::atomic<uint32_t> i2c_failures_{0};     // Failed transfers, all instances
+  std::atomic<uint32_t> i2c_nacks_{0};        // Current instance only
+  std::atomic<uint32_t> i2c_short_reads_{0};
+  std::atomic<uint32_t> i2c_retries_{0};
+  uint32_t i2c_errors_published_{0};
+  static constexpr uint32_t CHIP_REINIT_AFTER = 6;  // Failed transfers in a row
+  static constexpr size_t CART_MEMORY_MAX = 256;    // Tag memory read for the NDEF message, CC included
+
+#ifdef ST25R3918_TRACE
+  // Timeline events of the component, next to the RFAL_TRACE_EV_* ones
+  static constexpr uint8_t TRACE_EV_NFC_CALLBACK = 0x10;  // handle_nfc_state_(), arg rfalNfcState
+  static constexpr uint8_t TRACE_EV_NFC_EVENT = 0x11;     // Event handed to loop(), arg NfcEventType
+
+  // Trace dump requested from any context, served by the worker context
+  std::atomic<bool> trace_dump_requested_{false};
+  // A record is never split by st25r3918TraceRead(): room for the largest one (a full FIFO)
+  uint8_t trace_chunk_[ST25R3918_FIFO_DEPTH + 16];
+#endif
 
   // Cart names configured in YAML
   std::map<std::string, std::string> configured_cart_names_;
 
+  // Sensor publishing: set by the NFC and usage paths, cleared once published
+  bool cart_dirty_{true};
+  bool presence_dirty_{true};
+  bool usage_dirty_{true};
+  uint32_t heartbeat_interval_{0};
+  uint32_t last_heartbeat_{0};
+
   // Usage tracking
   std::map<std::string, uint32_t> cart_usage_seconds_;  // Runtime per cart in seconds
-  uint32_t last_usage_update_{0};  // Last time we updated usage
-  uint32_t accumulated_ms_{0};     // Accumulated milliseconds not yet added to seconds
+  std::map<std::string, uint32_t> usage_saved_seconds_;  // The same at the last load/save
+  std::map<std::string, ESPPreferenceObject> usage_prefs_;  // Per cart, shared by all readers
+  uint32_t last_usage_save_{0};    // Last periodic save to flash
+  uint32_t usage_save_interval_{6 * 3600 * 1000};
+  HeaterMeter heater_meter_;       // Heater on-time not yet counted
+  bool heater_edges_{false};       // set_heater_on() drives heater_meter_
   std::string active_cart_id_;     // Currently active cart for usage tracking
   bool heating_{false};            // True when heater is actively on
-  ESPPreferenceObject usage_pref_;
+  uint8_t strength_{USAGE_PRESET_UNKNOWN};
+
+  // Per day usage (RTC memory, copied to the preferences on each save)
+  UsageJournal journal_;
+  ESPPreferenceObject journal_pref_;
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+#endif
 
   static constexpr uint32_t TOTAL_LIFE_SECONDS = 200 * 3600;  // ~200 hours at medium
 
@@ -120,20 +310,52 @@ class ST25R3918Component : public PollingComponent {
 #ifdef USE_SENSOR
   sensor::Sensor *usage_time_sensor_{nullptr};
   sensor::Sensor *scent_remaining_sensor_{nullptr};
+  sensor::Sensor *link_rssi_sensor_{nullptr};
+  sensor::Sensor *crc_error_rate_sensor_{nullptr};
+  sensor::Sensor *framing_error_rate_sensor_{nullptr};
+  sensor::Sensor *timeout_rate_sensor_{nullptr};
+  sensor::Sensor *i2c_errors_sensor_{nullptr};
+  sensor::Sensor *daily_usage_sensor_{nullptr};
 #endif
 
   // Internal methods
+  void construct_rfal_();
+  void destroy_rfal_();
+  void worker_step_();
+  void init_step_();
+  void finish_init_();
+  void retry_init_();
+  void check_bus_();
+  void mirror_bus_stats_();
   bool init_rfal_();
+  bool start_discovery_();
+  void start_antenna_tune_();
+  bool tune_antenna_();
+  void apply_antenna_tune_(const NfcEvent &event);
   void handle_nfc_state_(rfalNfcState state, rfalNfcDevice *device);
-  void read_nfcv_memory_(rfalNfcDevice *device, bool is_pura_cart);
-  void publish_sensors_();
+  bool read_nfcv_memory_(rfalNfcDevice *device, bool is_pura_cart, NfcEvent &event);
+  void apply_link_policy_();
+  void apply_power_setpoint_();
+  void control_power_(bool errors);
+#ifdef ST25R3918_TRACE
+  void dump_trace_();
+#endif
+  void publish_link_quality_();
+  void publish_bus_errors_();
+  void dispatch_event_(const NfcEvent &event);
+  void apply_event_(const NfcEvent &event);
+  static void nfc_task_body_(void *arg);
+  void publish_sensors_(bool force);
   void update_usage_time_();
   void load_usage_data_();
   void save_usage_data_();
+  ESPPreferenceObject &usage_preference_(const std::string &cart_id);
+  static uint32_t usage_key_(const std::string &cart_id);
+  void attach_journal_();
+  uint16_t today_();
 
-  // Static callback for RFAL
-  static void nfc_callback_(rfalNfcState state);
-  static ST25R3918Component *instance_;
+  // RFAL notification, ctx is the component
+  static void nfc_callback_(void *ctx, rfalNfcState state);
 };
 
 }  // namespace st25r3918
@@ -0,0 +1,75 @@
+/*! \file
+ *
+ *  \brief ST25R3918 I2C transport
+ *
+ *  The RFAL does not own the I2C bus: the component hands it an implementation
+ *  of this interface (the ESPHome I2C device, or a recorded bus on the host).
+ *  Address and clock are the bus owner's business.
+ */
+
+#ifndef ST25R3918_I2C_H
+#define ST25R3918_I2C_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include <stdint.h>
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#define ST25R3918_I2C_OK            0U   /*!< Transaction complete                                             */
+#define ST25R3918_I2C_NACK          1U   /*!< Address or a written byte not acknowledged, nothing was read     */
+#define ST25R3918_I2C_ERROR         2U   /*!< Bus error or timeout, bytes may have been clocked out already    */
+
+/*
+******************************************************************************
+* GLOBAL DATA TYPES
+******************************************************************************
+*/
+
+/*! I2C transport used by the ST25R3918 com layer */
+class ST25R3918I2C {
+  public:
+    virtual ~ST25R3918I2C() {}
+
+    /*!
+     *****************************************************************************
+     *  \brief  Write to the ST25R3918
+     *
+     *  \param[in]  data : bytes to write (prefix, operation, payload)
+     *  \param[in]  len  : number of bytes
+     *
+     *  \return ST25R3918_I2C_OK   : address and all bytes acknowledged
+     *  \return ST25R3918_I2C_NACK : address or a byte not acknowledged
+     *  \return ST25R3918_I2C_ERROR : other bus error
+     *****************************************************************************
+     */
+    virtual uint8_t write(const uint8_t *data, uint16_t len) = 0;
+
+    /*!
+     *****************************************************************************
+     *  \brief  Write an operation and read the answer in one transaction
+     *
+     *  The operation bytes and the read are joined by a repeated start, so no
+     *  other bus user gets between them.
+     *
+     *  \param[in]  txData : bytes to write (prefix, operation)
+     *  \param[in]  txLen  : number of bytes to write
+     *  \param[out] rxData : received bytes
+     *  \param[in]  rxLen  : number of bytes to read
+     *
+     *  \return ST25R3918_I2C_OK    : all rxLen bytes received
+     *  \return ST25R3918_I2C_NACK  : address or operation not acknowledged, nothing read
+     *  \return ST25R3918_I2C_ERROR : failed after the operation may have been
+     *                                acknowledged, an unknown number of bytes read
+     *****************************************************************************
+     */
+    virtual uint8_t writeRead(const uint8_t *txData, uint16_t txLen, uint8_t *rxData, uint16_t rxLen) = 0;
+};
+
+#endif /* ST25R3918_I2C_H */
@@ -73,6 +73,7 @@ void RfalRfST25R3918Class::st25r3918InitInterrupts(void)
   st25r3918interrupt.prevCallback = NULL;
   st25r3918interrupt.status       = ST25R3918_IRQ_MASK_NONE;
   st25r3918interrupt.mask         = ST25R3918_IRQ_MASK_NONE;
+  st25r3918interrupt.fifoStatusValid = false;
 }
 
 
@@ -95,7 +96,7 @@ void RfalRfST25R3918Class::st25r3918Isr(void)
 /*******************************************************************************/
 void RfalRfST25R3918Class::st25r3918CheckForReceivedInterrupts(void)
 {
-  uint8_t  iregs[ST25R3918_INT_REGS_LEN];
+  uint8_t  iregs[ST25R3918_INT_REGS_LEN + ST25R3918_FIFO_STATUS_LEN];
   uint32_t irqStatus;
 
   /* Initialize iregs */
@@ -103,9 +104,15 @@ void RfalRfST25R3918Class::st25r3918CheckForReceivedInterrupts(void)
   ST_MEMSET(iregs, (int32_t)(ST25R3918_IRQ_MASK_ALL & 0xFFU), ST25R3918_INT_REGS_LEN);
 
 
-  /* In case the IRQ is Edge (not Level) triggered read IRQs until done */
-  while (digitalRead(int_pin) == HIGH) {
-    st25r3918ReadMultipleRegisters(ST25R3918_REG_IRQ_MAIN, iregs, ST25R3918_INT_REGS_LEN);
+  /* In case the IRQ is Edge (not Level) triggered read IRQs until done.                *
+   * FIFO Status 1/2 follow the IRQ registers: read them in the same burst, so the RX   *
+   * handling of the IRQs (RXE, FWL) finds the FIFO byte count without another access  */
+  while (st25r3918IsIrqPinHigh()) {
+    if (st25r3918ReadMultipleRegisters(ST25R3918_REG_IRQ_MAIN, iregs, (ST25R3918_INT_REGS_LEN + ST25R3918_FIFO_STATUS_LEN)) == ERR_NONE) {
+      st25r3918interrupt.fifoStatus[0]   = iregs[ST25R3918_INT_REGS_LEN];
+      st25r3918interrupt.fifoStatus[1]   = iregs[ST25R3918_INT_REGS_LEN + 1U];
+      st25r3918interrupt.fifoStatusValid = true;
+    }
 
     irqStatus |= (uint32_t)iregs[0];
     irqStatus |= (uint32_t)iregs[1] << 8;
@@ -118,12 +125,26 @@ void RfalRfST25R3918Class::st25r3918CheckForReceivedInterrupts(void)
 }
 
 
+/*******************************************************************************/
+bool RfalRfST25R3918Class::st25r3918IsIrqPinHigh(void)
+{
+  if ((int_pin < 0) || (digitalRead(int_pin) != HIGH)) {
+    return false;
+  }
+
+  /* Only high samples are traced: a replay reads the pin low unless the next record is this one */
+  st25r3918TraceLog(ST25R3918_TRACE_IRQ, 0U, 0U, NULL, 0U);
+  return true;
+}
+
+
 /*******************************************************************************/
 void RfalRfST25R3918Class::st25r3918ModifyInterrupts(uint32_t clr_mask, uint32_t set_mask)
 {
-  uint8_t  i;
-  uint32_t old_mask;
-  uint32_t new_mask;
+  uint8_t          i;
+  uint32_t         old_mask;
+  uint32_t         new_mask;
+  st25r3918CmdList list;
 
 
   old_mask = st25r3918interrupt.mask;
@@ -131,13 +152,16 @@ void RfalRfST25R3918Class::st25r3918ModifyInterrupts(uint32_t clr_mask, uint32_t
   st25r3918interrupt.mask &= ~clr_mask;
   st25r3918interrupt.mask |= set_mask;
 
+  /* Adjacent mask registers that changed are written in one burst */
+  st25r3918CmdListInit(&list);
   for (i = 0; i < ST25R3918_INT_REGS_LEN; i++) {
     if (((new_mask >> (8U * i)) & 0xFFU) == 0U) {
       continue;
     }
 
-    st25r3918WriteRegister(ST25R3918_REG_IRQ_MASK_MAIN + i, (uint8_t)((st25r3918interrupt.mask >> (8U * i)) & 0xFFU));
+    st25r3918CmdListWrite(&list, (uint8_t)(ST25R3918_REG_IRQ_MASK_MAIN + i), (uint8_t)((st25r3918interrupt.mask >> (8U * i)) & 0xFFU));
   }
+  st25r3918CmdListExecute(&list);
   return;
 }
 
@@ -153,10 +177,13 @@ uint32_t RfalRfST25R3918Class::st25r3918WaitForInterruptsTimed(uint32_t mask, ui
   /* Run until specific interrupt has happen or the timer has expired */
   do {
     /* Poll interrupt registers directly if IRQ pin is valid and high */
-    if ((int_pin >= 0) && (digitalRead(int_pin) == HIGH)) {
+    if (st25r3918IsIrqPinHigh()) {
       st25r3918CheckForReceivedInterrupts();
     }
     status = (st25r3918interrupt.status & mask);
+    if (status == 0U) {
+      yield();
+    }
   } while ((!timerIsExpired(tmrDelay) || (tmo == 0U)) && (status == 0U));
 
   status = st25r3918interrupt.status & mask;
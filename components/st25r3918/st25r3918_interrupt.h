@@ -109,6 +109,8 @@ typedef struct {
   void (*callback)(void);          /*!< call back function for ST25R3918 interrupt          */
   uint32_t  status;                /*!< latest interrupt status                             */
   uint32_t  mask;                  /*!< Interrupt mask. Negative mask = ST25R3918 mask regs */
+  uint8_t   fifoStatus[2];         /*!< FIFO Status 1/2, read along with the IRQ registers  */
+  bool      fifoStatusValid;       /*!< fifoStatus still matches the FIFO content           */
 } st25r3918Interrupt;
 
 /*
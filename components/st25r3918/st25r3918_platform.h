@@ -0,0 +1,68 @@
+/*! \file
+ *
+ *  \brief Platform glue of the ST25R3918 RFAL port
+ *
+ *  Time, delay and GPIO primitives used by the RFAL. The Arduino core provides
+ *  them directly; under ESP-IDF they map onto the ESPHome HAL and the IDF GPIO
+ *  driver.
+ */
+
+#ifndef ST25R3918_PLATFORM_H
+#define ST25R3918_PLATFORM_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#ifdef USE_ESP_IDF
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <driver/gpio.h>
+#include "esphome/core/hal.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#ifndef HIGH
+#define HIGH                    1
+#define LOW                     0
+#endif
+#ifndef INPUT
+#define INPUT                   0x01
+#endif
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+using esphome::millis;
+using esphome::micros;
+using esphome::delay;
+using esphome::delayMicroseconds;
+using esphome::yield;
+
+static inline void pinMode(int pin, uint8_t mode)
+{
+  (void)mode;  /* Only inputs: the IRQ line */
+  gpio_set_direction((gpio_num_t)pin, GPIO_MODE_INPUT);
+}
+
+static inline int digitalRead(int pin)
+{
+  return gpio_get_level((gpio_num_t)pin);
+}
+
+#else  /* Arduino core, host tools */
+
+#include "Arduino.h"
+
+#endif /* USE_ESP_IDF */
+
+#endif /* ST25R3918_PLATFORM_H */
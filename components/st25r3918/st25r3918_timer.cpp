@@ -89,13 +89,22 @@ bool RfalRfST25R3918Class::timerIsExpired(uint32_t timer)
 
 
 /*******************************************************************************/
-void RfalRfST25R3918Class::timerDelay(uint16_t tOut)
+uint32_t RfalRfST25R3918Class::timerCalculateTimerUs(uint32_t time)
 {
-  uint32_t t;
+  return (micros() + time);
+}
+
+
+/*******************************************************************************/
+bool RfalRfST25R3918Class::timerIsExpiredUs(uint32_t timer)
+{
+  int32_t sDiff;
+
+  /* Same signed diff as timerIsExpired(): micros() rolls over every ~71min,   *
+   * which the signed conversion handles for any duration below ~35min        */
+  sDiff = (int32_t)(timer - micros());
 
-  /* Calculate the timer and wait blocking until is running */
-  t = timerCalculateTimer(tOut);
-  while ((!timerIsExpired(t)));
+  return (sDiff < 0);
 }
 
 
@@ -35,7 +35,7 @@
 * INCLUDES
 ******************************************************************************
 */
-#include "Arduino.h"
+#include "st25r3918_platform.h"
 
 /*
 ******************************************************************************
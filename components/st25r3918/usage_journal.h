@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace st25r3918 {
+
+static constexpr uint16_t USAGE_JOURNAL_ENTRIES = 48;
+static constexpr uint8_t USAGE_PRESET_UNKNOWN = 0xFF;
+
+// Heating time of one cart on one day at one strength preset
+struct UsageJournalEntry {
+  uint32_t cart;     // Key of the cart's lifetime counter in the preferences
+  uint16_t day;      // Days since 1970-01-01 (local time), 0: clock not set
+  uint8_t preset;    // Strength preset index, USAGE_PRESET_UNKNOWN if never set
+  uint8_t reserved;
+  uint32_t seconds;  // Heating time
+  uint32_t pending;  // Part of seconds not yet added to the lifetime counter
+};
+
+// Journal storage. Lives in RTC no-init memory, so it survives soft resets and
+// OTA reboots; a copy is kept in the preferences for power cycles.
+struct UsageJournalData {
+  uint32_t magic;
+  uint32_t owner;  // Hash of the reader's preference ID
+  uint16_t head;   // Next slot to write
+  uint16_t count;
+  uint32_t checksum;
+  UsageJournalEntry entries[USAGE_JOURNAL_ENTRIES];
+};
+
+// Ring of per cart, per day, per preset heating time. Merges into the newest
+// bucket with the same key, otherwise opens a new one over the oldest. Main
+// loop context only.
+class UsageJournal {
+ public:
+  // Work on data; keeps its content if it is a valid journal of owner
+  bool attach(UsageJournalData *data, uint32_t owner) {
+    this->data_ = data;
+    if (holds(*data, owner)) {
+      return true;
+    }
+    *data = {};
+    data->magic = MAGIC;
+    data->owner = owner;
+    this->seal_();
+    return false;
+  }
+
+  // Take over a copy (from the preferences) if it is a valid journal of the same owner
+  bool restore(const UsageJournalData &copy) {
+    if (this->data_ == nullptr || !holds(copy, this->data_->owner)) {
+      return false;
+    }
+    *this->data_ = copy;
+    return true;
+  }
+
+  static bool holds(const UsageJournalData &data, uint32_t owner) {
+    return data.magic == MAGIC && data.owner == owner && data.head < USAGE_JOURNAL_ENTRIES &&
+           data.count <= USAGE_JOURNAL_ENTRIES && data.checksum == checksum(data);
+  }
+  static bool is_journal(const UsageJournalData &data) { return holds(data, data.owner); }
+
+  void add(uint32_t cart, uint16_t day, uint8_t preset, uint32_t seconds) {
+    UsageJournalData *d = this->data_;
+    // Buckets of a day are at the end of the ring, unless the clock was set meanwhile
+    for (size_t i = d->count; i-- > 0;) {
+      UsageJournalEntry &e = this->entry_(i);
+      if (e.day != day) {
+        break;
+      }
+      if (e.cart == cart && e.preset == preset) {
+        e.seconds += seconds;
+        e.pending += seconds;
+        this->seal_();
+        return;
+      }
+    }
+    d->entries[d->head] = {cart, day, preset, 0, seconds, seconds};
+    d->head = (d->head + 1) % USAGE_JOURNAL_ENTRIES;
+    if (d->count < USAGE_JOURNAL_ENTRIES) {
+      d->count++;
+    }
+    this->seal_();
+  }
+
+  // The pending time was added to the lifetime counters
+  void clear_pending() {
+    for (size_t i = 0; i < this->data_->count; i++) {
+      this->entry_(i).pending = 0;
+    }
+    this->seal_();
+  }
+
+  uint32_t day_seconds(uint32_t cart, uint16_t day) const {
+    uint32_t total = 0;
+    for (size_t i = 0; i < this->size(); i++) {
+      const UsageJournalEntry &e = this->at(i);
+      if (e.cart == cart && e.day == day) {
+        total += e.seconds;
+      }
+    }
+    return total;
+  }
+
+  size_t size() const { return this->data_ != nullptr ? this->data_->count : 0; }
+  // Oldest first
+  const UsageJournalEntry &at(size_t i) const { return const_cast<UsageJournal *>(this)->entry_(i); }
+  const UsageJournalData &data() const { return *this->data_; }
+
+  static uint32_t checksum(const UsageJournalData &data) {
+    // FNV-1a over the header and the entries, without the checksum itself
+    const auto *p = reinterpret_cast<const uint8_t *>(&data);
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < sizeof(UsageJournalData); i++) {
+      if (i == offsetof(UsageJournalData, checksum)) {
+        i += sizeof(data.checksum) - 1;
+        continue;
+      }
+      hash = (hash ^ p[i]) * 16777619UL;
+    }
+    return hash;
+  }
+
+  // Civil date <-> days since 1970-01-01 (proleptic Gregorian)
+  static uint16_t days_from_civil(int year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yoe = static_cast<unsigned>(year - era * 400);
+    unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return static_cast<uint16_t>(era * 146097 + static_cast<int>(doe) - 719468);
+  }
+  static void civil_from_days(uint16_t days, int *year, unsigned *month, unsigned *day) {
+    int z = days + 719468;
+    int era = z / 146097;
+    unsigned doe = static_cast<unsigned>(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    *day = doy - (153 * mp + 2) / 5 + 1;
+    *month = mp < 10 ? mp + 3 : mp - 9;
+    *year = static_cast<int>(yoe) + era * 400 + (*month <= 2);
+  }
+
+ protected:
+  static constexpr uint32_t MAGIC = 0x4A475355;  // "USGJ"
+
+  UsageJournalEntry &entry_(size_t i) {
+    UsageJournalData *d = this->data_;
+    return d->entries[(d->head + USAGE_JOURNAL_ENTRIES - d->count + i) % USAGE_JOURNAL_ENTRIES];
+  }
+  void seal_() { this->data_->checksum = checksum(*this->data_); }
+
+  UsageJournalData *data_{nullptr};
+};
+
+}  // namespace st25r3918
+}  // namespace esphome
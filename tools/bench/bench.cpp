@@ -0,0 +1,371 @@
+// Host micro-benchmarks of the pure-compute paths of the RFAL, the NDEF library
+// and the component: CRC, ISO15693 coding/decoding, analog config lookup, NDEF
+// message decode/encode, vCard/Wi-Fi parsing and the cart URL extraction.
+//
+// Inputs are the frames the reader actually handles with a Pura cart (and, for
+// the NDEF types, typical vCard/Wi-Fi tags); each is checked to decode correctly
+// before it is timed. Every benchmark is calibrated to ~50 ms per run and
+// reports the median of 7 runs, so numbers are comparable between builds:
+//
+//   ./st25r3918_bench [filter]
+//
+// See README.md for the build command.
+
+#include "Arduino.h"
+
+#include "ndef_class.h"
+#include "pura_cart.h"
+#include "rfal_nfc.h"
+#include "rfal_rfst25r3918.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using esphome::st25r3918::CartNdefLayout;
+using esphome::st25r3918::CartNdefStatus;
+using esphome::st25r3918::locate_cart_ndef;
+using esphome::st25r3918::parse_cart_ndef;
+
+/*
+ * Arduino core and I2C stand-ins: nothing below touches the bus
+ */
+static const auto host_start = std::chrono::steady_clock::now();
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - host_start).count();
+}
+unsigned long millis() { return micros() / 1000U; }
+void delay(unsigned long) {}
+void delayMicroseconds(unsigned int) {}
+void yield() {}
+int digitalRead(uint8_t) { return LOW; }
+void pinMode(uint8_t, uint8_t) {}
+
+namespace {
+
+class NullBus : public ST25R3918I2C {
+ public:
+  uint8_t write(const uint8_t *, uint16_t) override { return ST25R3918_I2C_OK; }
+  uint8_t writeRead(const uint8_t *, uint16_t, uint8_t *, uint16_t) override { return ST25R3918_I2C_ERROR; }
+};
+
+// Exposes the protected analog config lookup
+class BenchRf : public RfalRfST25R3918Class {
+ public:
+  using RfalRfST25R3918Class::RfalRfST25R3918Class;
+  using RfalRfST25R3918Class::rfalAnalogConfigSearch;
+};
+
+NullBus bus;
+BenchRf hw(&bus, -1);
+RfalNfcClass nfc(&hw);
+NdefClass ndef(&nfc);
+
+const double RUN_NS = 50e6;
+const int RUNS = 7;
+
+// Keeps the compiler from discarding a result
+inline void keep(const void *p) { asm volatile("" : : "g"(p) : "memory"); }
+
+const char *filter = nullptr;
+
+template<typename F> void bench(const char *name, uint32_t bytes, F &&op) {
+  if (filter != nullptr && strstr(name, filter) == nullptr) {
+    return;
+  }
+  using clock = std::chrono::steady_clock;
+  auto time = [&](uint64_t iters) {
+    auto start = clock::now();
+    for (uint64_t i = 0; i < iters; i++) {
+      op();
+    }
+    return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+  };
+
+  // Grow the iteration count until a run is long enough to scale from
+  uint64_t iters = 1;
+  double ns;
+  while ((ns = time(iters)) < RUN_NS / 10) {
+    iters *= 2;
+  }
+  iters = std::max<uint64_t>(1, (uint64_t) (iters * RUN_NS / ns));
+
+  std::vector<double> per_op;
+  for (int r = 0; r < RUNS; r++) {
+    per_op.push_back(time(iters) / iters);
+  }
+  std::sort(per_op.begin(), per_op.end());
+  double median = per_op[RUNS / 2];
+  printf("%-30s %10.1f ns/op %6u B/op %9.1f MB/s\n", name, median, (unsigned) bytes,
+         bytes > 0 ? bytes * 1e3 / median : 0.0);
+}
+
+void check(bool ok, const char *what) {
+  if (!ok) {
+    fprintf(stderr, "input check failed: %s\n", what);
+    exit(1);
+  }
+}
+
+/*
+ * Inputs
+ */
+const uint8_t CART_UID[8] = {0x6F, 0xAA, 0x55, 0xA1, 0x0A, 0x08, 0x02, 0xE0};
+
+// First 64 bytes of a Pura cart (CC, NDEF TLV with one URI record, terminator)
+std::vector<uint8_t> cart_memory() {
+  const char *uri = "pura.com/ss?d=E002080AA155AA6F.001.4B2C";
+  std::vector<uint8_t> m = {0xE1, 0x40, 0x08, 0x01};
+  uint8_t payload_len = (uint8_t) (strlen(uri) + 1);
+  m.push_back(0x03);
+  m.push_back((uint8_t) (payload_len + 4));
+  m.push_back(ndefHeader(1U, 1U, 0U, 1U, 0U, NDEF_TNF_RTD_WELL_KNOWN_TYPE));
+  m.push_back(0x01);
+  m.push_back(payload_len);
+  m.push_back('U');
+  m.push_back(0x02);
+  m.insert(m.end(), uri, uri + strlen(uri));
+  m.push_back(0xFE);
+  m.resize(64, 0x00);
+  return m;
+}
+
+// Appends an ISO15693 CRC as the VICC sends it (inverted, LSB first)
+void add_crc(std::vector<uint8_t> &frame) {
+  uint16_t crc = (uint16_t) ~hw.rfalCrcCalculateCcitt(0xFFFFU, frame.data(), (uint16_t) frame.size());
+  frame.push_back((uint8_t) crc);
+  frame.push_back((uint8_t) (crc >> 8));
+}
+
+// Stream mode bits of a VICC response as read from the FIFO: SOF, Manchester
+// coded payload (LSB first), EOF
+std::vector<uint8_t> vicc_stream(const std::vector<uint8_t> &frame) {
+  std::vector<uint8_t> bits = {1, 1, 1, 0, 1};
+  for (uint8_t b : frame) {
+    for (int i = 0; i < 8; i++) {
+      bool one = (b >> i) & 1U;
+      bits.push_back(one ? 0 : 1);
+      bits.push_back(one ? 1 : 0);
+    }
+  }
+  const uint8_t eof[] = {1, 0, 1, 1, 1};
+  bits.insert(bits.end(), eof, eof + sizeof(eof));
+  while (bits.size() % 8 != 0 || bits.size() < (frame.size() * 16 + 32)) {
+    bits.push_back(0);
+  }
+  std::vector<uint8_t> out(bits.size() / 8, 0);
+  for (size_t i = 0; i < bits.size(); i++) {
+    out[i / 8] |= (uint8_t) (bits[i] << (i % 8));
+  }
+  return out;
+}
+
+// NDEF message with the record types the library parses: URI, vCard, Wi-Fi
+std::vector<uint8_t> ndef_message() {
+  std::vector<uint8_t> m;
+  auto record = [&](bool first, bool last, uint8_t tnf, const char *type, const std::vector<uint8_t> &payload) {
+    m.push_back(ndefHeader(first ? 1U : 0U, last ? 1U : 0U, 0U, 1U, 0U, tnf));
+    m.push_back((uint8_t) strlen(type));
+    m.push_back((uint8_t) payload.size());
+    m.insert(m.end(), type, type + strlen(type));
+    m.insert(m.end(), payload.begin(), payload.end());
+  };
+  auto bytes = [](const char *s) { return std::vector<uint8_t>(s, s + strlen(s)); };
+
+  std::vector<uint8_t> uri = {0x02};
+  std::vector<uint8_t> uri_text = bytes("pura.com/ss?d=E002080AA155AA6F.001.4B2C");
+  uri.insert(uri.end(), uri_text.begin(), uri_text.end());
+  record(true, false, NDEF_TNF_RTD_WELL_KNOWN_TYPE, "U", uri);
+
+  record(false, false, NDEF_TNF_MEDIA_TYPE, "text/x-vCard",
+         bytes("BEGIN:VCARD\r\nVERSION:3.0\r\nN:Doe;Jane\r\nFN:Jane Doe\r\nTEL;TYPE=CELL:+15551234567\r\n"
+               "EMAIL:jane@example.com\r\nORG:Example\r\nURL:https://example.com\r\nEND:VCARD\r\n"));
+
+  std::vector<uint8_t> cred;
+  auto attr = [&](uint16_t id, const std::vector<uint8_t> &v) {
+    cred.push_back((uint8_t) (id >> 8));
+    cred.push_back((uint8_t) id);
+    cred.push_back((uint8_t) (v.size() >> 8));
+    cred.push_back((uint8_t) v.size());
+    cred.insert(cred.end(), v.begin(), v.end());
+  };
+  attr(0x1026, {0x01});
+  attr(0x1045, bytes("HomeNetwork"));
+  attr(0x1003, {0x00, 0x20});
+  attr(0x100F, {0x00, 0x08});
+  attr(0x1027, bytes("correct horse battery"));
+  attr(0x1020, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF});
+  std::vector<uint8_t> wsc = {0x10, 0x0E, (uint8_t) (cred.size() >> 8), (uint8_t) cred.size()};
+  wsc.insert(wsc.end(), cred.begin(), cred.end());
+  record(false, true, NDEF_TNF_MEDIA_TYPE, "application/vnd.wfa.wsc", wsc);
+  return m;
+}
+
+ndefRecord *find_record(ndefMessage *message, uint8_t tnf, const char *type) {
+  for (ndefRecord *r = message->record; r != nullptr; r = r->next) {
+    if ((r->header & NDEF_TNF_MASK) == tnf && r->typeLength == strlen(type) &&
+        memcmp(r->type, type, r->typeLength) == 0) {
+      return r;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  filter = argc > 1 ? argv[1] : nullptr;
+  hw.rfalAnalogConfigInitialize();
+
+  // rfalCrcCalculateCcitt: READ_MULTIPLE_BLOCKS response of the whole cart
+  std::vector<uint8_t> multi = {0x00};
+  std::vector<uint8_t> memory = cart_memory();
+  multi.insert(multi.end(), memory.begin(), memory.end());
+  bench("crc_ccitt/65", (uint32_t) multi.size(), [&] {
+    uint16_t crc = hw.rfalCrcCalculateCcitt(0xFFFFU, multi.data(), (uint16_t) multi.size());
+    keep(&crc);
+  });
+
+  // iso15693VICCDecode: READ_SINGLE_BLOCK and INVENTORY responses
+  std::vector<uint8_t> block = {0x00, memory[4], memory[5], memory[6], memory[7]};
+  add_crc(block);
+  std::vector<uint8_t> inventory = {0x00, 0x00};
+  inventory.insert(inventory.end(), CART_UID, CART_UID + sizeof(CART_UID));
+  add_crc(inventory);
+  for (auto *frame : {&block, &inventory}) {
+    std::vector<uint8_t> stream = vicc_stream(*frame);
+    uint8_t out[32];
+    uint16_t out_pos, bits;
+    check(hw.iso15693VICCDecode(stream.data(), (uint16_t) stream.size(), out, sizeof(out), &out_pos, &bits, 0,
+                                false) == ERR_NONE &&
+              out_pos == frame->size() && memcmp(out, frame->data(), out_pos) == 0,
+          "VICC stream");
+    char name[40];
+    snprintf(name, sizeof(name), "iso15693_vicc_decode/%zu", frame->size());
+    bench(name, (uint32_t) stream.size(), [&] {
+      hw.iso15693VICCDecode(stream.data(), (uint16_t) stream.size(), out, sizeof(out), &out_pos, &bits, 0, false);
+      keep(out);
+    });
+  }
+
+  // iso15693VCDCode: addressed READ_SINGLE_BLOCK (1 of 4) and INVENTORY (1 of 256)
+  std::vector<uint8_t> read_req = {0x22, 0x20};
+  read_req.insert(read_req.end(), CART_UID, CART_UID + sizeof(CART_UID));
+  read_req.push_back(0x01);
+  std::vector<uint8_t> inv_req = {0x26, 0x01, 0x00};
+  const struct iso15693StreamConfig *stream_config;
+  for (auto coding : {ISO15693_VCD_CODING_1_4, ISO15693_VCD_CODING_1_256}) {
+    iso15693PhyConfig_t phy = {coding, 0};
+    hw.iso15693PhyConfigure(&phy, &stream_config);
+    std::vector<uint8_t> &req = coding == ISO15693_VCD_CODING_1_4 ? read_req : inv_req;
+    static uint8_t coded[1024];
+    uint16_t subbits, offset, coded_len;
+    offset = 0;
+    check(hw.iso15693VCDCode(req.data(), (uint16_t) req.size(), true, true, false, &subbits, &offset, coded,
+                             sizeof(coded), &coded_len) == ERR_NONE,
+          "VCD code");
+    bench(coding == ISO15693_VCD_CODING_1_4 ? "iso15693_vcd_code/1of4" : "iso15693_vcd_code/1of256",
+          (uint32_t) req.size(), [&] {
+            offset = 0;
+            hw.iso15693VCDCode(req.data(), (uint16_t) req.size(), true, true, false, &subbits, &offset, coded,
+                               sizeof(coded), &coded_len);
+            keep(coded);
+          });
+  }
+  bench("iso15693_phy_1of4/11", (uint32_t) read_req.size(), [&] {
+    uint8_t out[8];
+    uint16_t len;
+    for (uint8_t b : read_req) {
+      iso15693PhyVCDCode1Of4(b, out, sizeof(out), &len);
+      keep(out);
+    }
+  });
+  bench("iso15693_phy_1of256/3", (uint32_t) inv_req.size(), [&] {
+    uint8_t out[64];
+    uint16_t len;
+    for (uint8_t b : inv_req) {
+      iso15693PhyVCDCode1Of256(b, out, sizeof(out), &len);
+      keep(out);
+    }
+  });
+
+  // rfalAnalogConfigSearch: every entry applied when entering NFC-V poll mode
+  const rfalAnalogConfigId nfcv_ids[] = {
+      (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON |
+       RFAL_ANALOG_CONFIG_TX),
+      (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON |
+       RFAL_ANALOG_CONFIG_RX),
+      (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_1OF4 |
+       RFAL_ANALOG_CONFIG_TX),
+      (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_1OF4 |
+       RFAL_ANALOG_CONFIG_RX),
+  };
+  bench("analog_config_search/nfcv", 0, [&] {
+    for (rfalAnalogConfigId id : nfcv_ids) {
+      uint16_t offset = 0;
+      while (hw.rfalAnalogConfigSearch(id, &offset) != RFAL_ANALOG_CONFIG_LUT_NOT_FOUND) {
+      }
+      keep(&offset);
+    }
+  });
+
+  // ndefMessageDecode / ndefMessageEncode
+  std::vector<uint8_t> raw = ndef_message();
+  ndefConstBuffer raw_buf = {raw.data(), (uint32_t) raw.size()};
+  ndefMessage message;
+  check(ndef.ndefMessageDecode(&raw_buf, &message) == ERR_NONE && message.info.recordCount == 3, "NDEF message");
+  bench("ndef_message_decode/3rec", (uint32_t) raw.size(), [&] {
+    ndef.ndefMessageDecode(&raw_buf, &message);
+    keep(&message);
+  });
+  std::vector<uint8_t> encoded(raw.size() + 16);
+  ndefBuffer enc_buf = {encoded.data(), (uint32_t) encoded.size()};
+  check(ndef.ndefMessageEncode(&message, &enc_buf) == ERR_NONE && enc_buf.length == raw.size() &&
+            memcmp(encoded.data(), raw.data(), raw.size()) == 0,
+        "NDEF encode round trip");
+  bench("ndef_message_encode/3rec", (uint32_t) raw.size(), [&] {
+    enc_buf.length = (uint32_t) encoded.size();
+    ndef.ndefMessageEncode(&message, &enc_buf);
+    keep(encoded.data());
+  });
+
+  // vCard and Wi-Fi payload parsers
+  ndefRecord *vcard = find_record(&message, NDEF_TNF_MEDIA_TYPE, "text/x-vCard");
+  ndefRecord *wifi = find_record(&message, NDEF_TNF_MEDIA_TYPE, "application/vnd.wfa.wsc");
+  ndefType type;
+  check(vcard != nullptr && ndef.ndefRecordToVCard(vcard, &type) == ERR_NONE, "vCard record");
+  check(wifi != nullptr && ndef.ndefRecordToWifi(wifi, &type) == ERR_NONE, "Wi-Fi record");
+  bench("ndef_vcard_parse", (uint32_t) vcard->bufPayload.length, [&] {
+    ndef.ndefRecordToVCard(vcard, &type);
+    keep(&type);
+  });
+  bench("ndef_wifi_parse", (uint32_t) wifi->bufPayload.length, [&] {
+    ndef.ndefRecordToWifi(wifi, &type);
+    keep(&type);
+  });
+
+  // Component: URL and cart ID from the cart memory
+  CartNdefLayout layout;
+  size_t need = 0;
+  check(locate_cart_ndef(memory.data(), memory.size(), &layout, &need) == CartNdefStatus::FOUND &&
+            layout.msg_offset + layout.msg_len <= memory.size(),
+        "cart NDEF TLV");
+  check(locate_cart_ndef(memory.data(), layout.msg_offset - 1, &layout, &need) == CartNdefStatus::NEED_MORE &&
+            need == layout.msg_offset,
+        "cart NDEF TLV header");
+  locate_cart_ndef(memory.data(), memory.size(), &layout, &need);
+  char url[128], cart_id[32];
+  parse_cart_ndef(&ndef, memory.data() + layout.msg_offset, layout.msg_len, url, sizeof(url), cart_id,
+                  sizeof(cart_id));
+  check(strcmp(url, "https://www.pura.com/ss?d=E002080AA155AA6F.001.4B2C") == 0 &&
+            strcmp(cart_id, "E002080AA155AA6F") == 0,
+        "cart URL");
+  bench("cart_ndef_parse", (uint32_t) memory.size(), [&] {
+    locate_cart_ndef(memory.data(), memory.size(), &layout, &need);
+    parse_cart_ndef(&ndef, memory.data() + layout.msg_offset, layout.msg_len, url, sizeof(url), cart_id,
+                    sizeof(cart_id));
+    keep(cart_id);
+  });
+  return 0;
+}
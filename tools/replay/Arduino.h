@@ -0,0 +1,28 @@
+#pragma once
+
+// Host stand-in for the Arduino core, just what the RFAL sources use.
+// Time is virtual and driven by the trace being replayed (see replay.cpp).
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+int digitalRead(uint8_t pin);
+void pinMode(uint8_t pin, uint8_t mode);
@@ -0,0 +1,438 @@
+// Replays an ST25R3918 I2C trace against the unmodified RFAL sources on the host.
+//
+// The trace (a ST25R3918_TRACE build, dumped with dump_trace() and converted by
+// tools/st25r3918_trace.py) stands in for the chip: every register write, FIFO
+// load and direct command the RFAL issues is compared with the recorded one,
+// every read is answered with the recorded bytes, and the IRQ pin reads high
+// where the recording saw it high. Time is virtual and follows the recorded
+// timestamps, so the RFAL timeouts expire where they did on the device.
+//
+// The driver below mirrors what the component does: probe, rfalNfcInitialize(),
+// discovery, and on activation of a new NFC-V tag a read of the CC, the NDEF
+// TLV and (for Pura carts) the message blocks with the link quality retry
+// policy. A trace taken with a changed RFAL or component shows up as
+// divergences, which is the point: replay a field capture against a fix and
+// see where the exchange differs.
+
+#include "Arduino.h"
+
+#include "discovery_cadence.h"
+#include "link_quality.h"
+#include "nfcv_reader.h"
+#include "pura_cart.h"
+#include "rfal_nfc.h"
+#include "rfal_nfcv.h"
+#include "rfal_rfst25r3918.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using esphome::st25r3918::CartNdefLayout;
+using esphome::st25r3918::CartNdefStatus;
+using esphome::st25r3918::DiscoveryCadence;
+using esphome::st25r3918::LinkQuality;
+using esphome::st25r3918::NfcvReader;
+using esphome::st25r3918::NfcvTagInfo;
+using esphome::st25r3918::locate_cart_ndef;
+
+namespace {
+
+const uint8_t TRACE_WRITE = 1;
+const uint8_t TRACE_READ = 2;
+const uint8_t TRACE_IRQ = 3;
+const uint8_t TRACE_WRITE_NACK = 4;
+const uint8_t TRACE_EVENT = 5;  // Timeline event, nothing on the bus
+const uint8_t REPLAY_IRQ_PIN = 13;
+const size_t RESYNC_WINDOW = 16;      // Records searched ahead after a mismatch
+const uint32_t IRQ_POLL_STEP_US = 20;  // Virtual time per IRQ pin sample
+const uint32_t LOOP_STEP_US = 1000;    // Virtual time per worker loop iteration
+
+struct Record {
+  uint8_t type;
+  uint32_t ts;
+  std::vector<uint8_t> hdr;
+  std::vector<uint8_t> data;
+};
+
+struct Stats {
+  uint32_t writes{0};
+  uint32_t reads{0};
+  uint32_t irqs{0};
+  uint32_t mismatches{0};
+  uint32_t skipped{0};  // Recorded transactions the replay didn't issue
+  uint32_t extra{0};    // Transactions the replay issued that weren't recorded
+  uint32_t activations{0};
+  uint32_t blocks{0};
+};
+
+std::vector<Record> records;
+size_t next_rec = 0;
+uint32_t clock_us = 0;
+Stats stats;
+bool verbose = false;
+
+bool done() { return next_rec >= records.size(); }
+
+void advance_to(uint32_t ts) {
+  if ((int32_t) (ts - clock_us) > 0) {
+    clock_us = ts;
+  }
+}
+
+void report(const char *what, const std::vector<uint8_t> &bytes) {
+  if (stats.mismatches + stats.extra > 20 && !verbose) {
+    return;
+  }
+  printf("  @%10u rec %zu: %s", clock_us, next_rec, what);
+  for (uint8_t b : bytes) {
+    printf(" %02X", b);
+  }
+  printf("\n");
+}
+
+// Finds the next recorded bus transaction of the given type whose opcode bytes
+// (and, for writes, data) match; a write also matches a not acknowledged one,
+// a read its opcode not acknowledged. IRQ records in between are dropped.
+bool match(uint8_t type, const std::vector<uint8_t> &hdr, const std::vector<uint8_t> *data) {
+  for (size_t i = next_rec; i < records.size() && i < next_rec + RESYNC_WINDOW; i++) {
+    const Record &r = records[i];
+    bool same_type = r.type == type || (type == TRACE_WRITE && r.type == TRACE_WRITE_NACK) ||
+                     (type == TRACE_READ && r.type == TRACE_WRITE_NACK && r.data.empty());
+    if (!same_type || r.hdr != hdr || (data != nullptr && r.data != *data)) {
+      continue;
+    }
+    for (size_t j = next_rec; j < i; j++) {
+      if (records[j].type != TRACE_IRQ) {
+        stats.skipped++;
+      }
+    }
+    if (i != next_rec && records[next_rec].type != TRACE_IRQ) {
+      stats.mismatches++;
+      report("resynced past recorded", records[next_rec].hdr);
+    }
+    next_rec = i;
+    return true;
+  }
+  return false;
+}
+
+bool load(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (f == nullptr) {
+    perror(path);
+    return false;
+  }
+  std::vector<uint8_t> raw;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    raw.insert(raw.end(), buf, buf + n);
+  }
+  fclose(f);
+
+  size_t pos = 0;
+  while (pos + 7 <= raw.size()) {
+    Record r;
+    r.type = raw[pos] >> 4;
+    uint8_t hdr_len = raw[pos] & 0x0F;
+    r.ts = raw[pos + 1] | (raw[pos + 2] << 8) | (raw[pos + 3] << 16) | ((uint32_t) raw[pos + 4] << 24);
+    uint16_t len = raw[pos + 5] | (raw[pos + 6] << 8);
+    pos += 7;
+    if (r.type < TRACE_WRITE || r.type > TRACE_EVENT || pos + hdr_len + len > raw.size()) {
+      fprintf(stderr, "%s: corrupt record at offset %zu\n", path, pos - 7);
+      return false;
+    }
+    if (r.type == TRACE_EVENT) {
+      pos += hdr_len + len;
+      continue;
+    }
+    r.hdr.assign(raw.begin() + pos, raw.begin() + pos + hdr_len);
+    pos += hdr_len;
+    r.data.assign(raw.begin() + pos, raw.begin() + pos + len);
+    pos += len;
+    records.push_back(r);
+  }
+  return !records.empty();
+}
+
+}  // namespace
+
+/*
+ * Arduino core
+ */
+unsigned long micros() { return clock_us; }
+unsigned long millis() { return clock_us / 1000U; }
+void delay(unsigned long ms) { clock_us += ms * 1000U; }
+void delayMicroseconds(unsigned int us) { clock_us += us; }
+void yield() { clock_us += 1; }
+void pinMode(uint8_t, uint8_t) {}
+
+int digitalRead(uint8_t) {
+  // High once the virtual clock reaches the next recorded IRQ sample
+  if (!done() && records[next_rec].type == TRACE_IRQ) {
+    if ((int32_t) (records[next_rec].ts - clock_us) <= 0) {
+      next_rec++;
+      stats.irqs++;
+      return HIGH;
+    }
+    uint32_t step = records[next_rec].ts - clock_us;
+    clock_us += step < IRQ_POLL_STEP_US ? step : IRQ_POLL_STEP_US;
+    return LOW;
+  }
+  clock_us += IRQ_POLL_STEP_US;
+  return LOW;
+}
+
+/*
+ * I2C
+ */
+// Instead of a bus it serves the recorded trace: writes are checked against it,
+// reads are answered from it
+class ReplayBus : public ST25R3918I2C {
+ public:
+  uint8_t write(const uint8_t *data, uint16_t len) override;
+  uint8_t writeRead(const uint8_t *tx_data, uint16_t tx_len, uint8_t *rx_data, uint16_t rx_len) override;
+};
+
+uint8_t ReplayBus::write(const uint8_t *data, uint16_t len) {
+  stats.writes++;
+  std::vector<uint8_t> tx(data, data + len);
+  size_t hdr_len =
+      (tx.size() > 1 && (tx[0] == ST25R3918_CMD_SPACE_B_ACCESS || tx[0] == ST25R3918_CMD_TEST_ACCESS)) ? 2 : 1;
+  std::vector<uint8_t> hdr(tx.begin(), tx.begin() + hdr_len);
+  std::vector<uint8_t> payload(tx.begin() + hdr_len, tx.end());
+
+  uint8_t status = ST25R3918_I2C_OK;
+  if (match(TRACE_WRITE, hdr, &payload)) {
+    advance_to(records[next_rec].ts);
+    status = records[next_rec].type == TRACE_WRITE_NACK ? ST25R3918_I2C_NACK : ST25R3918_I2C_OK;
+    next_rec++;
+  } else {
+    stats.extra++;
+    report("unrecorded write", tx);
+  }
+  return status;
+}
+
+// A recorded read answers with its bytes; a NACKed opcode is recorded as a
+// not acknowledged write, a read that failed later without bytes
+uint8_t ReplayBus::writeRead(const uint8_t *tx_data, uint16_t tx_len, uint8_t *rx_data, uint16_t rx_len) {
+  stats.reads++;
+  std::vector<uint8_t> hdr(tx_data, tx_data + tx_len);
+  std::vector<uint8_t> rx;
+  uint8_t status = ST25R3918_I2C_OK;
+
+  if (match(TRACE_READ, hdr, nullptr)) {
+    advance_to(records[next_rec].ts);
+    if (records[next_rec].type == TRACE_WRITE_NACK) {
+      next_rec++;
+      return ST25R3918_I2C_NACK;
+    }
+    rx = records[next_rec].data;
+    next_rec++;
+    if (rx.size() < rx_len) {
+      status = ST25R3918_I2C_ERROR;
+    }
+  } else {
+    // Not recorded: answer with zeroes so the RFAL keeps going
+    stats.extra++;
+    report("unrecorded read", hdr);
+    rx.assign(rx_len, 0);
+  }
+  if (rx.size() > rx_len) {
+    rx.resize(rx_len);
+  }
+  std::copy(rx.begin(), rx.end(), rx_data);
+  return status;
+}
+
+/*
+ * Component driver
+ */
+namespace {
+
+ReplayBus bus;
+RfalRfST25R3918Class hw(&bus, REPLAY_IRQ_PIN);
+RfalNfcClass nfc(&hw);
+LinkQuality link;
+uint8_t last_uid[RFAL_NFCV_UID_LEN];
+bool have_last_uid = false;
+
+NfcvReader reader(&link);
+DiscoveryCadence cadence;
+
+bool read_nfcv(rfalNfcDevice *dev) {
+  uint8_t rx[64];
+  uint16_t rcv_len;
+  NfcvTagInfo info = reader.begin(&nfc, dev->dev.nfcv.InvRes.UID);
+  printf("  @%10u %s mode, %s rate\n", clock_us, info.selected ? "selected" : "addressed",
+         info.fast ? "fast" : "standard");
+
+  // Same read plan as the component: CC and NDEF TLV header first, then the
+  // blocks up to the end of the message for Pura carts
+  uint8_t memory[256];
+  size_t have = 0;
+  size_t block_size = info.sys_info ? info.block_size : 0;
+  uint8_t block = 0;
+  auto read_to = [&](size_t need) {
+    while (have < need) {
+      ReturnCode err = reader.read_block(&nfc, &hw, block, rx, sizeof(rx), &rcv_len);
+      if (err != ERR_NONE) {
+        printf("  @%10u block %u read failed: %d\n", clock_us, block, err);
+        return err;
+      }
+      stats.blocks++;
+      size_t data_len = rcv_len > 1 ? rcv_len - 1 : 0;
+      if (block_size == 0) {
+        block_size = data_len;
+      }
+      if (data_len == 0 || data_len != block_size) {
+        return (ReturnCode) ERR_PROTO;
+      }
+      if (have + block_size > sizeof(memory)) {
+        return (ReturnCode) ERR_NOMEM;
+      }
+      memcpy(memory + have, rx + 1, block_size);
+      have += block_size;
+      block++;
+    }
+    return (ReturnCode) ERR_NONE;
+  };
+
+  CartNdefLayout layout;
+  CartNdefStatus status;
+  size_t need = 4;
+  ReturnCode err;
+  do {
+    err = read_to(need);
+    if (err != ERR_NONE) {
+      break;
+    }
+    status = locate_cart_ndef(memory, have, &layout, &need);
+  } while (status == CartNdefStatus::NEED_MORE);
+
+  bool pura = dev->nfcidLen >= 8 && dev->nfcid[7] == 0xE0 && dev->nfcid[6] == 0x02;
+  if (err == ERR_NONE && status == CartNdefStatus::FOUND && pura) {
+    err = read_to(layout.msg_offset + layout.msg_len);
+  }
+  if (err != ERR_NONE && err != ERR_NOMEM) {
+    return false;
+  }
+  memcpy(last_uid, dev->nfcid, RFAL_NFCV_UID_LEN);
+  have_last_uid = true;
+  return true;
+}
+
+void nfc_callback(void *, rfalNfcState state) {
+  rfalNfcDevice *dev = nullptr;
+  if (state == RFAL_NFC_STATE_LISTEN_TECHDETECT) {
+    nfc.rfalNfcSetDiscoveryPeriod(cadence.cycle_done());
+    return;
+  }
+  if (state != RFAL_NFC_STATE_ACTIVATED || nfc.rfalNfcGetActiveDevice(&dev) != ERR_NONE || dev == nullptr) {
+    return;
+  }
+  stats.activations++;
+  printf("  @%10u activated type %d uid", clock_us, dev->type);
+  for (uint8_t i = 0; i < dev->nfcidLen; i++) {
+    printf(" %02X", dev->nfcid[i]);
+  }
+  printf("\n");
+
+  bool same = have_last_uid && dev->nfcidLen == RFAL_NFCV_UID_LEN && memcmp(dev->nfcid, last_uid, RFAL_NFCV_UID_LEN) == 0;
+  if (same || dev->type != RFAL_NFC_LISTEN_TYPE_NFCV) {
+    cadence.activated(true);
+  } else {
+    cadence.activated(read_nfcv(dev));
+    nfc.rfalNfcvPollerSetFwtMargin(link.fwt_margin());
+    nfc.rfalNfcvPollerSetInventorySlots(link.prefer_16_slots() ? RFAL_NFCV_NUM_SLOTS_16 : RFAL_NFCV_NUM_SLOTS_1);
+  }
+  nfc.rfalNfcDeactivate(true);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  // Discovery intervals of the recording device (poll_interval, presence_interval)
+  unsigned poll_ms = cadence.poll_period();
+  unsigned presence_ms = cadence.presence_period();
+  bool usage = argc < 2;
+  for (int i = 2; i < argc && !usage; i++) {
+    if (strcmp(argv[i], "-v") == 0) {
+      verbose = true;
+    } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+      poll_ms = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "-P") == 0 && i + 1 < argc) {
+      presence_ms = strtoul(argv[++i], nullptr, 10);
+    } else {
+      usage = true;
+    }
+  }
+  if (usage || poll_ms > 65535U || presence_ms > 65535U) {
+    fprintf(stderr, "usage: %s trace.bin [-v] [-p poll_ms] [-P presence_ms]\n", argv[0]);
+    return 2;
+  }
+  cadence.set_periods(poll_ms, presence_ms);
+  if (!load(argv[1])) {
+    return 1;
+  }
+  clock_us = records.front().ts;
+  uint32_t start_us = clock_us;
+  auto host_start = std::chrono::steady_clock::now();
+
+  // Probe until the chip answers, as the component does every 20 ms
+  uint8_t rev = 0;
+  while (!done() && !hw.st25r3918CheckChipID(&rev)) {
+    delay(20);
+  }
+  printf("  @%10u chip rev %u\n", clock_us, rev);
+
+  ReturnCode err = nfc.rfalNfcInitialize();
+  if (err != ERR_NONE) {
+    printf("rfalNfcInitialize failed: %d\n", err);
+  }
+
+  rfalNfcDiscoverParam disc;
+  memset(&disc, 0, sizeof(disc));
+  disc.compMode = RFAL_COMPLIANCE_MODE_NFC;
+  disc.devLimit = 1;
+  disc.nfcfBR = RFAL_BR_212;
+  disc.ap2pBR = RFAL_BR_424;
+  disc.techs2Find = (RFAL_NFC_POLL_TECH_A | RFAL_NFC_POLL_TECH_V);
+  disc.GBLen = RFAL_NFCDEP_GB_MAX_LEN;
+  disc.notifyCb = nfc_callback;
+  disc.totalDuration = cadence.poll_period();
+  disc.wakeupEnabled = false;
+  disc.wakeupConfigDefault = true;
+  err = nfc.rfalNfcDiscover(&disc);
+  if (err != ERR_NONE) {
+    printf("rfalNfcDiscover failed: %d\n", err);
+  }
+
+  // Run the worker until the trace is used up (or stops being consumed)
+  size_t last_rec = next_rec;
+  uint32_t idle_since = clock_us;
+  while (!done()) {
+    nfc.rfalNfcWorker();
+    clock_us += LOOP_STEP_US;
+    if (next_rec != last_rec) {
+      last_rec = next_rec;
+      idle_since = clock_us;
+    } else if (clock_us - idle_since > 10U * 1000U * 1000U) {
+      printf("  @%10u stalled: the replay stopped consuming the trace\n", clock_us);
+      break;
+    }
+  }
+
+  double host_ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - host_start).count();
+  printf("\n%zu/%zu records replayed over %.3f s of device time (%.1f ms host)\n", next_rec, records.size(),
+         (clock_us - start_us) / 1e6, host_ms);
+  printf("writes %u, reads %u, irqs %u, activations %u, blocks read %u\n", stats.writes, stats.reads, stats.irqs,
+         stats.activations, stats.blocks);
+  printf("divergences: %u mismatched, %u recorded but not issued, %u issued but not recorded\n", stats.mismatches,
+         stats.skipped, stats.extra);
+  return (stats.mismatches + stats.skipped + stats.extra) == 0 ? 0 : 1;
+}
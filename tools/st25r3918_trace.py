@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+"""Extract an ST25R3918 I2C trace from an ESPHome log and decode it.
+
+The component (built with `trace_buffer_size:`) logs its trace ring between
+"TRACE BEGIN" and "TRACE END" as "TRACE:<hex>" lines when dump_trace() is
+called. This script joins those lines back into the binary record stream,
+optionally writes it out for tools/replay or as a Chrome/Perfetto timeline,
+and prints one line per record.
+
+Record layout (little endian):
+  [type << 4 | hdr_len] [timestamp us, 4] [data_len, 2] [hdr, hdr_len] [data]
+type 1 = write, 2 = read, 3 = IRQ pin high, 4 = write not acknowledged;
+hdr is the opcode byte(s) sent. A failed read has fewer data bytes than asked.
+type 5 = timeline event: hdr is the phase ('B', 'E' or 'I') and the event id,
+data the one byte argument (a state or a return code).
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+TYPE_WRITE = 1
+TYPE_READ = 2
+TYPE_IRQ = 3
+TYPE_WRITE_NACK = 4
+TYPE_EVENT = 5
+TYPE_NAMES = {TYPE_WRITE: "WR ", TYPE_READ: "RD ", TYPE_IRQ: "IRQ", TYPE_WRITE_NACK: "NAK", TYPE_EVENT: "EV "}
+
+# Timeline events (RFAL_TRACE_EV_* in rfal_rf.h, TRACE_EV_* in st25r3918_component.h)
+EV_NFC_STATE = 1
+EV_TXRX_STATE = 2
+EV_COM = 3
+EV_NFC_CALLBACK = 0x10
+EV_NFC_EVENT = 0x11
+
+NFC_STATES = {
+    0: "NOTINIT", 1: "IDLE", 2: "START_DISCOVERY", 3: "WAKEUP_MODE",
+    10: "POLL_TECHDETECT", 11: "POLL_COLAVOIDANCE", 12: "POLL_SELECT", 13: "POLL_ACTIVATION",
+    20: "LISTEN_TECHDETECT", 21: "LISTEN_COLAVOIDANCE", 22: "LISTEN_ACTIVATION", 23: "LISTEN_SLEEP",
+    30: "ACTIVATED", 31: "DATAEXCHANGE", 33: "DATAEXCHANGE_DONE", 34: "DEACTIVATION",
+}
+TXRX_STATES = {
+    0: "IDLE", 1: "INIT", 2: "START",
+    11: "TX_IDLE", 12: "TX_WAIT_GT", 13: "TX_WAIT_FDT", 14: "TX_TRANSMIT", 15: "TX_WAIT_WL",
+    16: "TX_RELOAD_FIFO", 17: "TX_WAIT_TXE", 18: "TX_DONE", 19: "TX_FAIL",
+    81: "RX_IDLE", 82: "RX_WAIT_EON", 83: "RX_WAIT_RXS", 84: "RX_WAIT_RXE", 85: "RX_READ_FIFO",
+    86: "RX_ERR_CHECK", 87: "RX_READ_DATA", 88: "RX_WAIT_EOF", 89: "RX_DONE", 90: "RX_FAIL",
+}
+NFC_EVENTS = {0: "TAG_PRESENT", 1: "TAG_READ", 2: "ANTENNA_TUNED", 3: "ANTENNA_RESTORED", 4: "POWER_SETPOINT"}
+
+# Chrome trace threads, one per kind of activity
+TID_NFC = 1
+TID_TXRX = 2
+TID_BUS = 3
+TID_IRQ = 4
+TID_COMPONENT = 5
+THREAD_NAMES = {
+    TID_NFC: "rfalNfcWorker state",
+    TID_TXRX: "transceive state",
+    TID_BUS: "I2C",
+    TID_IRQ: "IRQ pin",
+    TID_COMPONENT: "component",
+}
+
+SPACE_B_ACCESS = 0xFB
+TEST_ACCESS = 0xFC
+FIFO_LOAD = 0x80
+FIFO_READ = 0x9F
+PT_MEM_READ = 0xBF
+
+
+def extract(lines):
+    """Return (data, dropped) of the last complete dump found in the log."""
+    data = None
+    dropped = 0
+    chunks = []
+    for line in lines:
+        m = re.search(r"TRACE BEGIN dropped=(\d+)", line)
+        if m:
+            chunks = []
+            dropped = int(m.group(1))
+            continue
+        m = re.search(r"TRACE:([0-9A-Fa-f]+)", line)
+        if m:
+            chunks.append(bytes.fromhex(m.group(1)))
+            continue
+        if "TRACE END" in line:
+            data = b"".join(chunks)
+    if data is None:
+        raise SystemExit("no complete TRACE BEGIN/END block found")
+    return data, dropped
+
+
+def records(data):
+    pos = 0
+    while pos + 7 <= len(data):
+        head = data[pos]
+        rtype, hdr_len = head >> 4, head & 0x0F
+        ts, dlen = struct.unpack_from("<IH", data, pos + 1)
+        end = pos + 7 + hdr_len + dlen
+        if rtype not in TYPE_NAMES or end > len(data):
+            raise SystemExit(f"corrupt record at offset {pos}")
+        yield rtype, ts, data[pos + 7 : pos + 7 + hdr_len], data[pos + 7 + hdr_len : end]
+        pos = end
+
+
+def event_name(ev_id, arg):
+    if ev_id == EV_NFC_STATE:
+        return NFC_STATES.get(arg, f"state {arg}")
+    if ev_id == EV_TXRX_STATE:
+        return TXRX_STATES.get(arg, f"state {arg}")
+    if ev_id == EV_COM:
+        return "transaction"
+    if ev_id == EV_NFC_CALLBACK:
+        return "handle_nfc_state " + NFC_STATES.get(arg, str(arg))
+    if ev_id == EV_NFC_EVENT:
+        return "event " + NFC_EVENTS.get(arg, str(arg))
+    return f"event {ev_id:02X}"
+
+
+def describe(rtype, hdr, payload=b""):
+    if rtype == TYPE_IRQ:
+        return ""
+    if rtype == TYPE_EVENT:
+        return f"{chr(hdr[0])} {event_name(hdr[1], payload[0] if payload else 0)}"
+    space_b = len(hdr) == 2 and hdr[0] == SPACE_B_ACCESS
+    test = len(hdr) == 2 and hdr[0] == TEST_ACCESS
+    op = hdr[-1]
+    if op in (FIFO_LOAD, FIFO_READ):
+        return "FIFO"
+    if op == PT_MEM_READ or 0xA0 <= op <= 0xAF:
+        return "PTMEM"
+    if (op & 0xC0) == 0xC0 and not test:
+        return f"CMD {op:02X}"
+    reg = op & 0x3F
+    if test:
+        return f"TREG {reg:02X}"
+    return f"REG {'B:' if space_b else ''}{reg:02X}"
+
+
+def chrome_trace(data):
+    """Return the records as a Chrome trace event list (chrome://tracing, ui.perfetto.dev)."""
+    events = [{"ph": "M", "name": "process_name", "pid": 1, "args": {"name": "ST25R3918"}}]
+    for tid, name in THREAD_NAMES.items():
+        events.append({"ph": "M", "name": "thread_name", "pid": 1, "tid": tid, "args": {"name": name}})
+
+    open_spans = {tid: [] for tid in THREAD_NAMES}
+    pending_com = []  # Transaction spans still to be named after their first bus record
+    elapsed = 0
+    last = None
+    for rtype, ts, hdr, payload in records(data):
+        # 32 bit microsecond timestamps: accumulate the deltas across wraps
+        elapsed += 0 if last is None else (ts - last) & 0xFFFFFFFF
+        last = ts
+        if rtype == TYPE_IRQ:
+            events.append({"ph": "i", "s": "t", "name": "IRQ", "pid": 1, "tid": TID_IRQ, "ts": elapsed})
+            continue
+        if rtype != TYPE_EVENT:
+            args = {"data": payload.hex(" ")}
+            if rtype == TYPE_WRITE_NACK:
+                args["nack"] = True
+            name = f"{TYPE_NAMES[rtype].strip()} {describe(rtype, hdr)}"
+            events.append({"ph": "i", "s": "t", "name": name, "pid": 1, "tid": TID_BUS, "ts": elapsed, "args": args})
+            if pending_com:
+                pending_com.pop()["name"] = name
+            continue
+
+        phase, ev_id = chr(hdr[0]), hdr[1]
+        arg = payload[0] if payload else 0
+        tid = {EV_NFC_STATE: TID_NFC, EV_TXRX_STATE: TID_TXRX, EV_COM: TID_BUS}.get(ev_id, TID_COMPONENT)
+        if phase == "I":
+            events.append({"ph": "i", "s": "t", "name": event_name(ev_id, arg), "pid": 1, "tid": tid, "ts": elapsed})
+        elif phase == "B":
+            event = {"ph": "B", "name": event_name(ev_id, arg), "pid": 1, "tid": tid, "ts": elapsed}
+            events.append(event)
+            open_spans[tid].append(event)
+            if ev_id == EV_COM:
+                pending_com.append(event)
+        elif phase == "E":
+            # The ring may have dropped the begin: only close spans seen opening
+            if not open_spans[tid]:
+                continue
+            begin = open_spans[tid].pop()
+            pending_com = [e for e in pending_com if e is not begin]
+            event = {"ph": "E", "pid": 1, "tid": tid, "ts": elapsed}
+            if ev_id == EV_COM:
+                event["args"] = {"ret": arg}
+            events.append(event)
+
+    # Spans still open at the end of the capture
+    for tid, spans in open_spans.items():
+        for _ in spans:
+            events.append({"ph": "E", "pid": 1, "tid": tid, "ts": elapsed})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="ESPHome log containing a trace dump ('-' for stdin)")
+    parser.add_argument("-o", "--output", help="write the binary trace for tools/replay")
+    parser.add_argument("-c", "--chrome", help="write the timeline as Chrome trace JSON (chrome://tracing, Perfetto)")
+    parser.add_argument("-q", "--quiet", action="store_true", help="don't print the records")
+    args = parser.parse_args()
+
+    with (sys.stdin if args.log == "-" else open(args.log, errors="replace")) as f:
+        data, dropped = extract(f)
+
+    if dropped:
+        print(f"warning: {dropped} records were overwritten, the trace doesn't start at boot", file=sys.stderr)
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(data)
+    if args.chrome:
+        with open(args.chrome, "w") as f:
+            json.dump({"traceEvents": chrome_trace(data), "displayTimeUnit": "ms"}, f)
+
+    count = 0
+    first = None
+    for rtype, ts, hdr, payload in records(data):
+        count += 1
+        first = ts if first is None else first
+        if not args.quiet:
+            if rtype == TYPE_EVENT:
+                print(f"{(ts - first) & 0xFFFFFFFF:>10} {TYPE_NAMES[rtype]} {describe(rtype, hdr, payload)}")
+            else:
+                print(f"{(ts - first) & 0xFFFFFFFF:>10} {TYPE_NAMES[rtype]} {describe(rtype, hdr):<9} {payload.hex(' ')}")
+    print(f"{count} records, {len(data)} bytes", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()